@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "slab-pool.hpp"
+
+#include <cstddef>
+
+namespace nfd {
+
+const size_t SlabPool::ALIGNMENT = alignof(std::max_align_t);
+const size_t SlabPool::MAX_BLOCK_SIZE = 512;
+
+SlabPool::SlabPool(size_t nBlocksPerSlab)
+  : m_nBlocksPerSlab(nBlocksPerSlab)
+  , m_freeLists(MAX_BLOCK_SIZE / ALIGNMENT, nullptr)
+  , m_nBlocksInUse(0)
+  , m_nBytesInUse(0)
+  , m_nBytesReserved(0)
+{
+  BOOST_ASSERT(m_nBlocksPerSlab > 0);
+}
+
+SlabPool::~SlabPool()
+{
+  // blocks still in use are released with their slabs; SlabAllocator keeps the pool alive
+  // until all objects allocated from it are gone
+  BOOST_ASSERT(m_nBlocksInUse == 0);
+}
+
+size_t
+SlabPool::getSizeClass(size_t size)
+{
+  return size == 0 ? 0 : (size - 1) / ALIGNMENT;
+}
+
+void
+SlabPool::addSlab(size_t sizeClass)
+{
+  size_t blockSize = (sizeClass + 1) * ALIGNMENT;
+  size_t slabSize = blockSize * m_nBlocksPerSlab;
+
+  // operator new[] returns memory aligned for any fundamental type
+  m_slabs.emplace_back(new char[slabSize]);
+  m_nBytesReserved += slabSize;
+
+  char* slab = m_slabs.back().get();
+  for (size_t i = m_nBlocksPerSlab; i > 0; --i) {
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * blockSize);
+    block->next = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = block;
+  }
+}
+
+void*
+SlabPool::allocate(size_t size)
+{
+  if (size > MAX_BLOCK_SIZE) {
+    m_nBytesReserved += size;
+    ++m_nBlocksInUse;
+    m_nBytesInUse += size;
+    return ::operator new(size);
+  }
+
+  size_t sizeClass = getSizeClass(size);
+  if (m_freeLists[sizeClass] == nullptr) {
+    this->addSlab(sizeClass);
+  }
+
+  FreeBlock* block = m_freeLists[sizeClass];
+  m_freeLists[sizeClass] = block->next;
+
+  ++m_nBlocksInUse;
+  m_nBytesInUse += (sizeClass + 1) * ALIGNMENT;
+  return block;
+}
+
+void
+SlabPool::deallocate(void* block, size_t size)
+{
+  if (block == nullptr) {
+    return;
+  }
+
+  BOOST_ASSERT(m_nBlocksInUse > 0);
+  --m_nBlocksInUse;
+
+  if (size > MAX_BLOCK_SIZE) {
+    m_nBytesReserved -= size;
+    m_nBytesInUse -= size;
+    ::operator delete(block);
+    return;
+  }
+
+  size_t sizeClass = getSizeClass(size);
+  m_nBytesInUse -= (sizeClass + 1) * ALIGNMENT;
+
+  FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+  freeBlock->next = m_freeLists[sizeClass];
+  m_freeLists[sizeClass] = freeBlock;
+}
+
+} // namespace nfd
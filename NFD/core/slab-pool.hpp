@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_SLAB_POOL_HPP
+#define NFD_CORE_SLAB_POOL_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+/** \brief pool of small memory blocks carved from large slabs
+ *
+ *  Blocks are grouped in size classes, each with its own free list.  A freed block is kept in
+ *  the free list of its size class and reused by the next allocation of that class, so churn
+ *  of table entries does not reach the system allocator.  Slabs are released only when the
+ *  pool is destroyed.
+ *
+ *  Requests larger than MAX_BLOCK_SIZE are passed to the system allocator.
+ *
+ *  The pool is not thread-safe.
+ */
+class SlabPool : noncopyable
+{
+public:
+  /** \param nBlocksPerSlab number of blocks in a slab
+   */
+  explicit
+  SlabPool(size_t nBlocksPerSlab = 256);
+
+  ~SlabPool();
+
+  /** \return a block of at least \p size bytes aligned for any object type
+   */
+  void*
+  allocate(size_t size);
+
+  /** \brief return a block to the pool
+   *  \param size the size that was passed to allocate()
+   */
+  void
+  deallocate(void* block, size_t size);
+
+public: // statistics
+  /** \return number of blocks allocated and not yet deallocated
+   */
+  size_t
+  getNBlocksInUse() const
+  {
+    return m_nBlocksInUse;
+  }
+
+  /** \return number of bytes in blocks allocated and not yet deallocated
+   *  \note this counts the size classes of the blocks, not the requested sizes
+   */
+  size_t
+  getNBytesInUse() const
+  {
+    return m_nBytesInUse;
+  }
+
+  /** \return number of bytes taken from the system allocator, in slabs and in
+   *          requests larger than MAX_BLOCK_SIZE
+   */
+  size_t
+  getNBytesReserved() const
+  {
+    return m_nBytesReserved;
+  }
+
+public:
+  static const size_t ALIGNMENT;
+  static const size_t MAX_BLOCK_SIZE;
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  static size_t
+  getSizeClass(size_t size);
+
+  void
+  addSlab(size_t sizeClass);
+
+private:
+  size_t m_nBlocksPerSlab;
+  std::vector<FreeBlock*> m_freeLists; // indexed by size class
+  std::vector<unique_ptr<char[]>> m_slabs;
+
+  size_t m_nBlocksInUse;
+  size_t m_nBytesInUse;
+  size_t m_nBytesReserved;
+};
+
+/** \brief allocator that takes memory from a SlabPool
+ *
+ *  It is meant to be used with std::allocate_shared, so that both the object and its
+ *  reference count are allocated in one block of the pool.  The allocator, and hence
+ *  every object allocated with it, keeps the pool alive.
+ */
+template<typename T>
+class SlabAllocator
+{
+public:
+  typedef T value_type;
+
+  explicit
+  SlabAllocator(shared_ptr<SlabPool> pool)
+    : m_pool(std::move(pool))
+  {
+    BOOST_ASSERT(m_pool != nullptr);
+  }
+
+  template<typename U>
+  SlabAllocator(const SlabAllocator<U>& other)
+    : m_pool(other.getPool())
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    return static_cast<T*>(m_pool->allocate(n * sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n)
+  {
+    m_pool->deallocate(p, n * sizeof(T));
+  }
+
+  const shared_ptr<SlabPool>&
+  getPool() const
+  {
+    return m_pool;
+  }
+
+private:
+  shared_ptr<SlabPool> m_pool;
+};
+
+template<typename T, typename U>
+bool
+operator==(const SlabAllocator<T>& lhs, const SlabAllocator<U>& rhs)
+{
+  return lhs.getPool() == rhs.getPool();
+}
+
+template<typename T, typename U>
+bool
+operator!=(const SlabAllocator<T>& lhs, const SlabAllocator<U>& rhs)
+{
+  return lhs.getPool() != rhs.getPool();
+}
+
+} // namespace nfd
+
+#endif // NFD_CORE_SLAB_POOL_HPP
@@ -33,7 +33,6 @@ NFD_LOG_INIT("FaceTable");
 
 FaceTable::FaceTable(Forwarder& forwarder)
   : m_forwarder(forwarder)
-  , m_lastFaceId(FACEID_RESERVED_MAX)
 {
 }
 
@@ -42,11 +41,41 @@ FaceTable::~FaceTable()
 
 }
 
+size_t
+FaceTable::getSlotIndex(FaceId faceId)
+{
+  return (faceId & ((1 << SLOT_BITS) - 1)) - (FACEID_RESERVED_MAX + 1);
+}
+
+uint32_t
+FaceTable::getGeneration(FaceId faceId)
+{
+  return faceId >> SLOT_BITS;
+}
+
 shared_ptr<Face>
 FaceTable::get(FaceId id) const
 {
-  std::map<FaceId, shared_ptr<Face> >::const_iterator i = m_faces.find(id);
-  return (i == m_faces.end()) ? (shared_ptr<Face>()) : (i->second);
+  if (id <= FACEID_RESERVED_MAX) {
+    // reserved FaceIds are not backed by slots, and there are only a few such Faces
+    for (const shared_ptr<Face>& face : m_faces) {
+      if (face->getId() == id) {
+        return face;
+      }
+    }
+    return nullptr;
+  }
+
+  size_t index = getSlotIndex(id);
+  if (index >= m_slots.size()) {
+    return nullptr;
+  }
+
+  const Slot& slot = m_slots[index];
+  if (slot.position == FREE_SLOT || slot.generation != getGeneration(id)) {
+    return nullptr;
+  }
+  return m_faces[slot.position];
 }
 
 size_t
@@ -55,16 +84,48 @@ FaceTable::size() const
   return m_faces.size();
 }
 
+size_t
+FaceTable::getPosition(const Face& face) const
+{
+  if (face.getId() > FACEID_RESERVED_MAX) {
+    return m_slots[getSlotIndex(face.getId())].position;
+  }
+
+  for (size_t position = 0; position < m_faces.size(); ++position) {
+    if (m_faces[position].get() == &face) {
+      return position;
+    }
+  }
+  BOOST_ASSERT(false);
+  return FREE_SLOT;
+}
+
 void
 FaceTable::add(shared_ptr<Face> face)
 {
-  if (face->getId() != INVALID_FACEID && m_faces.count(face->getId()) > 0) {
+  if (face->getId() != INVALID_FACEID && this->get(face->getId()) != nullptr) {
     NFD_LOG_WARN("Trying to add existing face id=" << face->getId() << " to the face table");
     return;
   }
 
-  FaceId faceId = ++m_lastFaceId;
+  size_t index;
+  if (!m_freeSlots.empty()) {
+    index = m_freeSlots.back();
+    m_freeSlots.pop_back();
+    // FaceIds of the previous Face in this slot become stale
+    m_slots[index].generation++;
+  }
+  else {
+    index = m_slots.size();
+    if (index + FACEID_RESERVED_MAX + 1 >= (1 << SLOT_BITS)) {
+      BOOST_THROW_EXCEPTION(std::length_error("FaceTable is full"));
+    }
+    m_slots.push_back(Slot{FREE_SLOT, 0});
+  }
+
+  FaceId faceId = (m_slots[index].generation << SLOT_BITS) | (index + FACEID_RESERVED_MAX + 1);
   BOOST_ASSERT(faceId > FACEID_RESERVED_MAX);
+  m_slots[index].position = m_faces.size();
   this->addImpl(face, faceId);
 }
 
@@ -72,8 +133,8 @@ void
 FaceTable::addReserved(shared_ptr<Face> face, FaceId faceId)
 {
   BOOST_ASSERT(face->getId() == INVALID_FACEID);
-  BOOST_ASSERT(m_faces.count(face->getId()) == 0);
   BOOST_ASSERT(faceId <= FACEID_RESERVED_MAX);
+  BOOST_ASSERT(this->get(faceId) == nullptr);
   this->addImpl(face, faceId);
 }
 
@@ -81,7 +142,7 @@ void
 FaceTable::addImpl(shared_ptr<Face> face, FaceId faceId)
 {
   face->setId(faceId);
-  m_faces[faceId] = face;
+  m_faces.push_back(face);
   NFD_LOG_INFO("Added face id=" << faceId << " remote=" << face->getRemoteUri()
                                           << " local=" << face->getLocalUri());
 
@@ -98,7 +159,24 @@ FaceTable::remove(shared_ptr<Face> face, const std::string& reason)
   this->onRemove(face);
 
   FaceId faceId = face->getId();
-  m_faces.erase(faceId);
+
+  // move the last Face into the place of the removed one
+  size_t position = this->getPosition(*face);
+  if (position != m_faces.size() - 1) {
+    m_faces[position] = std::move(m_faces.back());
+    if (m_faces[position]->getId() > FACEID_RESERVED_MAX) {
+      m_slots[getSlotIndex(m_faces[position]->getId())].position = position;
+    }
+  }
+  m_faces.pop_back();
+
+  if (faceId > FACEID_RESERVED_MAX) {
+    size_t index = getSlotIndex(faceId);
+    m_slots[index].position = FREE_SLOT;
+    if (m_slots[index].generation < MAX_GENERATION) {
+      m_freeSlots.push_back(index);
+    }
+  }
   face->setId(INVALID_FACEID);
 
   NFD_LOG_INFO("Removed face id=" << faceId <<
@@ -109,22 +187,16 @@ FaceTable::remove(shared_ptr<Face> face, const std::string& reason)
   m_forwarder.getFib().removeNextHopFromAllEntries(face);
 }
 
-FaceTable::ForwardRange
-FaceTable::getForwardRange() const
-{
-  return m_faces | boost::adaptors::map_values;
-}
-
 FaceTable::const_iterator
 FaceTable::begin() const
 {
-  return this->getForwardRange().begin();
+  return m_faces.begin();
 }
 
 FaceTable::const_iterator
 FaceTable::end() const
 {
-  return this->getForwardRange().end();
+  return m_faces.end();
 }
 
 } // namespace nfd
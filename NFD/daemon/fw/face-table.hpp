@@ -27,13 +27,20 @@
 #define NFD_DAEMON_FW_FACE_TABLE_HPP
 
 #include "face/face.hpp"
-#include <boost/range/adaptor/map.hpp>
+
+#include <climits>
 
 namespace nfd {
 
 class Forwarder;
 
 /** \brief container of all Faces
+ *
+ *  Faces are kept in a contiguous vector.  A FaceId of a non-reserved Face encodes the index of
+ *  its slot and the generation of the slot: get() is a bounds-checked index into the slot
+ *  vector, and a FaceId of a removed Face is not found even after its slot is reused by
+ *  another Face.  Slots of removed Faces are kept on a free list, until the generation of the
+ *  slot is exhausted.
  */
 class FaceTable : noncopyable
 {
@@ -58,13 +65,14 @@ public:
   size() const;
 
 public: // enumeration
-  typedef std::map<FaceId, shared_ptr<Face>> FaceMap;
-
-  typedef boost::select_second_const_range<FaceMap> ForwardRange;
+  typedef std::vector<shared_ptr<Face>> FaceList;
 
   /** \brief ForwardIterator for shared_ptr<Face>
+   *
+   *  Faces are enumerated in the order of addition, except that removal of a Face moves the
+   *  last Face into its place
    */
-  typedef boost::range_iterator<ForwardRange>::type const_iterator;
+  typedef FaceList::const_iterator const_iterator;
 
   const_iterator
   begin() const;
@@ -92,13 +100,45 @@ private:
   void
   remove(shared_ptr<Face> face, const std::string& reason);
 
-  ForwardRange
-  getForwardRange() const;
+  /** \return index of the slot of a non-reserved FaceId
+   */
+  static size_t
+  getSlotIndex(FaceId faceId);
+
+  /** \return generation of the slot encoded in a non-reserved FaceId
+   */
+  static uint32_t
+  getGeneration(FaceId faceId);
+
+  /** \return position of a Face in m_faces
+   */
+  size_t
+  getPosition(const Face& face) const;
 
 private:
+  /** \brief number of low bits of FaceId that encode the slot index
+   *
+   *  The remaining bits of a positive FaceId encode the generation of the slot.  A slot is used
+   *  by at most MAX_GENERATION + 1 Faces and is then retired rather than reused, as a wrapped
+   *  generation would let a stale FaceId resolve to a live Face
+   */
+  static const int SLOT_BITS = 20;
+
+  static const uint32_t MAX_GENERATION = INT_MAX >> SLOT_BITS;
+
+  /// position of a free slot
+  static const size_t FREE_SLOT = static_cast<size_t>(-1);
+
+  struct Slot
+  {
+    size_t position; ///< position of the Face in m_faces, or FREE_SLOT
+    uint32_t generation;
+  };
+
   Forwarder& m_forwarder;
-  FaceId m_lastFaceId;
-  FaceMap m_faces;
+  FaceList m_faces;
+  std::vector<Slot> m_slots;
+  std::vector<size_t> m_freeSlots;
 };
 
 } // namespace nfd
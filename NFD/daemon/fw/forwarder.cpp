@@ -27,13 +27,13 @@
 #include "core/logger.hpp"
 #include "core/random.hpp"
 #include "face/null-face.hpp"
+#include "pipeline-stage.hpp"
 #include "strategy.hpp"
 
 #include "utils/ndn-ns3-packet-tag.hpp"
 
 #include <boost/random/uniform_int_distribution.hpp>
-#include <sstream>
-#include <string>
+#include <set>
 
 using namespace std;
 
@@ -51,6 +51,7 @@ Forwarder::Forwarder()
     , m_fib( m_nameTree )
     , m_pit( m_nameTree )
     , m_measurements( m_nameTree )
+    , m_subscriptionTable( m_nameTree )
     , m_strategyChoice( m_nameTree, fw::makeDefaultStrategy( *this ) )
     , m_csFace( make_shared<NullFace>( FaceUri( "contentstore://" ) ) ) {
   fw::installStrategies( *this );
@@ -59,159 +60,94 @@ Forwarder::Forwarder()
 
 Forwarder::~Forwarder() {}
 
-void Forwarder::onIncomingInterest( Face &inFace, const Interest &interest ) {
-  // add by kan 20190324 20190330
-  // Interest* interest = const_cast<Interest*>(&interest);
-  if ( interest.getValidationFlag() == 1 ) {
-    std::string PITListStr = interest.getPITList();
-    PITListStr += std::to_string( inFace.getId() ) + " ";
-    const_cast<Interest &>( interest ).setPITList( PITListStr );
-  }
-
-  // int node = ns3::Simulator::GetContext();
-  // std::cout<<"node "<<node<<" get interest with PITList value
-  // "<<interest.getPITList()<<std::endl; std::cout<<"node "<<node<<"
-  // "<<inFace.getId()<<std::endl;
-  // std::cout<<inFace.getId()<<std::endl;
-  // end add
+void Forwarder::addPipelineStage( shared_ptr<fw::PipelineStage> stage ) {
+  m_stages.push_back( stage );
+}
 
+void Forwarder::onIncomingInterest( Face &inFace, const Interest &interest ) {
   // receive Interest
   NFD_LOG_DEBUG( "onIncomingInterest face=" << inFace.getId() << " interest="
                                             << interest.getName() );
   const_cast<Interest &>( interest ).setIncomingFaceId( inFace.getId() );
 
-  // add by kan 20201231
-  if ( interest.getLocationRegistration() == 1 ) {
-    // 注册位置的兴趣包直接转发,不经过PIT表
-    NFD_LOG_DEBUG( "getLocationRegistration" );
-    shared_ptr<pit::Entry>       pitEntry = make_shared<pit::Entry>( interest );
-    shared_ptr<name_tree::Entry> nameTreeEntry =
-        m_pit.getNameTree().lookup( interest.getName() );
-    // shared_ptr<pit::Entry> entry = make_shared<pit::Entry>(interest);
-    nameTreeEntry->insertPitEntry( pitEntry );
-    // NFD_LOG_DEBUG( pitEntry->getName() );
-    // // FIB lookup
-    shared_ptr<fib::Entry> fibEntry =
-        m_fib.findLongestPrefixMatch( pitEntry->getName() );
-
-    const fib::NextHopList &nexthops = fibEntry->getNextHops();
-    // fib::NextHopList::const_iterator it       = std::find_if(
-    //     nexthops.begin(), nexthops.end(),
-    //     bind( &predicate_PitEntry_canForwardTo_NextHop, pitEntry, _1 ) );
-    shared_ptr<Face> outFace = nexthops.begin()->getFace();
-    outFace->sendInterest( interest );
-
-    // dispatch to strategy
-    // this->dispatchToStrategy(
-    //     pitEntry, bind( &Strategy::afterReceiveInterest, _1, cref( inFace ),
-    //                     cref( interest ), fibEntry, pitEntry ) );
-    // shared_ptr<pit::Entry> pitEntry = m_pit.insert( interest ).first;
-
-    // this->onContentStoreMiss( inFace, pitEntry, interest );
-  } else {
-    ++m_counters.getNInInterests();
-
-    // /localhost scope control
-    bool isViolatingLocalhost =
-        !inFace.isLocal() && LOCALHOST_NAME.isPrefixOf( interest.getName() );
-    if ( isViolatingLocalhost ) {
-      NFD_LOG_DEBUG( "onIncomingInterest face="
-                     << inFace.getId() << " interest=" << interest.getName()
-                     << " violates /localhost" );
-      // (drop)
+  for ( const shared_ptr<fw::PipelineStage> &stage : m_stages ) {
+    if ( stage->beforeIncomingInterest( inFace, interest ) ) {
       return;
     }
+  }
+
+  ++m_counters.getNInInterests();
+
+  // /localhost scope control
+  bool isViolatingLocalhost =
+      !inFace.isLocal() && LOCALHOST_NAME.isPrefixOf( interest.getName() );
+  if ( isViolatingLocalhost ) {
+    NFD_LOG_DEBUG( "onIncomingInterest face="
+                   << inFace.getId() << " interest=" << interest.getName()
+                   << " violates /localhost" );
+    // (drop)
+    return;
+  }
+
+  // PIT insert
+  shared_ptr<pit::Entry> pitEntry = m_pit.insert( interest ).first;
+
+  // detect duplicate Nonce
+  int  dnw = pitEntry->findNonce( interest.getNonce(), inFace );
+  bool hasDuplicateNonce =
+      ( dnw != pit::DUPLICATE_NONCE_NONE ) ||
+      m_deadNonceList.has( interest.getName(), interest.getNonce() );
+  if ( hasDuplicateNonce ) {
+    // goto Interest loop pipeline
+    this->onInterestLoop( inFace, interest, pitEntry );
+    return;
+  }
 
-    // PIT insert
-    shared_ptr<pit::Entry> pitEntry = m_pit.insert( interest ).first;
-
-    // detect duplicate Nonce
-    int  dnw = pitEntry->findNonce( interest.getNonce(), inFace );
-    bool hasDuplicateNonce =
-        ( dnw != pit::DUPLICATE_NONCE_NONE ) ||
-        m_deadNonceList.has( interest.getName(), interest.getNonce() );
-    if ( hasDuplicateNonce ) {
-      // goto Interest loop pipeline
-      this->onInterestLoop( inFace, interest, pitEntry );
+  // cancel unsatisfy & straggler timer
+  this->cancelUnsatisfyAndStragglerTimer( pitEntry );
+
+  // is pending?
+  const pit::InRecordCollection &inRecords = pitEntry->getInRecords();
+  bool isPending = inRecords.begin() != inRecords.end();
+
+  for ( const shared_ptr<fw::PipelineStage> &stage : m_stages ) {
+    if ( stage->afterPitInsert( inFace, interest, pitEntry, isPending ) ) {
       return;
     }
+  }
 
-    // cancel unsatisfy & straggler timer
-    this->cancelUnsatisfyAndStragglerTimer( pitEntry );
-
-    // is pending?
-    // isPending为True时，表示有两条及以上记录，对于普通请求，cs表中肯定无记录，对于有效性请求，可能有记录
-    const pit::InRecordCollection &inRecords = pitEntry->getInRecords();
-    bool isPending = inRecords.begin() != inRecords.end();
-    if ( !isPending ) {
-      // 由于实验使用oldContentStrore，此处并未考虑到m_csFromNdnSim==nullptr的情况
-      if ( m_csFromNdnSim == nullptr ) {
-        m_cs.find( interest,
-                   bind( &Forwarder::onContentStoreHit, this, ref( inFace ),
-                         pitEntry, _1, _2 ),
-                   bind( &Forwarder::onContentStoreMiss, this, ref( inFace ),
-                         pitEntry, _1 ) );
-      } else {
-        shared_ptr<Data> match =
-            m_csFromNdnSim->Lookup( interest.shared_from_this() );
-        if ( match != nullptr ) {
-          // add by kan 20190409
-          // 判断过期字段是否为1，若为1，表示该数据包是服务器在删除PITListStore中的记录时发出的，
-          // 此时该数据包有可能不是最新，需要重新向服务器发起请求。
-          // cout << "exp: " <<match->getExpiration() <<endl;
-          // if ( match->getExpiration() == 1 ) {
-          //   cout << "××××××××××××××××××××××××××××××××××××××××××××××××××" <<
-          //   endl;
-          //   this->onContentStoreMiss( inFace, pitEntry, interest );
-          // } else
-          this->onContentStoreHit( inFace, pitEntry, interest, *match );
-          // end add
-        } else {
-          this->onContentStoreMiss( inFace, pitEntry, interest );
-        }
-      }
+  if ( !isPending ) {
+    if ( m_csFromNdnSim == nullptr ) {
+      m_cs.find( interest,
+                 bind( &Forwarder::onContentStoreHit, this, ref( inFace ),
+                       pitEntry, _1, _2 ),
+                 bind( &Forwarder::onContentStoreMiss, this, ref( inFace ),
+                       pitEntry, _1 ) );
     } else {
-      // add by kan 20190410
-      // 当PIT表中中有聚合记录时，对于有效性请求，需要查询CS中是否有记录
-      if ( interest.getValidationFlag() == 1 ) {
-        shared_ptr<Data> match =
-            m_csFromNdnSim->Lookup( interest.shared_from_this() );
-        if ( match != nullptr ) {
-          // 判断过期字段是否为1，若为1，表示该数据包是服务器在删除PITListStore中的记录时发出的，
-          // 此时该数据包有可能不是最新，需要重新向服务器发起请求。
-          // if ( match->getExpiration() == 1 )
-          //   this->onContentStoreMiss( inFace, pitEntry, interest );
-          // else
-          NFD_LOG_DEBUG( "match != nullptr" );
-          this->onContentStoreHit( inFace, pitEntry, interest, *match );
-
-        } else {
-          this->onContentStoreMiss( inFace, pitEntry, interest );
-        }
-        // end add
+      shared_ptr<Data> match =
+          m_csFromNdnSim->Lookup( interest.shared_from_this() );
+      if ( match != nullptr ) {
+        this->onContentStoreHit( inFace, pitEntry, interest, *match );
       } else {
         this->onContentStoreMiss( inFace, pitEntry, interest );
       }
     }
+  } else {
+    this->onContentStoreMiss( inFace, pitEntry, interest );
   }
 }
 
 void Forwarder::onContentStoreMiss( const Face &           inFace,
                                     shared_ptr<pit::Entry> pitEntry,
                                     const Interest &       interest ) {
-  if ( interest.getLocationRegistration() == 1 ) {
-    NFD_LOG_DEBUG( "onLocationRegistration interest=" << interest.getName() );
-  } else {
-    NFD_LOG_DEBUG( "onContentStoreMiss interest=" << interest.getName() );
-  }
+  NFD_LOG_DEBUG( "onContentStoreMiss interest=" << interest.getName() );
 
   shared_ptr<Face> face = const_pointer_cast<Face>( inFace.shared_from_this() );
   // insert InRecord
   pitEntry->insertOrUpdateInRecord( face, interest );
-  if ( interest.getLocationRegistration() == 0 ) {
-    // set PIT unsatisfy timer
-    this->setUnsatisfyTimer( pitEntry );
-  }
+
+  // set PIT unsatisfy timer
+  this->setUnsatisfyTimer( pitEntry );
 
   // FIB lookup
   shared_ptr<fib::Entry> fibEntry = m_fib.findLongestPrefixMatch( *pitEntry );
@@ -220,14 +156,6 @@ void Forwarder::onContentStoreMiss( const Face &           inFace,
   this->dispatchToStrategy( pitEntry, bind( &Strategy::afterReceiveInterest, _1,
                                             cref( inFace ), cref( interest ),
                                             fibEntry, pitEntry ) );
-  if ( interest.getLocationRegistration() == 1 ) {
-    NFD_LOG_DEBUG( m_pit.size() );
-    NFD_LOG_DEBUG( "m_pit.erase1" );
-
-    m_pit.erase( pitEntry );
-    NFD_LOG_DEBUG( m_pit.size() );
-    NFD_LOG_DEBUG( "m_pit.erase2" );
-  }
 }
 
 void Forwarder::onContentStoreHit( const Face &           inFace,
@@ -323,6 +251,10 @@ void Forwarder::onOutgoingInterest( shared_ptr<pit::Entry> pitEntry,
   // insert OutRecord
   pitEntry->insertOrUpdateOutRecord( outFace.shared_from_this(), *interest );
 
+  for ( const shared_ptr<fw::PipelineStage> &stage : m_stages ) {
+    stage->beforeOutgoingInterest( *pitEntry, outFace, *interest );
+  }
+
   // send Interest
   outFace.sendInterest( *interest );
   ++m_counters.getNOutInterests();
@@ -372,305 +304,108 @@ void Forwarder::onInterestFinalize(
 }
 
 void Forwarder::onIncomingData( Face &inFace, const Data &data ) {
-  // add by kan 20190401 20190402
+  // receive Data
+  NFD_LOG_DEBUG( "onIncomingData face=" << inFace.getId()
+                                        << " data=" << data.getName() );
+  const_cast<Data &>( data ).setIncomingFaceId( inFace.getId() );
   ++m_counters.getNInDatas();
-  int node = ns3::Simulator::GetContext();
-  // std::cout << "node " << node << " get data with value "
-  //           << data.getPITListBack() << " " << data.getValidationDataFlag()
-  //           << " " << data.getExpiration() << std::endl;
-  // cout << "node " << node << " size is " <<
-  // m_csFromNdnSim->Begin()->GetName()
-  //      << ", limit is " << endl;
-  int ValidationFlag        = data.getValidationDataFlag();    // 1或0
-  int ValidationPublishment = data.getValidationPublishment(); // 1或0
-  int Expiration            = data.getExpiration();
-  int Eligibility           = data.getEligibility();
-
-  // cout << node << " : " << data.getName() << " : " << ValidationPublishment
-  //      << endl;
-  // 读取PITListBack中的当前节点入端口号
-  if ( ValidationFlag == 1 && ValidationPublishment == 1 ) {
-    // 有有效性要求，且是服务器主动发布的数据
-    std::vector<std::string> res;
-    std::string              PITList = data.getPITListBack();
-    std::string              result;
-    std::stringstream        input( PITList );
-    while ( input >> result ) {
-      res.push_back( result );
-    }
 
-    // cout << node << " : " << data.getName() << " : "<<PITList << " : " <<
-    // res.size()<< endl;
-    //      << ValidationPublishment << endl;
-    int         port            = std::stoi( res[ res.size() - 1 ] );
-    std::string PITListBackTemp = "";
-    for ( unsigned int i = 0; i < res.size() - 1; i++ ) {
-      PITListBackTemp += res[ i ] + " ";
-    }
-
-    const_cast<Data &>( data ).setPITListBack( PITListBackTemp );
-    const_cast<Data &>( data ).setIncomingFaceId( inFace.getId() );
-    shared_ptr<Face> outFace = Forwarder::getFace( port );
-    this->onOutgoingData( data, *outFace );
-
-    // 服务器主动发布的数据存储在沿途节点前，需要将ValidationPublishment置0
-    const_cast<Data &>( data ).setValidationPublishment( 0 );
-
-    shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>( data );
-    dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
-    if ( Expiration == 1 ) {
-      // Expiration字段为1，则是过期内容，将cs表中该内容删除
-      // cout << "before: " <<m_csFromNdnSim->GetSize() <<endl;
-      m_csFromNdnSim->Erase( dataCopyWithoutPacket );
-      // NFD_LOG_DEBUG("Expiration");
-      // cout << "Node-" << node << " : "<< data.getName() << " : " <<
-      // data.getPITListBack() <<endl; cout << "after: " <<
-      // m_csFromNdnSim->GetSize() <<endl;
-    } else {
-      // CS insert
-      // NFD_LOG_DEBUG("Pubulishment");
-      if ( m_csFromNdnSim == nullptr ) {
-        m_cs.insert( *dataCopyWithoutPacket );
-      } else {
-        m_csFromNdnSim->Erase( dataCopyWithoutPacket );
-        m_csFromNdnSim->Add( dataCopyWithoutPacket );
-      }
+  for ( const shared_ptr<fw::PipelineStage> &stage : m_stages ) {
+    if ( stage->beforeIncomingData( inFace, data ) ) {
+      return;
     }
+  }
 
-    // cout<< to_string(port)<<endl;
-    // 有有效性要求的内容仅在边缘节点存储
-    // 20190412修改：允许全节点缓存
-    // if ( res.size() == 1 ) {
-    //   // 此处是边缘节点
-    //   shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>( data );
-    //   dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
-    //   // CS insert
-    //   if ( m_csFromNdnSim == nullptr ) {
-    //     m_cs.insert( *dataCopyWithoutPacket );
-    //   } else {
-    //     m_csFromNdnSim->Add( dataCopyWithoutPacket );
-    //   }
-    //   // cout << PITList << endl;
-    //   // shared_ptr<Face> outFace = getFace( port );
-    //   // this->onOutgoingData( data, *outFace );
-    //   // return;
-    // }
-
-    // 根据PITListBack记录的端口号转发有有效性要求的data
-
-    // outFace->sendData( data );
-    // ++m_counters.getNOutDatas();
+  // /localhost scope control
+  bool isViolatingLocalhost =
+      !inFace.isLocal() && LOCALHOST_NAME.isPrefixOf( data.getName() );
+  if ( isViolatingLocalhost ) {
+    NFD_LOG_DEBUG( "onIncomingData face=" << inFace.getId()
+                                          << " data=" << data.getName()
+                                          << " violates /localhost" );
+    // (drop)
+    return;
+  }
 
+  // PIT match
+  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches( data );
+  if ( pitMatches.begin() == pitMatches.end() ) {
+    // goto Data unsolicited pipeline
+    this->onDataUnsolicited( inFace, data );
+    return;
   }
-  // end add
 
-  // add by kan 20191231
-  else if ( ValidationFlag == 1 && Eligibility == 1 ) {
-    // receive Data
-    NFD_LOG_DEBUG( "onIncomingData face=" << inFace.getId()
-                                          << " data=" << data.getName() );
-    const_cast<Data &>( data ).setIncomingFaceId( inFace.getId() );
-    // ++m_counters.getNInDatas();
-
-    // /localhost scope control
-    bool isViolatingLocalhost =
-        !inFace.isLocal() && LOCALHOST_NAME.isPrefixOf( data.getName() );
-    if ( isViolatingLocalhost ) {
-      NFD_LOG_DEBUG( "onIncomingData face=" << inFace.getId()
-                                            << " data=" << data.getName()
-                                            << " violates /localhost" );
-      // (drop)
-      return;
-    }
-    // PIT match
-    pit::DataMatchResult pitMatches = m_pit.findAllDataMatches( data );
-    if ( pitMatches.begin() == pitMatches.end() ) {
-      // goto Data unsolicited pipeline
-      this->onDataUnsolicited( inFace, data );
-      return;
+  // Remove Ptr<Packet> from the Data before inserting into cache, serving two
+  // purposes
+  // - reduce amount of memory used by cached entries
+  // - remove all tags that (e.g., hop count tag) that could have been
+  // associated with Ptr<Packet>
+  //
+  // Copying of Data is relatively cheap operation, as it copies (mostly) a
+  // collection of Blocks pointing to the same underlying memory buffer.
+  shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>( data );
+  dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
+
+  bool isInserted = false;
+  for ( const shared_ptr<fw::PipelineStage> &stage : m_stages ) {
+    if ( stage->beforeCacheInsert( inFace, data, dataCopyWithoutPacket ) ) {
+      isInserted = true;
+      break;
     }
+  }
 
-    // Remove Ptr<Packet> from the Data before inserting into cache, serving two
-    // purposes
-    // - reduce amount of memory used by cached entries
-    // - remove all tags that (e.g., hop count tag) that could have been
-    // associated with Ptr<Packet>
-    //
-    // Copying of Data is relatively cheap operation, as it copies (mostly) a
-    // collection of Blocks pointing to the same underlying memory buffer.
-    shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>( data );
-    dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
-    // CS insert
+  // CS insert
+  if ( !isInserted ) {
     if ( m_csFromNdnSim == nullptr ) {
       m_cs.insert( *dataCopyWithoutPacket );
     } else {
-      shared_ptr<Interest> interest = make_shared<Interest>();
-      // ns3::Ptr<ns3::UniformRandomVariable> m_rand =
-      // CreateObject<ns3::UniformRandomVariable>();
-      // interest->setNonce(m_rand->GetValue( 0,
-      // std::numeric_limits<uint32_t>::max() ) );
-      interest->setName( data.getName() );
-      shared_ptr<Data> match = m_csFromNdnSim->Lookup( interest );
-
-      if ( match != nullptr ) {
-        // 先删除旧内容再缓存新内容
-        m_csFromNdnSim->Erase( dataCopyWithoutPacket );
-        m_csFromNdnSim->Add( dataCopyWithoutPacket );
-      } else {
-        // add by kan 20191231
-        interest->setPITList( "" );
-        interest->setValidationFlag( 1 );
-        // end add
-        interest->setLocationRegistration( 1 );
-        NFD_LOG_DEBUG( "setLocationRegistration" );
-        static boost::random::uniform_int_distribution<uint32_t> dist;
-
-        interest->setNonce( dist( getGlobalRng() ) );
-        inFace.sendInterest( *interest );
-        m_csFromNdnSim->Add( dataCopyWithoutPacket );
-      }
-
-      // cout << m_csFromNdnSim->GetSize() << endl;
+      m_csFromNdnSim->Add( dataCopyWithoutPacket );
     }
+  }
 
-    std::set<shared_ptr<Face>> pendingDownstreams;
-    // foreach PitEntry
-    for ( const shared_ptr<pit::Entry> &pitEntry : pitMatches ) {
-      NFD_LOG_DEBUG( "onIncomingData matching=" << pitEntry->getName() );
-
-      // cancel unsatisfy & straggler timer
-      this->cancelUnsatisfyAndStragglerTimer( pitEntry );
-
-      // remember pending downstreams
-      const pit::InRecordCollection &inRecords = pitEntry->getInRecords();
-      for ( pit::InRecordCollection::const_iterator it = inRecords.begin();
-            it != inRecords.end(); ++it ) {
-        if ( it->getExpiry() > time::steady_clock::now() ) {
-          pendingDownstreams.insert( it->getFace() );
-        }
-      }
-
-      // invoke PIT satisfy callback
-      beforeSatisfyInterest( *pitEntry, inFace, data );
-      this->dispatchToStrategy(
-          pitEntry, bind( &Strategy::beforeSatisfyInterest, _1, pitEntry,
-                          cref( inFace ), cref( data ) ) );
-
-      // Dead Nonce List insert if necessary (for OutRecord of inFace)
-      this->insertDeadNonceList( *pitEntry, true, data.getFreshnessPeriod(),
-                                 &inFace );
-
-      // mark PIT satisfied
-      pitEntry->deleteInRecords();
-      pitEntry->deleteOutRecord( inFace );
+  std::set<shared_ptr<Face>> pendingDownstreams;
+  // foreach PitEntry
+  for ( const shared_ptr<pit::Entry> &pitEntry : pitMatches ) {
+    NFD_LOG_DEBUG( "onIncomingData matching=" << pitEntry->getName() );
 
-      // set PIT straggler timer
-      this->setStragglerTimer( pitEntry, true, data.getFreshnessPeriod() );
-    }
-    // foreach pending downstream
-    for ( std::set<shared_ptr<Face>>::iterator it = pendingDownstreams.begin();
-          it != pendingDownstreams.end(); ++it ) {
-      shared_ptr<Face> pendingDownstream = *it;
-      if ( pendingDownstream.get() == &inFace ) {
-        continue;
-      }
-      // goto outgoing Data pipeline
-      this->onOutgoingData( data, *pendingDownstream );
-    }
-  }
-  // end add
-  else {
-    // 无有效性要求，或是有效性要求但属于正常请求响应返回的的数据
-    // receive Data
-    NFD_LOG_DEBUG( "onIncomingData face=" << inFace.getId()
-                                          << " data=" << data.getName() );
-    const_cast<Data &>( data ).setIncomingFaceId( inFace.getId() );
-    // ++m_counters.getNInDatas();
-
-    // /localhost scope control
-    bool isViolatingLocalhost =
-        !inFace.isLocal() && LOCALHOST_NAME.isPrefixOf( data.getName() );
-    if ( isViolatingLocalhost ) {
-      NFD_LOG_DEBUG( "onIncomingData face=" << inFace.getId()
-                                            << " data=" << data.getName()
-                                            << " violates /localhost" );
-      // (drop)
-      return;
-    }
-    // PIT match
-    pit::DataMatchResult pitMatches = m_pit.findAllDataMatches( data );
-    if ( pitMatches.begin() == pitMatches.end() ) {
-      // goto Data unsolicited pipeline
-      this->onDataUnsolicited( inFace, data );
-      return;
-    }
+    // cancel unsatisfy & straggler timer
+    this->cancelUnsatisfyAndStragglerTimer( pitEntry );
 
-    // Remove Ptr<Packet> from the Data before inserting into cache, serving two
-    // purposes
-    // - reduce amount of memory used by cached entries
-    // - remove all tags that (e.g., hop count tag) that could have been
-    // associated with Ptr<Packet>
-    //
-    // Copying of Data is relatively cheap operation, as it copies (mostly) a
-    // collection of Blocks pointing to the same underlying memory buffer
-    if ( ValidationFlag == 0 ) {
-      shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>( data );
-      dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
-      // CS insert
-      if ( m_csFromNdnSim == nullptr ) {
-        m_cs.insert( *dataCopyWithoutPacket );
-      } else {
-        // 先删除旧内容再缓存新内容
-        m_csFromNdnSim->Erase( dataCopyWithoutPacket );
-        m_csFromNdnSim->Add( dataCopyWithoutPacket );
-        // cout << m_csFromNdnSim->GetSize() << endl;
+    // remember pending downstreams
+    const pit::InRecordCollection &inRecords = pitEntry->getInRecords();
+    for ( pit::InRecordCollection::const_iterator it = inRecords.begin();
+          it != inRecords.end(); ++it ) {
+      if ( it->getExpiry() > time::steady_clock::now() ) {
+        pendingDownstreams.insert( it->getFace() );
       }
     }
 
-    std::set<shared_ptr<Face>> pendingDownstreams;
-    // foreach PitEntry
-    for ( const shared_ptr<pit::Entry> &pitEntry : pitMatches ) {
-      NFD_LOG_DEBUG( "onIncomingData matching=" << pitEntry->getName() );
-
-      // cancel unsatisfy & straggler timer
-      this->cancelUnsatisfyAndStragglerTimer( pitEntry );
-
-      // remember pending downstreams
-      const pit::InRecordCollection &inRecords = pitEntry->getInRecords();
-      for ( pit::InRecordCollection::const_iterator it = inRecords.begin();
-            it != inRecords.end(); ++it ) {
-        if ( it->getExpiry() > time::steady_clock::now() ) {
-          pendingDownstreams.insert( it->getFace() );
-        }
-      }
-
-      // invoke PIT satisfy callback
-      beforeSatisfyInterest( *pitEntry, inFace, data );
-      this->dispatchToStrategy(
-          pitEntry, bind( &Strategy::beforeSatisfyInterest, _1, pitEntry,
-                          cref( inFace ), cref( data ) ) );
+    // invoke PIT satisfy callback
+    beforeSatisfyInterest( *pitEntry, inFace, data );
+    this->dispatchToStrategy( pitEntry,
+                              bind( &Strategy::beforeSatisfyInterest, _1,
+                                    pitEntry, cref( inFace ), cref( data ) ) );
 
-      // Dead Nonce List insert if necessary (for OutRecord of inFace)
-      this->insertDeadNonceList( *pitEntry, true, data.getFreshnessPeriod(),
-                                 &inFace );
+    // Dead Nonce List insert if necessary (for OutRecord of inFace)
+    this->insertDeadNonceList( *pitEntry, true, data.getFreshnessPeriod(),
+                               &inFace );
 
-      // mark PIT satisfied
-      pitEntry->deleteInRecords();
-      pitEntry->deleteOutRecord( inFace );
+    // mark PIT satisfied
+    pitEntry->deleteInRecords();
+    pitEntry->deleteOutRecord( inFace );
 
-      // set PIT straggler timer
-      this->setStragglerTimer( pitEntry, true, data.getFreshnessPeriod() );
-    }
-    // foreach pending downstream
-    for ( std::set<shared_ptr<Face>>::iterator it = pendingDownstreams.begin();
-          it != pendingDownstreams.end(); ++it ) {
-      shared_ptr<Face> pendingDownstream = *it;
-      if ( pendingDownstream.get() == &inFace ) {
-        continue;
-      }
-      // goto outgoing Data pipeline
-      this->onOutgoingData( data, *pendingDownstream );
+    // set PIT straggler timer
+    this->setStragglerTimer( pitEntry, true, data.getFreshnessPeriod() );
+  }
+  // foreach pending downstream
+  for ( std::set<shared_ptr<Face>>::iterator it = pendingDownstreams.begin();
+        it != pendingDownstreams.end(); ++it ) {
+    shared_ptr<Face> pendingDownstream = *it;
+    if ( pendingDownstream.get() == &inFace ) {
+      continue;
     }
+    // goto outgoing Data pipeline
+    this->onOutgoingData( data, *pendingDownstream );
   }
 }
 
@@ -35,6 +35,7 @@
 #include "table/cs.hpp"
 #include "table/measurements.hpp"
 #include "table/strategy-choice.hpp"
+#include "table/subscription-table.hpp"
 #include "table/dead-nonce-list.hpp"
 
 #include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
@@ -44,6 +45,7 @@ namespace nfd {
 
 namespace fw {
 class Strategy;
+class PipelineStage;
 } // namespace fw
 
 class NullFace;
@@ -109,6 +111,18 @@ public: // forwarding entrypoints and tables
   DeadNonceList&
   getDeadNonceList();
 
+  SubscriptionTable&
+  getSubscriptionTable();
+
+public: // optional pipeline stages
+  /** \brief install a pipeline stage
+   *
+   *  Stages are invoked in the order of installation.
+   *  \sa fw::PipelineStage
+   */
+  void
+  addPipelineStage(shared_ptr<fw::PipelineStage> stage);
+
 public: // allow enabling ndnSIM content store (will be removed in the future)
   void
   setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs);
@@ -222,21 +236,26 @@ private:
   FaceTable m_faceTable;
 
   // tables
-  NameTree       m_nameTree;
-  Fib            m_fib;
-  Pit            m_pit;
-  Cs             m_cs;
-  Measurements   m_measurements;
-  StrategyChoice m_strategyChoice;
-  DeadNonceList  m_deadNonceList;
+  NameTree          m_nameTree;
+  Fib               m_fib;
+  Pit               m_pit;
+  Cs                m_cs;
+  Measurements      m_measurements;
+  SubscriptionTable m_subscriptionTable;
+  StrategyChoice    m_strategyChoice;
+  DeadNonceList     m_deadNonceList;
   shared_ptr<NullFace> m_csFace;
 
   ns3::Ptr<ns3::ndn::ContentStore> m_csFromNdnSim;
 
+  std::vector<shared_ptr<fw::PipelineStage>> m_stages;
+
   static const Name LOCALHOST_NAME;
 
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
+  // allow PipelineStage (base class) to enter pipelines
+  friend class fw::PipelineStage;
 
 protected:
   // add by kan 20191231
@@ -323,6 +342,12 @@ Forwarder::getDeadNonceList()
   return m_deadNonceList;
 }
 
+inline SubscriptionTable&
+Forwarder::getSubscriptionTable()
+{
+  return m_subscriptionTable;
+}
+
 inline void
 Forwarder::setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs)
 {
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pipeline-stage.hpp"
+
+namespace nfd {
+namespace fw {
+
+PipelineStage::PipelineStage(Forwarder& forwarder)
+  : m_forwarder(forwarder)
+{
+}
+
+PipelineStage::~PipelineStage()
+{
+}
+
+bool
+PipelineStage::beforeIncomingInterest(Face& inFace, const Interest& interest)
+{
+  return false;
+}
+
+bool
+PipelineStage::afterPitInsert(Face& inFace, const Interest& interest,
+                              shared_ptr<pit::Entry> pitEntry, bool isPending)
+{
+  return false;
+}
+
+void
+PipelineStage::beforeOutgoingInterest(const pit::Entry& pitEntry, Face& outFace,
+                                      const Interest& interest)
+{
+}
+
+bool
+PipelineStage::beforeIncomingData(Face& inFace, const Data& data)
+{
+  return false;
+}
+
+bool
+PipelineStage::beforeCacheInsert(Face& inFace, const Data& data, shared_ptr<Data> dataCopy)
+{
+  return false;
+}
+
+} // namespace fw
+} // namespace nfd
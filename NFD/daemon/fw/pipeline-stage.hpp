@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_PIPELINE_STAGE_HPP
+#define NFD_DAEMON_FW_PIPELINE_STAGE_HPP
+
+#include "forwarder.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief represents an optional stage of the forwarding pipelines
+ *
+ *  Stages are installed on a forwarder with Forwarder::addPipelineStage, and their triggers
+ *  are invoked in the order of installation at fixed points of the pipelines.
+ *  A forwarder without stages runs the plain NDN pipelines.
+ *  Default implementations of the triggers do nothing.
+ */
+class PipelineStage : noncopyable
+{
+public:
+  explicit
+  PipelineStage(Forwarder& forwarder);
+
+  virtual
+  ~PipelineStage();
+
+public: // triggers
+  /** \brief trigger before an incoming Interest is processed
+   *  \return true if the stage has consumed the Interest, which stops the pipeline
+   */
+  virtual bool
+  beforeIncomingInterest(Face& inFace, const Interest& interest);
+
+  /** \brief trigger after an incoming Interest is inserted into PIT and is not a loop
+   *  \param isPending whether the PIT entry already has InRecords
+   *  \return true if the stage has processed the Interest, which skips ContentStore lookup
+   */
+  virtual bool
+  afterPitInsert(Face& inFace, const Interest& interest,
+                 shared_ptr<pit::Entry> pitEntry, bool isPending);
+
+  /** \brief trigger before an Interest is sent to outFace
+   */
+  virtual void
+  beforeOutgoingInterest(const pit::Entry& pitEntry, Face& outFace, const Interest& interest);
+
+  /** \brief trigger before an incoming Data is processed
+   *  \return true if the stage has consumed the Data, which stops the pipeline
+   */
+  virtual bool
+  beforeIncomingData(Face& inFace, const Data& data);
+
+  /** \brief trigger before a solicited Data is inserted into ContentStore
+   *  \param dataCopy copy of the Data without ns-3 packet, which is to be cached
+   *  \return true if the stage has taken care of caching, which skips ContentStore insert
+   */
+  virtual bool
+  beforeCacheInsert(Face& inFace, const Data& data, shared_ptr<Data> dataCopy);
+
+protected: // actions
+  void
+  onContentStoreHit(const Face& inFace, shared_ptr<pit::Entry> pitEntry,
+                    const Interest& interest, const Data& data);
+
+  void
+  onContentStoreMiss(const Face& inFace, shared_ptr<pit::Entry> pitEntry,
+                     const Interest& interest);
+
+  void
+  onOutgoingData(const Data& data, Face& outFace);
+
+  void
+  setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry);
+
+protected: // accessors
+  Forwarder&
+  getForwarder();
+
+  /** \return ndnSIM content store, or nullptr if the forwarder uses NFD's Cs
+   */
+  ns3::Ptr<ns3::ndn::ContentStore>
+  getCsFromNdnSim();
+
+private:
+  Forwarder& m_forwarder;
+};
+
+inline void
+PipelineStage::onContentStoreHit(const Face& inFace, shared_ptr<pit::Entry> pitEntry,
+                                 const Interest& interest, const Data& data)
+{
+  m_forwarder.onContentStoreHit(inFace, pitEntry, interest, data);
+}
+
+inline void
+PipelineStage::onContentStoreMiss(const Face& inFace, shared_ptr<pit::Entry> pitEntry,
+                                  const Interest& interest)
+{
+  m_forwarder.onContentStoreMiss(inFace, pitEntry, interest);
+}
+
+inline void
+PipelineStage::onOutgoingData(const Data& data, Face& outFace)
+{
+  m_forwarder.onOutgoingData(data, outFace);
+}
+
+inline void
+PipelineStage::setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry)
+{
+  m_forwarder.setUnsatisfyTimer(pitEntry);
+}
+
+inline Forwarder&
+PipelineStage::getForwarder()
+{
+  return m_forwarder;
+}
+
+inline ns3::Ptr<ns3::ndn::ContentStore>
+PipelineStage::getCsFromNdnSim()
+{
+  return m_forwarder.m_csFromNdnSim;
+}
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_PIPELINE_STAGE_HPP
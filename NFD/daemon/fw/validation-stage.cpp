@@ -0,0 +1,271 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne
+ * University, Washington University in St. Louis, Beijing Institute of
+ * Technology, The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "validation-stage.hpp"
+#include "core/logger.hpp"
+#include "core/random.hpp"
+
+#include "utils/ndn-ns3-packet-tag.hpp"
+#include "utils/ndn-publication-tree.hpp"
+
+#include <boost/random/uniform_int_distribution.hpp>
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT( "ValidationStage" );
+
+ValidationStage::ValidationStage( Forwarder &forwarder )
+    : PipelineStage( forwarder ) {}
+
+bool ValidationStage::beforeIncomingInterest( Face &          inFace,
+                                              const Interest &interest ) {
+  // add by kan 20190324 20190330
+  if ( interest.getValidationFlag() == 1 ) {
+    std::string PITListStr = interest.getPITList();
+    PITListStr += std::to_string( inFace.getId() ) + " ";
+    const_cast<Interest &>( interest ).setPITList( PITListStr );
+  }
+
+  // add by kan 20201231
+  if ( interest.getLocationRegistration() == 1 ) {
+    this->onLocationRegistration( interest );
+    return true;
+  }
+  return false;
+}
+
+void ValidationStage::onLocationRegistration( const Interest &interest ) {
+  // 注册位置的兴趣包直接转发,不经过PIT表
+  NFD_LOG_DEBUG( "onLocationRegistration interest=" << interest.getName() );
+  Forwarder &forwarder = this->getForwarder();
+
+  shared_ptr<pit::Entry>       pitEntry = make_shared<pit::Entry>( interest );
+  shared_ptr<name_tree::Entry> nameTreeEntry =
+      forwarder.getNameTree().lookup( interest.getName() );
+  nameTreeEntry->insertPitEntry( pitEntry );
+
+  // FIB lookup
+  shared_ptr<fib::Entry> fibEntry =
+      forwarder.getFib().findLongestPrefixMatch( pitEntry->getName() );
+
+  const fib::NextHopList &nexthops = fibEntry->getNextHops();
+  shared_ptr<Face>        outFace  = nexthops.begin()->getFace();
+  outFace->sendInterest( interest );
+}
+
+bool ValidationStage::afterPitInsert( Face &inFace, const Interest &interest,
+                                      shared_ptr<pit::Entry> pitEntry,
+                                      bool                   isPending ) {
+  if ( interest.getValidationFlag() != 1 ) {
+    return false;
+  }
+
+  // 记录有效性请求的下游订阅者；本节点已向上游订阅时，请求可在本地吸收
+  bool isSubscribedUpstream =
+      this->getForwarder()
+          .getSubscriptionTable()
+          .subscribeDownstream( interest.getName(), inFace )
+          ->isSubscribedUpstream();
+
+  // isPending为False时，与普通请求一样查询cs表
+  if ( !isPending ) {
+    return false;
+  }
+
+  // add by kan 20190410
+  // 当PIT表中中有聚合记录时，对于有效性请求，需要查询CS中是否有记录
+  shared_ptr<Data> match =
+      this->getCsFromNdnSim()->Lookup( interest.shared_from_this() );
+  if ( match != nullptr ) {
+    NFD_LOG_DEBUG( "match != nullptr" );
+    this->onContentStoreHit( inFace, pitEntry, interest, *match );
+  } else if ( isSubscribedUpstream ) {
+    // 已有上游订阅且请求已发出，只在PIT中聚合，不再向上游转发
+    NFD_LOG_DEBUG( "afterPitInsert interest=" << interest.getName()
+                                              << " absorbed" );
+    pitEntry->insertOrUpdateInRecord(
+        const_pointer_cast<Face>( inFace.shared_from_this() ), interest );
+    this->setUnsatisfyTimer( pitEntry );
+  } else {
+    this->onContentStoreMiss( inFace, pitEntry, interest );
+  }
+  // end add
+  return true;
+}
+
+void ValidationStage::beforeOutgoingInterest( const pit::Entry &pitEntry,
+                                              Face &            outFace,
+                                              const Interest &  interest ) {
+  if ( interest.getValidationFlag() == 1 &&
+       interest.getLocationRegistration() == 0 ) {
+    // 有效性请求的路径将存入服务器的PITListStore，本节点成为上游订阅者
+    this->getForwarder().getSubscriptionTable().subscribeUpstream(
+        interest.getName() );
+  }
+}
+
+bool ValidationStage::beforeIncomingData( Face &inFace, const Data &data ) {
+  // add by kan 20190401 20190402
+  if ( data.getValidationDataFlag() == 1 &&
+       data.getValidationPublishment() == 1 ) {
+    // 有有效性要求，且是服务器主动发布的数据
+    this->onPublication( inFace, data );
+    return true;
+  }
+  return false;
+}
+
+void ValidationStage::onPublication( Face &inFace, const Data &data ) {
+  Forwarder &                      forwarder = this->getForwarder();
+  SubscriptionTable &              subscriptionTable =
+      forwarder.getSubscriptionTable();
+  ns3::Ptr<ns3::ndn::ContentStore> cs         = this->getCsFromNdnSim();
+  int                              Expiration = data.getExpiration();
+
+  // 读取PITListBack中的当前节点入端口号
+  std::string PITList = data.getPITListBack();
+
+  std::set<FaceId> pathFaces; // 按路径已转发的端口
+  if ( ns3::ndn::PublicationTree::isEncoded( PITList ) ) {
+    // 按反向路径树转发：每个分支发送一份，携带该分支的子树
+    for ( const auto &branch : ns3::ndn::PublicationTree::decode( PITList ) ) {
+      shared_ptr<Face> outFace = forwarder.getFace( branch.first );
+      if ( outFace == nullptr ) {
+        NFD_LOG_DEBUG( "publication face=" << branch.first << " not found" );
+        continue;
+      }
+      shared_ptr<Data> branchData = make_shared<Data>( data );
+      branchData->setPITListBack( branch.second );
+      this->onOutgoingData( *branchData, *outFace );
+      pathFaces.insert( branch.first );
+    }
+  } else {
+    std::vector<std::string> res;
+    std::string              result;
+    std::stringstream        input( PITList );
+    while ( input >> result ) {
+      res.push_back( result );
+    }
+
+    int         port            = std::stoi( res[ res.size() - 1 ] );
+    std::string PITListBackTemp = "";
+    for ( unsigned int i = 0; i < res.size() - 1; i++ ) {
+      PITListBackTemp += res[ i ] + " ";
+    }
+
+    const_cast<Data &>( data ).setPITListBack( PITListBackTemp );
+    shared_ptr<Face> outFace = forwarder.getFace( port );
+    this->onOutgoingData( data, *outFace );
+    pathFaces.insert( port );
+  }
+
+  if ( Expiration == 1 ) {
+    // 服务器删除了经过本节点的路径，之后的请求需要重新向上游订阅
+    subscriptionTable.unsubscribeUpstream( data.getName() );
+  } else {
+    // 发布给不在服务器路径上的本地订阅者，空树表示只需发给其本地订阅者
+    subscriptionTable.subscribeUpstream( data.getName() );
+    for ( const shared_ptr<Face> &downstream :
+          subscriptionTable.getDownstreamFaces( data.getName() ) ) {
+      if ( downstream->getId() == inFace.getId() ||
+           pathFaces.count( downstream->getId() ) > 0 ) {
+        continue;
+      }
+      shared_ptr<Data> subscriberData = make_shared<Data>( data );
+      subscriberData->setPITListBack( "()" );
+      this->onOutgoingData( *subscriberData, *downstream );
+    }
+  }
+
+  // 服务器主动发布的数据存储在沿途节点前，需要将ValidationPublishment置0
+  const_cast<Data &>( data ).setValidationPublishment( 0 );
+
+  shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>( data );
+  dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
+  if ( Expiration == 1 ) {
+    // Expiration字段为1，则是过期内容，将cs表中该内容删除
+    // 只记录失效版本，旧内容在下次查找或替换时被淘汰
+    cs->Invalidate( data.getName() );
+  } else {
+    // CS insert
+    if ( cs == nullptr ) {
+      forwarder.getCs().insert( *dataCopyWithoutPacket );
+    } else {
+      cs->Invalidate( data.getName() );
+      cs->Add( dataCopyWithoutPacket );
+    }
+  }
+}
+
+bool ValidationStage::beforeCacheInsert( Face &inFace, const Data &data,
+                                         shared_ptr<Data> dataCopy ) {
+  ns3::Ptr<ns3::ndn::ContentStore> cs = this->getCsFromNdnSim();
+  if ( cs == nullptr ) {
+    // 有效性要求但属于正常请求响应返回的数据不缓存，其余数据由NFD的cs表按普通数据缓存
+    return data.getValidationDataFlag() == 1 && data.getEligibility() != 1;
+  }
+
+  if ( data.getValidationDataFlag() == 0 ) {
+    // 先删除旧内容再缓存新内容
+    cs->Invalidate( data.getName() );
+    cs->Add( dataCopy );
+    return true;
+  }
+
+  // 有效性要求但属于正常请求响应返回的数据不缓存
+  if ( data.getEligibility() != 1 ) {
+    return true;
+  }
+
+  // add by kan 20191231
+  shared_ptr<Interest> interest = make_shared<Interest>();
+  interest->setName( data.getName() );
+  shared_ptr<Data> match = cs->Lookup( interest );
+
+  if ( match != nullptr ) {
+    // 先删除旧内容再缓存新内容
+    cs->Invalidate( data.getName() );
+    cs->Add( dataCopy );
+  } else {
+    // 首次缓存时向服务器注册本节点位置
+    interest->setPITList( "" );
+    interest->setValidationFlag( 1 );
+    interest->setLocationRegistration( 1 );
+    NFD_LOG_DEBUG( "setLocationRegistration" );
+    static boost::random::uniform_int_distribution<uint32_t> dist;
+
+    interest->setNonce( dist( getGlobalRng() ) );
+    inFace.sendInterest( *interest );
+    cs->Add( dataCopy );
+  }
+  return true;
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_VALIDATION_STAGE_HPP
+#define NFD_DAEMON_FW_VALIDATION_STAGE_HPP
+
+#include "pipeline-stage.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief pipeline stage of content validation
+ *
+ *  Validation Interests record their path (PITList) and subscribe this forwarder to the name;
+ *  publications of the producer are forwarded back along the stored paths (PITListBack)
+ *  and refresh or invalidate cached copies.  Location registration Interests bypass PIT,
+ *  and eligible Data triggers a location registration when it is cached for the first time.
+ */
+class ValidationStage : public PipelineStage
+{
+public:
+  explicit
+  ValidationStage(Forwarder& forwarder);
+
+  virtual bool
+  beforeIncomingInterest(Face& inFace, const Interest& interest) DECL_OVERRIDE;
+
+  virtual bool
+  afterPitInsert(Face& inFace, const Interest& interest,
+                 shared_ptr<pit::Entry> pitEntry, bool isPending) DECL_OVERRIDE;
+
+  virtual void
+  beforeOutgoingInterest(const pit::Entry& pitEntry, Face& outFace,
+                         const Interest& interest) DECL_OVERRIDE;
+
+  virtual bool
+  beforeIncomingData(Face& inFace, const Data& data) DECL_OVERRIDE;
+
+  virtual bool
+  beforeCacheInsert(Face& inFace, const Data& data, shared_ptr<Data> dataCopy) DECL_OVERRIDE;
+
+private:
+  /** \brief forward location registration Interest to the first nexthop, bypassing PIT
+   */
+  void
+  onLocationRegistration(const Interest& interest);
+
+  /** \brief forward publication back along PITListBack and update the cached copy
+   */
+  void
+  onPublication(Face& inFace, const Data& data);
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_VALIDATION_STAGE_HPP
@@ -177,6 +177,26 @@ FibManager::onValidatedFibRequest(const shared_ptr<const Interest>& request)
     }
 }
 
+ControlResponse
+FibManager::executeTrustedCommand(const Name::Component& verb, ControlParameters parameters)
+{
+  ControlResponse response;
+
+  SignedVerbDispatchTable::const_iterator verbProcessor = m_signedVerbDispatch.find(verb);
+  if (verbProcessor != m_signedVerbDispatch.end())
+    {
+      NFD_LOG_DEBUG("trusted command: processing verb: " << verb);
+      (verbProcessor->second)(this, parameters, response);
+    }
+  else
+    {
+      NFD_LOG_DEBUG("trusted command: unsupported verb: " << verb);
+      setResponse(response, 501, "Unsupported command");
+    }
+
+  return response;
+}
+
 void
 FibManager::addNextHop(ControlParameters& parameters,
                        ControlResponse& response)
@@ -53,6 +53,15 @@ public:
   void
   onFibRequest(const Interest& request);
 
+  /** \brief execute a signed verb (e.g., add-nexthop) for a trusted in-process caller
+   *
+   *  Unlike onFibRequest, the command is not encoded as an Interest, and its signature is
+   *  neither required nor validated.  Intended for simulation helpers.
+   *  \return response that would have been sent for the equivalent command Interest
+   */
+  ControlResponse
+  executeTrustedCommand(const Name::Component& verb, ControlParameters parameters);
+
 private:
 
   void
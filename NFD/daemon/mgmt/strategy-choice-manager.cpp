@@ -110,9 +110,6 @@ StrategyChoiceManager::listStrategies(const Interest& request)
 void
 StrategyChoiceManager::onValidatedStrategyChoiceRequest(const shared_ptr<const Interest>& request)
 {
-  static const Name::Component VERB_SET("set");
-  static const Name::Component VERB_UNSET("unset");
-
   const Name& command = request->getName();
   const Name::Component& parameterComponent = command[COMMAND_PREFIX.size() + 1];
 
@@ -124,6 +121,16 @@ StrategyChoiceManager::onValidatedStrategyChoiceRequest(const shared_ptr<const I
     }
 
   const Name::Component& verb = command.at(COMMAND_PREFIX.size());
+  sendResponse(command, executeTrustedCommand(verb, parameters));
+}
+
+ControlResponse
+StrategyChoiceManager::executeTrustedCommand(const Name::Component& verb,
+                                             ControlParameters parameters)
+{
+  static const Name::Component VERB_SET("set");
+  static const Name::Component VERB_UNSET("unset");
+
   ControlResponse response;
   if (verb == VERB_SET)
     {
@@ -139,7 +146,7 @@ StrategyChoiceManager::onValidatedStrategyChoiceRequest(const shared_ptr<const I
       setResponse(response, 501, "Unsupported command");
     }
 
-  sendResponse(command, response);
+  return response;
 }
 
 void
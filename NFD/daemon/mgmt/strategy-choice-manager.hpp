@@ -50,6 +50,15 @@ public:
   void
   onStrategyChoiceRequest(const Interest& request);
 
+  /** \brief execute a signed verb (set or unset) for a trusted in-process caller
+   *
+   *  Unlike onStrategyChoiceRequest, the command is not encoded as an Interest, and its
+   *  signature is neither required nor validated.  Intended for simulation helpers.
+   *  \return response that would have been sent for the equivalent command Interest
+   */
+  ControlResponse
+  executeTrustedCommand(const Name::Component& verb, ControlParameters parameters);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   void
@@ -80,6 +80,7 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
   // tables
   // {
   //    cs_max_packets 65536
+  //    cs_max_bytes 0 ; optional, limit of total Data wire size (0 means no limit)
   //
   //    strategy_choice
   //    {
@@ -109,6 +110,25 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
       nCsMaxPackets = *valCsMaxPackets;
     }
 
+  size_t nCsMaxBytes = 0;
+
+  boost::optional<const ConfigSection&> csMaxBytesNode =
+    configSection.get_child_optional("cs_max_bytes");
+
+  if (csMaxBytesNode)
+    {
+      boost::optional<size_t> valCsMaxBytes =
+        configSection.get_optional<size_t>("cs_max_bytes");
+
+      if (!valCsMaxBytes)
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"cs_max_bytes\""
+                                                  " in \"tables\" section"));
+        }
+
+      nCsMaxBytes = *valCsMaxBytes;
+    }
+
   boost::optional<const ConfigSection&> strategyChoiceSection =
     configSection.get_child_optional("strategy_choice");
 
@@ -122,6 +142,10 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
       NFD_LOG_INFO("Setting CS max packets to " << nCsMaxPackets);
 
       m_cs.setLimit(nCsMaxPackets);
+
+      NFD_LOG_INFO("Setting CS max bytes to " << nCsMaxBytes);
+      m_cs.setByteLimit(nCsMaxBytes);
+
       m_areTablesConfigured = true;
     }
 }
@@ -31,6 +31,7 @@ namespace cs {
 
 Policy::Policy(const std::string& policyName)
   : m_policyName(policyName)
+  , m_byteLimit(0)
 {
 }
 
@@ -47,6 +48,21 @@ Policy::setLimit(size_t nMaxEntries)
   this->evictEntries();
 }
 
+void
+Policy::setByteLimit(size_t nMaxBytes)
+{
+  m_byteLimit = nMaxBytes;
+
+  this->evictEntries();
+}
+
+bool
+Policy::isOverLimit() const
+{
+  BOOST_ASSERT(m_cs != nullptr);
+  return m_cs->size() > m_limit || (m_byteLimit > 0 && m_cs->getNBytes() > m_byteLimit);
+}
+
 void
 Policy::afterInsert(iterator i)
 {
@@ -73,6 +73,20 @@ public:
   void
   setLimit(size_t nMaxEntries);
 
+  /** \brief gets byte limit (in bytes of Data wire encoding and virtual payload), 0 if there is no byte limit
+   */
+  size_t
+  getByteLimit() const;
+
+  /** \brief sets byte limit (in bytes of Data wire encoding and virtual payload)
+   *  \param nMaxBytes byte limit, or 0 to disable the byte limit
+   *  \post cs.getNBytes() <= getByteLimit(), if getByteLimit() > 0
+   *
+   *  The policy may evict entries if necessary.
+   */
+  void
+  setByteLimit(size_t nMaxBytes);
+
   /** \brief emits when an entry is being evicted
    *
    *  A policy implementation should emit this signal to cause CS to erase the entry from its index.
@@ -147,17 +161,25 @@ protected:
   doBeforeUse(iterator i) = 0;
 
   /** \brief evicts zero or more entries
-   *  \post CS size does not exceed hard limit
+   *  \post CS size does not exceed hard limit nor byte limit
    */
   virtual void
   evictEntries() = 0;
 
+  /** \return whether CS size exceeds hard limit or byte limit
+   *
+   *  A policy implementation should evict entries while this returns true.
+   */
+  bool
+  isOverLimit() const;
+
 protected:
   DECLARE_SIGNAL_EMIT(beforeEvict)
 
 private:
   std::string m_policyName;
   size_t m_limit;
+  size_t m_byteLimit;
   Cs* m_cs;
 };
 
@@ -185,6 +207,12 @@ Policy::getLimit() const
   return m_limit;
 }
 
+inline size_t
+Policy::getByteLimit() const
+{
+  return m_byteLimit;
+}
+
 } // namespace cs
 } // namespace nfd
 
@@ -28,6 +28,8 @@
 #include "core/logger.hpp"
 #include "core/algorithm.hpp"
 
+#include "utils/ndn-virtual-payload-tag.hpp"
+
 NFD_LOG_INIT("ContentStore");
 
 namespace nfd {
@@ -44,6 +46,15 @@ static_assert(std::is_default_constructible<Cs::const_iterator>::value,
 BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Cs::const_iterator>));
 #endif // HAVE_IS_DEFAULT_CONSTRUCTIBLE
 
+/** \return wire size of Data, plus its virtual payload that ndnSIM does not allocate
+ */
+static size_t
+getDataSize(const Data& data)
+{
+  auto payloadTag = data.findTag<ns3::ndn::VirtualPayloadTag>();
+  return data.wireEncode().size() + (payloadTag != nullptr ? payloadTag->getSize() : 0);
+}
+
 unique_ptr<Policy>
 makeDefaultPolicy()
 {
@@ -51,6 +62,7 @@ makeDefaultPolicy()
 }
 
 Cs::Cs(size_t nMaxPackets, unique_ptr<Policy> policy)
+  : m_nBytes(0)
 {
   this->setPolicyImpl(policy);
   m_policy->setLimit(nMaxPackets);
@@ -68,14 +80,28 @@ Cs::getLimit() const
   return m_policy->getLimit();
 }
 
+void
+Cs::setByteLimit(size_t nMaxBytes)
+{
+  m_policy->setByteLimit(nMaxBytes);
+}
+
+size_t
+Cs::getByteLimit() const
+{
+  return m_policy->getByteLimit();
+}
+
 void
 Cs::setPolicy(unique_ptr<Policy> policy)
 {
   BOOST_ASSERT(policy != nullptr);
   BOOST_ASSERT(m_policy != nullptr);
   size_t limit = m_policy->getLimit();
+  size_t byteLimit = m_policy->getByteLimit();
   this->setPolicyImpl(policy);
   m_policy->setLimit(limit);
+  m_policy->setByteLimit(byteLimit);
 }
 
 bool
@@ -110,6 +136,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    m_nBytes += getDataSize(data);
     m_policy->afterInsert(it);
   }
 
@@ -201,6 +228,7 @@ Cs::setPolicyImpl(unique_ptr<Policy>& policy)
 {
   m_policy = std::move(policy);
   m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
+      m_nBytes -= getDataSize(it->getData());
       m_table.erase(it);
     });
 
@@ -105,6 +105,17 @@ public:
   size_t
   getLimit() const;
 
+  /** \brief changes capacity (in bytes of Data wire encoding and virtual payload)
+   *  \param nMaxBytes byte limit, or 0 to disable the byte limit
+   */
+  void
+  setByteLimit(size_t nMaxBytes);
+
+  /** \return capacity (in bytes), or 0 if there is no byte limit
+   */
+  size_t
+  getByteLimit() const;
+
   /** \brief changes cs replacement policy
    *  \pre size() == 0
    */
@@ -127,6 +138,14 @@ public:
     return m_table.size();
   }
 
+  /** \return total wire size of stored packets, including their virtual payload
+   */
+  size_t
+  getNBytes() const
+  {
+    return m_nBytes;
+  }
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   dump();
@@ -183,6 +202,7 @@ private: // find
 
 private:
   Table m_table;
+  size_t m_nBytes;
   unique_ptr<Policy> m_policy;
   ndn::util::signal::ScopedConnection m_beforeEvictConnection;
 };
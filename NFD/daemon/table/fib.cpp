@@ -123,7 +123,7 @@ Fib::insert(const Name& prefix)
   shared_ptr<fib::Entry> entry = nameTreeEntry->getFibEntry();
   if (static_cast<bool>(entry))
     return std::make_pair(entry, false);
-  entry = make_shared<fib::Entry>(prefix);
+  entry = std::allocate_shared<fib::Entry>(m_nameTree.getAllocator<fib::Entry>(), prefix);
   nameTreeEntry->setFibEntry(entry);
   ++m_nItems;
   return std::make_pair(entry, true);
@@ -45,7 +45,7 @@ Measurements::get(name_tree::Entry& nte)
   if (entry != nullptr)
     return entry;
 
-  entry = make_shared<Entry>(nte.getPrefix());
+  entry = std::allocate_shared<Entry>(m_nameTree.getAllocator<Entry>(), nte.getPrefix());
   nte.setMeasurementsEntry(entry);
   ++m_nItems;
 
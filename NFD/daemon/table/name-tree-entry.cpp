@@ -36,12 +36,9 @@ Node::Node()
 
 Node::~Node()
 {
-  // erase the Name Tree Nodes that were created to
-  // resolve hash collisions
-  // So before erasing a single node, make sure its m_next == 0
-  // See eraseEntryIfEmpty in name-tree.cpp
-  if (m_next != 0)
-    delete m_next;
+  // Nodes are allocated from the NameTree's pool, which also releases
+  // the Nodes chained to resolve hash collisions
+  // See NameTree::~NameTree and eraseEntryIfEmpty in name-tree.cpp
 }
 
 Entry::Entry(const Name& name)
@@ -50,6 +47,12 @@ Entry::Entry(const Name& name)
 {
 }
 
+Entry::Entry(const Prefix& prefix)
+  : m_hash(0)
+  , m_prefix(prefix)
+{
+}
+
 Entry::~Entry()
 {
 }
@@ -61,7 +64,8 @@ Entry::isEmpty() const
          !static_cast<bool>(m_fibEntry) &&
          m_pitEntries.empty() &&
          !static_cast<bool>(m_measurementsEntry) &&
-         !static_cast<bool>(m_strategyChoiceEntry);
+         !static_cast<bool>(m_strategyChoiceEntry) &&
+         !static_cast<bool>(m_subscriptionEntry);
 }
 
 void
@@ -137,5 +141,21 @@ Entry::setStrategyChoiceEntry(shared_ptr<strategy_choice::Entry> strategyChoiceE
   }
 }
 
+void
+Entry::setSubscriptionEntry(shared_ptr<subscription::Entry> subscriptionEntry)
+{
+  if (static_cast<bool>(subscriptionEntry)) {
+    BOOST_ASSERT(!static_cast<bool>(subscriptionEntry->m_nameTreeEntry));
+  }
+
+  if (static_cast<bool>(m_subscriptionEntry)) {
+    m_subscriptionEntry->m_nameTreeEntry.reset();
+  }
+  m_subscriptionEntry = subscriptionEntry;
+  if (static_cast<bool>(m_subscriptionEntry)) {
+    m_subscriptionEntry->m_nameTreeEntry = this->shared_from_this();
+  }
+}
+
 } // namespace name_tree
 } // namespace nfd
@@ -27,10 +27,12 @@
 #define NFD_DAEMON_TABLE_NAME_TREE_ENTRY_HPP
 
 #include "common.hpp"
+#include "table/name-tree-prefix.hpp"
 #include "table/fib-entry.hpp"
 #include "table/pit-entry.hpp"
 #include "table/measurements-entry.hpp"
 #include "table/strategy-choice-entry.hpp"
+#include "table/subscription-entry.hpp"
 
 namespace nfd {
 
@@ -68,9 +70,17 @@ public:
   explicit
   Entry(const Name& prefix);
 
+  /** \brief construct an entry whose prefix shares storage with \p prefix
+   */
+  explicit
+  Entry(const Prefix& prefix);
+
   ~Entry();
 
-  const Name&
+  /** \return the name prefix of this entry
+   *  \note the Name is reassembled from the shared prefix storage on every call
+   */
+  Name
   getPrefix() const;
 
   void
@@ -125,18 +135,25 @@ public: // attached table entries
   shared_ptr<strategy_choice::Entry>
   getStrategyChoiceEntry() const;
 
+  void
+  setSubscriptionEntry(shared_ptr<subscription::Entry> subscriptionEntry);
+
+  shared_ptr<subscription::Entry>
+  getSubscriptionEntry() const;
+
 private:
   // Benefits of storing m_hash
   // 1. m_hash is compared before m_prefix is compared
   // 2. fast hash table resize support
   size_t m_hash;
-  Name m_prefix;
+  Prefix m_prefix; // shares the storage of the parent's prefix
   shared_ptr<Entry> m_parent;     // Pointing to the parent entry.
   std::vector<shared_ptr<Entry> > m_children; // Children pointers.
   shared_ptr<fib::Entry> m_fibEntry;
   std::vector<shared_ptr<pit::Entry> > m_pitEntries;
   shared_ptr<measurements::Entry> m_measurementsEntry;
   shared_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
+  shared_ptr<subscription::Entry> m_subscriptionEntry;
 
   // get the Name Tree Node that is associated with this Name Tree Entry
   Node* m_node;
@@ -145,10 +162,10 @@ private:
   friend class nfd::NameTree;
 };
 
-inline const Name&
+inline Name
 Entry::getPrefix() const
 {
-  return m_prefix;
+  return m_prefix.toName();
 }
 
 inline size_t
@@ -217,6 +234,12 @@ Entry::getStrategyChoiceEntry() const
   return m_strategyChoiceEntry;
 }
 
+inline shared_ptr<subscription::Entry>
+Entry::getSubscriptionEntry() const
+{
+  return m_subscriptionEntry;
+}
+
 } // namespace name_tree
 } // namespace nfd
 
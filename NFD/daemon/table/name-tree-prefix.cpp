@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "name-tree-prefix.hpp"
+
+namespace nfd {
+namespace name_tree {
+
+Prefix::Prefix()
+{
+}
+
+Prefix::Prefix(const Name& name)
+{
+  for (const name::Component& component : name) {
+    *this = this->append(component);
+  }
+}
+
+Prefix::Prefix(shared_ptr<const Node> node)
+  : m_node(std::move(node))
+{
+}
+
+Prefix
+Prefix::append(const name::Component& component) const
+{
+  shared_ptr<Node> node = make_shared<Node>();
+  node->parent = m_node;
+  node->component = name::Component(Block(component.wire(), component.size()));
+  node->size = this->size() + 1;
+  return Prefix(node);
+}
+
+bool
+Prefix::equals(const Name& name, size_t prefixLen) const
+{
+  BOOST_ASSERT(prefixLen <= name.size());
+
+  if (this->size() != prefixLen) {
+    return false;
+  }
+
+  // compare from the last component, where names with a common ancestor differ
+  const Node* node = m_node.get();
+  for (size_t i = prefixLen; i > 0; --i, node = node->parent.get()) {
+    if (node->component != name.get(i - 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Name
+Prefix::toName() const
+{
+  std::vector<const name::Component*> components(this->size());
+  const Node* node = m_node.get();
+  for (size_t i = components.size(); i > 0; --i, node = node->parent.get()) {
+    components[i - 1] = &node->component;
+  }
+
+  Name name;
+  for (const name::Component* component : components) {
+    name.append(*component);
+  }
+  return name;
+}
+
+} // namespace name_tree
+} // namespace nfd
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_NAME_TREE_PREFIX_HPP
+#define NFD_DAEMON_TABLE_NAME_TREE_PREFIX_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+namespace name_tree {
+
+/**
+ * \brief immutable reference-counted name prefix
+ *
+ * A Prefix of n components holds its last component and a reference to the Prefix
+ * of its first n-1 components, so that a Name Tree Entry and all its descendants share
+ * the storage of their common components instead of each keeping a full Name.
+ */
+class Prefix
+{
+public:
+  /** \brief construct an empty prefix, i.e., ndn:/
+   */
+  Prefix();
+
+  /** \brief construct a prefix that does not share storage with other prefixes
+   */
+  explicit
+  Prefix(const Name& name);
+
+  /** \return prefix of size() + 1 components, sharing the storage of this prefix
+   *  \note the component is copied into its own buffer, so that the new prefix does not
+   *        keep alive the packet the component was taken from
+   */
+  Prefix
+  append(const name::Component& component) const;
+
+  size_t
+  size() const;
+
+  bool
+  empty() const;
+
+  /** \return the last component
+   *  \pre !empty()
+   */
+  const name::Component&
+  back() const;
+
+  /** \return whether this prefix equals the first \p prefixLen components of \p name
+   *  \pre prefixLen <= name.size()
+   */
+  bool
+  equals(const Name& name, size_t prefixLen) const;
+
+  bool
+  equals(const Name& name) const;
+
+  /** \return the prefix as a Name
+   *  \note this makes a copy; it should not be used on the forwarding hot path
+   */
+  Name
+  toName() const;
+
+private:
+  struct Node
+  {
+    shared_ptr<const Node> parent;
+    name::Component component;
+    size_t size;
+  };
+
+  explicit
+  Prefix(shared_ptr<const Node> node);
+
+private:
+  shared_ptr<const Node> m_node; // nullptr for ndn:/
+};
+
+inline size_t
+Prefix::size() const
+{
+  return m_node == nullptr ? 0 : m_node->size;
+}
+
+inline bool
+Prefix::empty() const
+{
+  return m_node == nullptr;
+}
+
+inline const name::Component&
+Prefix::back() const
+{
+  BOOST_ASSERT(m_node != nullptr);
+  return m_node->component;
+}
+
+inline bool
+Prefix::equals(const Name& name) const
+{
+  return this->size() == name.size() && this->equals(name, name.size());
+}
+
+} // namespace name_tree
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_NAME_TREE_PREFIX_HPP
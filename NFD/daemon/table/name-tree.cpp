@@ -115,12 +115,14 @@ computeHashSet(const Name& prefix)
 
 NameTree::NameTree(size_t nBuckets)
   : m_nItems(0)
+  , m_nNameBytes(0)
   , m_nBuckets(nBuckets)
   , m_minNBuckets(nBuckets)
   , m_enlargeLoadFactor(0.5)       // more than 50% buckets loaded
   , m_enlargeFactor(2)       // double the hash table size
   , m_shrinkLoadFactor(0.1) // less than 10% buckets loaded
   , m_shrinkFactor(0.5)     // reduce the number of buckets by half
+  , m_pool(make_shared<SlabPool>())
   , m_endIterator(FULL_ENUMERATE_TYPE, *this, m_end)
 {
   m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
@@ -140,24 +142,42 @@ NameTree::~NameTree()
 {
   for (size_t i = 0; i < m_nBuckets; i++)
     {
-      if (m_buckets[i] != 0) {
-        delete m_buckets[i];
-      }
+      name_tree::Node* node = m_buckets[i];
+      while (node != 0)
+        {
+          name_tree::Node* next = node->m_next;
+          deallocateNode(node);
+          node = next;
+        }
     }
 
   delete [] m_buckets;
 }
 
+name_tree::Node*
+NameTree::allocateNode()
+{
+  return new (m_pool->allocate(sizeof(name_tree::Node))) name_tree::Node();
+}
+
+void
+NameTree::deallocateNode(name_tree::Node* node)
+{
+  node->~Node();
+  m_pool->deallocate(node, sizeof(name_tree::Node));
+}
+
 // insert() is a private function, and called by only lookup()
 std::pair<shared_ptr<name_tree::Entry>, bool>
-NameTree::insert(const Name& prefix)
+NameTree::insert(const Name& prefix, size_t prefixLen, size_t hashValue,
+                 const shared_ptr<name_tree::Entry>& parent)
 {
-  NFD_LOG_TRACE("insert " << prefix);
+  BOOST_ASSERT((prefixLen == 0) == !static_cast<bool>(parent));
 
-  size_t hashValue = name_tree::computeHash(prefix);
   size_t loc = hashValue % m_nBuckets;
 
-  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue << "  location = " << loc);
+  NFD_LOG_TRACE("insert " << prefix << " length = " << prefixLen <<
+                " hash value = " << hashValue << "  location = " << loc);
 
   // Check if this Name has been stored
   name_tree::Node* node = m_buckets[loc];
@@ -167,7 +187,12 @@ NameTree::insert(const Name& prefix)
     {
       if (static_cast<bool>(node->m_entry))
         {
-          if (prefix == node->m_entry->m_prefix)
+          // the parent has already been matched, so only the last component is compared
+          const name_tree::Entry& entry = *node->m_entry;
+          if (hashValue == entry.m_hash &&
+              entry.m_parent == parent &&
+              entry.m_prefix.size() == prefixLen &&
+              (prefixLen == 0 || entry.m_prefix.back() == prefix.get(prefixLen - 1)))
             {
               return std::make_pair(node->m_entry, false); // false: old entry
             }
@@ -175,11 +200,12 @@ NameTree::insert(const Name& prefix)
       nodePrev = node;
     }
 
-  NFD_LOG_TRACE("Did not find " << prefix << ", need to insert it to the table");
+  NFD_LOG_TRACE("Did not find " << prefix << " length = " << prefixLen <<
+                ", need to insert it to the table");
 
   // If no bucket is empty occupied, we need to create a new node, and it is
   // linked from nodePrev
-  node = new name_tree::Node();
+  node = allocateNode();
   node->m_prev = nodePrev;
 
   if (nodePrev == 0)
@@ -191,8 +217,12 @@ NameTree::insert(const Name& prefix)
       nodePrev->m_next = node;
     }
 
-  // Create a new Entry
-  shared_ptr<name_tree::Entry> entry(make_shared<name_tree::Entry>(prefix));
+  // Create a new Entry, sharing the prefix storage of the parent
+  name_tree::Prefix entryPrefix;
+  if (prefixLen > 0)
+    entryPrefix = parent->m_prefix.append(prefix.get(prefixLen - 1));
+  shared_ptr<name_tree::Entry> entry(std::allocate_shared<name_tree::Entry>(
+                                        getAllocator<name_tree::Entry>(), entryPrefix));
   entry->setHash(hashValue);
   node->m_entry = entry; // link the Entry to its Node
   entry->m_node = node; // link the node to Entry. Used in eraseEntryIfEmpty.
@@ -208,18 +238,20 @@ NameTree::lookup(const Name& prefix)
 
   shared_ptr<name_tree::Entry> entry;
   shared_ptr<name_tree::Entry> parent;
+  std::vector<size_t> hashValueSet = name_tree::computeHashSet(prefix);
 
   for (size_t i = 0; i <= prefix.size(); i++)
     {
-      Name temp = prefix.getPrefix(i);
-
       // insert() will create the entry if it does not exist.
-      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(temp);
+      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(prefix, i, hashValueSet[i],
+                                                                 parent);
       entry = ret.first;
 
       if (ret.second == true)
         {
           m_nItems++; // Increase the counter
+          if (i > 0)
+            m_nNameBytes += prefix.get(i - 1).size();
           entry->m_parent = parent;
 
           if (static_cast<bool>(parent))
@@ -258,7 +290,7 @@ NameTree::findExactMatch(const Name& prefix) const
       entry = node->m_entry;
       if (static_cast<bool>(entry))
         {
-          if (hashValue == entry->getHash() && prefix == entry->getPrefix())
+          if (hashValue == entry->getHash() && entry->m_prefix.equals(prefix))
             {
               return entry;
             }
@@ -293,9 +325,9 @@ NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::EntrySelec
           entry = node->m_entry;
           if (static_cast<bool>(entry))
             {
-              // isPrefixOf() is used to avoid making a copy of the name
+              // equals() compares in place to avoid making a copy of the name
               if (hashValue == entry->getHash() &&
-                  entry->getPrefix().isPrefixOf(prefix) &&
+                  entry->m_prefix.equals(prefix, i) &&
                   entrySelector(*entry))
                 {
                   return entry;
@@ -382,7 +414,9 @@ NameTree::eraseEntryIfEmpty(shared_ptr<name_tree::Entry> entry)
       BOOST_ASSERT(node->m_next == 0);
 
       m_nItems--;
-      delete node;
+      if (!entry->m_prefix.empty())
+        m_nNameBytes -= entry->m_prefix.back().size();
+      deallocateNode(node);
 
       if (static_cast<bool>(parent))
         eraseEntryIfEmpty(parent);
@@ -550,12 +584,12 @@ NameTree::dump(std::ostream& output) const
           // if the Entry exist, dump its information
           if (static_cast<bool>(entry))
             {
-              output << "Bucket" << i << "\t" << entry->m_prefix.toUri() << endl;
+              output << "Bucket" << i << "\t" << entry->getPrefix().toUri() << endl;
               output << "\t\tHash " << entry->m_hash << endl;
 
               if (static_cast<bool>(entry->m_parent))
                 {
-                  output << "\t\tparent->" << entry->m_parent->m_prefix.toUri();
+                  output << "\t\tparent->" << entry->m_parent->getPrefix().toUri();
                 }
               else
                 {
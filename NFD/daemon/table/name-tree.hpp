@@ -27,6 +27,7 @@
 #define NFD_DAEMON_TABLE_NAME_TREE_HPP
 
 #include "common.hpp"
+#include "core/slab-pool.hpp"
 #include "name-tree-entry.hpp"
 
 namespace nfd {
@@ -93,6 +94,15 @@ public: // information
   size_t
   size() const;
 
+  /**
+   * \brief Get the total length of the names of the Name Tree Entries
+   * \details An entry shares the components of its parent's prefix and stores only
+   * its last component, so this is the sum of the TLV sizes of the last components
+   * of all entries.
+   */
+  size_t
+  getNNameBytes() const;
+
   /**
    * \brief Get the number of buckets in the Name Tree (NPHT)
    * \details The number of buckets is the one that used to create the hash
@@ -101,6 +111,22 @@ public: // information
   size_t
   getNBuckets() const;
 
+  /**
+   * \brief Get the pool from which Name Tree Entries and Nodes are allocated
+   * \details The pool is shared with the tables attached to this Name Tree,
+   * which allocate their entries with getAllocator().
+   */
+  const SlabPool&
+  getPool() const;
+
+  /**
+   * \brief Get an allocator for entries of the tables attached to this Name Tree,
+   * to be used with allocate_shared.
+   */
+  template<typename T>
+  SlabAllocator<T>
+  getAllocator() const;
+
   /**
    * \brief Dump all the information stored in the Name Tree for debugging.
    */
@@ -149,6 +175,10 @@ public: // shortcut access
   shared_ptr<name_tree::Entry>
   get(const strategy_choice::Entry& strategyChoiceEntry) const;
 
+  /// get NameTree entry from attached SubscriptionTable entry
+  shared_ptr<name_tree::Entry>
+  get(const subscription::Entry& subscriptionEntry) const;
+
 public: // matching
   /**
    * \brief Exact match lookup for the given name prefix.
@@ -302,8 +332,15 @@ private:
   void
   resize(size_t newNBuckets);
 
+  name_tree::Node*
+  allocateNode();
+
+  void
+  deallocateNode(name_tree::Node* node);
+
 private:
   size_t                        m_nItems;  // Number of items being stored
+  size_t                        m_nNameBytes; // Total length of last components of the items
   size_t                        m_nBuckets; // Number of hash buckets
   size_t                        m_minNBuckets; // Minimum number of hash buckets
   double                        m_enlargeLoadFactor;
@@ -313,6 +350,7 @@ private:
   size_t                        m_shrinkThreshold;
   double                        m_shrinkFactor;
   name_tree::Node**             m_buckets; // Name Tree Buckets in the NPHT
+  shared_ptr<SlabPool>          m_pool; // Entries, Nodes and attached table entries
   shared_ptr<name_tree::Entry>  m_end;
   const_iterator                m_endIterator;
 
@@ -320,12 +358,18 @@ private:
    * \brief Create a Name Tree Entry if it does not exist, or return the existing
    * Name Tree Entry address.
    * \details Called by lookup() only.
+   * \param prefix The name of which the first \p prefixLen components are inserted.
+   * \param prefixLen The number of components of the inserted prefix.
+   * \param hashValue The hash of the inserted prefix.
+   * \param parent The entry of the first \p prefixLen - 1 components, or nullptr if
+   * \p prefixLen is 0. A new entry shares the prefix storage of its parent.
    * \return The first item is the Name Tree Entry address, the second item is
    * a bool value indicates whether this is an old entry (false) or a new
    * entry (true).
    */
   std::pair<shared_ptr<name_tree::Entry>, bool>
-  insert(const Name& prefix);
+  insert(const Name& prefix, size_t prefixLen, size_t hashValue,
+         const shared_ptr<name_tree::Entry>& parent);
 };
 
 inline NameTree::const_iterator::~const_iterator()
@@ -338,12 +382,31 @@ NameTree::size() const
   return m_nItems;
 }
 
+inline size_t
+NameTree::getNNameBytes() const
+{
+  return m_nNameBytes;
+}
+
 inline size_t
 NameTree::getNBuckets() const
 {
   return m_nBuckets;
 }
 
+inline const SlabPool&
+NameTree::getPool() const
+{
+  return *m_pool;
+}
+
+template<typename T>
+inline SlabAllocator<T>
+NameTree::getAllocator() const
+{
+  return SlabAllocator<T>(m_pool);
+}
+
 inline shared_ptr<name_tree::Entry>
 NameTree::get(const fib::Entry& fibEntry) const
 {
@@ -368,6 +431,12 @@ NameTree::get(const strategy_choice::Entry& strategyChoiceEntry) const
   return strategyChoiceEntry.m_nameTreeEntry;
 }
 
+inline shared_ptr<name_tree::Entry>
+NameTree::get(const subscription::Entry& subscriptionEntry) const
+{
+  return subscriptionEntry.m_nameTreeEntry;
+}
+
 inline NameTree::const_iterator
 NameTree::begin() const
 {
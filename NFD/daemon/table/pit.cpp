@@ -81,7 +81,8 @@ Pit::insert(const Interest& interest)
     return { *it, false };
   }
 
-  shared_ptr<pit::Entry> entry = make_shared<pit::Entry>(interest);
+  shared_ptr<pit::Entry> entry = std::allocate_shared<pit::Entry>(
+                                   m_nameTree.getAllocator<pit::Entry>(), interest);
   nameTreeEntry->insertPitEntry(entry);
   m_nItems++;
   return { entry, true };
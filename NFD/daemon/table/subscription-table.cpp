@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "subscription-table.hpp"
+
+namespace nfd {
+
+using subscription::Entry;
+
+SubscriptionTable::SubscriptionTable(NameTree& nameTree)
+  : m_nameTree(nameTree)
+  , m_lease(getDefaultLease())
+  , m_nItems(0)
+{
+}
+
+shared_ptr<Entry>
+SubscriptionTable::get(const Name& name)
+{
+  shared_ptr<name_tree::Entry> nte = m_nameTree.lookup(name);
+  shared_ptr<Entry> entry = nte->getSubscriptionEntry();
+  if (entry != nullptr)
+    return entry;
+
+  entry = make_shared<Entry>(name);
+  nte->setSubscriptionEntry(entry);
+  ++m_nItems;
+  return entry;
+}
+
+shared_ptr<Entry>
+SubscriptionTable::findExactMatch(const Name& name) const
+{
+  // publications reach routers without subscriptions, so NameTree entries are not created here
+  shared_ptr<name_tree::Entry> nte = m_nameTree.findExactMatch(name);
+  if (nte != nullptr)
+    return nte->getSubscriptionEntry();
+  return nullptr;
+}
+
+shared_ptr<Entry>
+SubscriptionTable::subscribeDownstream(const Name& name, Face& face)
+{
+  shared_ptr<Entry> entry = this->get(name);
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  time::steady_clock::TimePoint expiry = now + m_lease;
+
+  bool isFound = false;
+  for (auto it = entry->m_downstreams.begin(); it != entry->m_downstreams.end();) {
+    if (it->face.get() == &face) {
+      it->expiry = expiry;
+      isFound = true;
+    }
+    else if (it->expiry <= now) {
+      *it = entry->m_downstreams.back();
+      entry->m_downstreams.pop_back();
+      continue;
+    }
+    ++it;
+  }
+  if (!isFound) {
+    entry->m_downstreams.push_back({face.shared_from_this(), expiry});
+  }
+
+  this->extendLifetime(*entry, expiry);
+  return entry;
+}
+
+void
+SubscriptionTable::subscribeUpstream(const Name& name)
+{
+  shared_ptr<Entry> entry = this->get(name);
+  entry->m_upstreamExpiry = time::steady_clock::now() + m_lease;
+  this->extendLifetime(*entry, entry->m_upstreamExpiry);
+}
+
+void
+SubscriptionTable::unsubscribeUpstream(const Name& name)
+{
+  shared_ptr<Entry> entry = this->findExactMatch(name);
+  if (entry != nullptr)
+    entry->m_upstreamExpiry = time::steady_clock::TimePoint::min();
+}
+
+std::vector<shared_ptr<Face>>
+SubscriptionTable::getDownstreamFaces(const Name& name) const
+{
+  std::vector<shared_ptr<Face>> faces;
+  shared_ptr<Entry> entry = this->findExactMatch(name);
+  if (entry == nullptr)
+    return faces;
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  for (const subscription::DownstreamRecord& downstream : entry->getDownstreams()) {
+    if (downstream.expiry > now)
+      faces.push_back(downstream.face);
+  }
+  return faces;
+}
+
+void
+SubscriptionTable::extendLifetime(Entry& entry, const time::steady_clock::TimePoint& expiry)
+{
+  if (entry.m_expiry >= expiry) {
+    // has longer lifetime, not extending
+    return;
+  }
+
+  scheduler::cancel(entry.m_cleanup);
+  entry.m_expiry = expiry;
+  entry.m_cleanup = scheduler::schedule(expiry - time::steady_clock::now(),
+                                        bind(&SubscriptionTable::cleanup, this, ref(entry)));
+}
+
+void
+SubscriptionTable::cleanup(Entry& entry)
+{
+  // all leases end no later than m_expiry
+  shared_ptr<name_tree::Entry> nte = m_nameTree.get(entry);
+  if (nte != nullptr) {
+    nte->setSubscriptionEntry(nullptr);
+    m_nameTree.eraseEntryIfEmpty(nte);
+    m_nItems--;
+  }
+}
+
+} // namespace nfd
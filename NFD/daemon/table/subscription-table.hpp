@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_SUBSCRIPTION_TABLE_HPP
+#define NFD_DAEMON_TABLE_SUBSCRIPTION_TABLE_HPP
+
+#include "subscription-entry.hpp"
+#include "name-tree.hpp"
+
+namespace nfd {
+
+/** \brief represents the subscription table of validated names
+ *
+ *  Routers record downstream subscribers of a name, so that validation Interests for a name
+ *  this forwarder is already subscribed to upstream can be absorbed locally, and publications
+ *  of the name are delivered to local subscribers that are not on the path stored by the
+ *  producer.  An entry is erased when all its leases expire.
+ */
+class SubscriptionTable : noncopyable
+{
+public:
+  explicit
+  SubscriptionTable(NameTree& nameTree);
+
+  /** \brief perform an exact match
+   */
+  shared_ptr<subscription::Entry>
+  findExactMatch(const Name& name) const;
+
+  /** \brief find or insert an entry for \p name, and add or renew the lease of \p face
+   */
+  shared_ptr<subscription::Entry>
+  subscribeDownstream(const Name& name, Face& face);
+
+  /** \brief find or insert an entry for \p name, and renew the upstream lease
+   */
+  void
+  subscribeUpstream(const Name& name);
+
+  /** \brief cancel the upstream lease of \p name, if any
+   */
+  void
+  unsubscribeUpstream(const Name& name);
+
+  /** \brief get downstream faces of \p name with unexpired leases
+   */
+  std::vector<shared_ptr<Face>>
+  getDownstreamFaces(const Name& name) const;
+
+  static time::nanoseconds
+  getDefaultLease();
+
+  const time::nanoseconds&
+  getLease() const;
+
+  void
+  setLease(const time::nanoseconds& lease);
+
+  size_t
+  size() const;
+
+private:
+  shared_ptr<subscription::Entry>
+  get(const Name& name);
+
+  /** \brief keep the entry until at least \p expiry
+   */
+  void
+  extendLifetime(subscription::Entry& entry, const time::steady_clock::TimePoint& expiry);
+
+  void
+  cleanup(subscription::Entry& entry);
+
+private:
+  NameTree& m_nameTree;
+  time::nanoseconds m_lease;
+  size_t m_nItems;
+};
+
+inline time::nanoseconds
+SubscriptionTable::getDefaultLease()
+{
+  return time::seconds(30);
+}
+
+inline const time::nanoseconds&
+SubscriptionTable::getLease() const
+{
+  return m_lease;
+}
+
+inline void
+SubscriptionTable::setLease(const time::nanoseconds& lease)
+{
+  m_lease = lease;
+}
+
+inline size_t
+SubscriptionTable::size() const
+{
+  return m_nItems;
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_SUBSCRIPTION_TABLE_HPP
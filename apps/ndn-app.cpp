@@ -115,6 +115,16 @@ App::OnData(shared_ptr<const Data> data)
   m_receivedDatas(data, this, m_face);
 }
 
+void
+App::SaveState(std::ostream& os) const
+{
+}
+
+void
+App::RestoreState(std::istream& is)
+{
+}
+
 // Application Methods
 void
 App::StartApplication() // Called at time specified by Start
@@ -28,6 +28,8 @@
 #include "ns3/callback.h"
 #include "ns3/traced-callback.h"
 
+#include <iosfwd>
+
 namespace ns3 {
 
 class Packet;
@@ -80,6 +82,23 @@ public:
   virtual void
   OnData(shared_ptr<const Data> data);
 
+  /**
+   * @brief Save state of the application that should survive between runs (e.g., warm state)
+   * @see SnapshotHelper
+   *
+   * Default implementation saves nothing
+   */
+  virtual void
+  SaveState(std::ostream& os) const;
+
+  /**
+   * @brief Restore state saved by SaveState
+   * @throw std::runtime_error if the state cannot be read
+   * @see SnapshotHelper
+   */
+  virtual void
+  RestoreState(std::istream& is);
+
 public:
   typedef void (*InterestTraceCallback)(shared_ptr<const Interest>, Ptr<App>, shared_ptr<Face>);
   typedef void (*DataTraceCallback)(shared_ptr<const Data>, Ptr<App>, shared_ptr<Face>);
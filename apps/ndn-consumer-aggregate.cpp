@@ -0,0 +1,361 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-aggregate.hpp"
+#include "ns3/ptr.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+
+#include "model/ndn-app-face.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerAggregate");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerAggregate);
+
+/**
+ * @brief Get cumulative Zipf-Mandelbrot probabilities, shared by all users of the same parameters
+ */
+static shared_ptr<const std::vector<double>>
+getZipfMandelbrotTable(uint32_t n, double q, double s)
+{
+  static std::map<std::tuple<uint32_t, double, double>, std::weak_ptr<const std::vector<double>>>
+    tables;
+
+  std::weak_ptr<const std::vector<double>>& cached = tables[std::make_tuple(n, q, s)];
+  shared_ptr<const std::vector<double>> table = cached.lock();
+  if (table != nullptr)
+    return table;
+
+  auto pcum = make_shared<std::vector<double>>(n + 1);
+  (*pcum)[0] = 0.0;
+  for (uint32_t i = 1; i <= n; i++) {
+    (*pcum)[i] = (*pcum)[i - 1] + 1.0 / std::pow(i + q, s);
+  }
+  for (uint32_t i = 1; i <= n; i++) {
+    (*pcum)[i] = (*pcum)[i] / (*pcum)[n];
+  }
+
+  cached = pcum;
+  return pcum;
+}
+
+TypeId
+ConsumerAggregate::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerAggregate")
+      .SetGroupName("Ndn")
+      .SetParent<App>()
+      .AddConstructor<ConsumerAggregate>()
+
+      .AddAttribute("Prefix", "Name of the Interest", StringValue("/"),
+                    MakeNameAccessor(&ConsumerAggregate::m_interestName), MakeNameChecker())
+      .AddAttribute("LifeTime", "LifeTime for interest packet", StringValue("2s"),
+                    MakeTimeAccessor(&ConsumerAggregate::m_interestLifeTime), MakeTimeChecker())
+      .AddAttribute("ValidationFlag", "Validation flag of the Interests", UintegerValue(0),
+                    MakeUintegerAccessor(&ConsumerAggregate::m_validationFlag),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddAttribute("Users", "Number of users", UintegerValue(100),
+                    MakeUintegerAccessor(&ConsumerAggregate::m_nUsers),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("Frequency", "Frequency of interest packets of one user", StringValue("1.0"),
+                    MakeDoubleAccessor(&ConsumerAggregate::m_frequency),
+                    MakeDoubleChecker<double>())
+      .AddAttribute("ExpiryGranularity",
+                    "Timeouts of requests are checked at multiples of this interval",
+                    StringValue("50ms"),
+                    MakeTimeAccessor(&ConsumerAggregate::m_expiryGranularity),
+                    MakeTimeChecker())
+
+      .AddAttribute("NumberOfContents", "Number of the Contents in total", StringValue("100"),
+                    MakeUintegerAccessor(&ConsumerAggregate::SetNumberOfContents,
+                                         &ConsumerAggregate::GetNumberOfContents),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("q", "parameter of improve rank", StringValue("0.7"),
+                    MakeDoubleAccessor(&ConsumerAggregate::SetQ, &ConsumerAggregate::GetQ),
+                    MakeDoubleChecker<double>())
+      .AddAttribute("s", "parameter of power", StringValue("0.7"),
+                    MakeDoubleAccessor(&ConsumerAggregate::SetS, &ConsumerAggregate::GetS),
+                    MakeDoubleChecker<double>())
+
+      .AddTraceSource("UserDataDelay", "Delay between request of a user and received Data",
+                      MakeTraceSourceAccessor(&ConsumerAggregate::m_userDataDelay),
+                      "ns3::ndn::ConsumerAggregate::UserDataDelayCallback");
+
+  return tid;
+}
+
+ConsumerAggregate::ConsumerAggregate()
+  : m_validationFlag(0)
+  , m_nUsers(100)
+  , m_frequency(1.0)
+  , m_N(100)
+  , m_q(0.7)
+  , m_s(0.7)
+  , m_rand(CreateObject<UniformRandomVariable>())
+  , m_interArrival(CreateObject<ExponentialRandomVariable>())
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+ConsumerAggregate::SetNumberOfContents(uint32_t numOfContents)
+{
+  m_N = numOfContents;
+  m_Pcum.reset(); // will be created on first request
+}
+
+uint32_t
+ConsumerAggregate::GetNumberOfContents() const
+{
+  return m_N;
+}
+
+void
+ConsumerAggregate::SetQ(double q)
+{
+  m_q = q;
+  m_Pcum.reset();
+}
+
+double
+ConsumerAggregate::GetQ() const
+{
+  return m_q;
+}
+
+void
+ConsumerAggregate::SetS(double s)
+{
+  m_s = s;
+  m_Pcum.reset();
+}
+
+double
+ConsumerAggregate::GetS() const
+{
+  return m_s;
+}
+
+uint32_t
+ConsumerAggregate::GetSentInterests(uint32_t user) const
+{
+  return user < m_sentInterests.size() ? m_sentInterests[user] : 0;
+}
+
+uint32_t
+ConsumerAggregate::GetSatisfiedInterests(uint32_t user) const
+{
+  return user < m_satisfiedInterests.size() ? m_satisfiedInterests[user] : 0;
+}
+
+uint32_t
+ConsumerAggregate::GetTimedOutInterests(uint32_t user) const
+{
+  return user < m_timedOutInterests.size() ? m_timedOutInterests[user] : 0;
+}
+
+Time
+ConsumerAggregate::GetTotalDelay(uint32_t user) const
+{
+  return user < m_totalDelay.size() ? m_totalDelay[user] : Time();
+}
+
+void
+ConsumerAggregate::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  App::StartApplication();
+
+  ScheduleNextPacket();
+}
+
+void
+ConsumerAggregate::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  Simulator::Cancel(m_sendEvent);
+  Simulator::Cancel(m_expiryEvent);
+
+  App::StopApplication();
+}
+
+void
+ConsumerAggregate::ScheduleNextPacket()
+{
+  if (m_nUsers == 0 || m_frequency <= 0)
+    return;
+
+  // superposition of independent Poisson processes is a Poisson process with the sum of rates
+  double mean = 1.0 / (m_nUsers * m_frequency);
+  m_sendEvent = Simulator::Schedule(Seconds(m_interArrival->GetValue(mean, 0)),
+                                    &ConsumerAggregate::SendPacket, this);
+}
+
+uint32_t
+ConsumerAggregate::GetNextSeq()
+{
+  if (m_Pcum == nullptr)
+    m_Pcum = getZipfMandelbrotTable(m_N, m_q, m_s);
+
+  double p_random = m_rand->GetValue();
+  while (p_random == 0) {
+    p_random = m_rand->GetValue();
+  }
+
+  // content index in [1, m_N]
+  auto found = std::lower_bound(m_Pcum->begin() + 1, m_Pcum->end(), p_random);
+  return std::min<uint32_t>(found - m_Pcum->begin(), m_N);
+}
+
+void
+ConsumerAggregate::SendPacket()
+{
+  if (!m_active)
+    return;
+
+  if (m_sentInterests.size() < m_nUsers) {
+    m_sentInterests.resize(m_nUsers);
+    m_satisfiedInterests.resize(m_nUsers);
+    m_timedOutInterests.resize(m_nUsers);
+    m_totalDelay.resize(m_nUsers);
+  }
+
+  uint32_t user = m_rand->GetInteger(0, m_nUsers - 1);
+  uint32_t seq = GetNextSeq();
+
+  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
+  nameWithSequence->appendSequenceNumber(seq);
+
+  shared_ptr<Interest> interest = make_shared<Interest>();
+  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+  interest->setName(*nameWithSequence);
+  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
+  interest->setInterestLifetime(interestLifeTime);
+  interest->setPITList("");
+  interest->setValidationFlag(m_validationFlag);
+  interest->setLocationRegistration(0);
+
+  NS_LOG_INFO("> Interest for " << seq << " from user " << user);
+
+  // recorded before sending, as Data can be returned from the local cache immediately
+  Request request = {user, Simulator::Now()};
+  m_pending[seq].push_back(request);
+  m_expiry.push_back(Expiry{seq, request});
+  m_sentInterests[user]++;
+  ScheduleExpiryCheck();
+
+  m_transmittedInterests(interest, this, m_face);
+  m_face->onReceiveInterest(*interest);
+
+  ScheduleNextPacket();
+}
+
+void
+ConsumerAggregate::OnData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  App::OnData(data); // tracing inside
+
+  uint32_t seq = data->getName().at(-1).toSequenceNumber();
+  NS_LOG_INFO("< DATA for " << seq);
+
+  auto pending = m_pending.find(seq);
+  if (pending == m_pending.end())
+    return;
+
+  Time now = Simulator::Now();
+  for (const Request& request : pending->second) {
+    Time delay = now - request.time;
+    m_satisfiedInterests[request.user]++;
+    m_totalDelay[request.user] += delay;
+    m_userDataDelay(this, request.user, seq, delay);
+  }
+
+  // records in m_expiry are dropped when they expire
+  m_pending.erase(pending);
+}
+
+void
+ConsumerAggregate::ScheduleExpiryCheck()
+{
+  if (m_expiryEvent.IsRunning() || m_expiry.empty())
+    return;
+
+  // all requests have the same lifetime, so the front request always expires first
+  Time delay = std::max(m_expiry.front().request.time + m_interestLifeTime - Simulator::Now(),
+                        Seconds(0));
+  if (m_expiryGranularity.IsStrictlyPositive()) {
+    int64_t step = m_expiryGranularity.GetTimeStep();
+    delay = TimeStep((delay.GetTimeStep() + step - 1) / step * step);
+  }
+
+  m_expiryEvent = Simulator::Schedule(delay, &ConsumerAggregate::CheckExpiry, this);
+}
+
+void
+ConsumerAggregate::CheckExpiry()
+{
+  Time deadline = Simulator::Now() - m_interestLifeTime;
+
+  while (!m_expiry.empty() && m_expiry.front().request.time <= deadline) {
+    const Expiry& expiry = m_expiry.front();
+
+    auto pending = m_pending.find(expiry.seq);
+    if (pending != m_pending.end()) {
+      std::vector<Request>& requests = pending->second;
+      for (auto request = requests.begin(); request != requests.end(); ++request) {
+        if (request->user == expiry.request.user && request->time == expiry.request.time) {
+          NS_LOG_DEBUG("Request of user " << request->user << " for " << expiry.seq
+                                          << " timed out");
+          m_timedOutInterests[request->user]++;
+          *request = requests.back();
+          requests.pop_back();
+          break;
+        }
+      }
+
+      if (requests.empty())
+        m_pending.erase(pending);
+    }
+
+    m_expiry.pop_front();
+  }
+
+  ScheduleExpiryCheck();
+}
+
+} // namespace ndn
+} // namespace ns3
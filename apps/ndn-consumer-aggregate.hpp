@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_AGGREGATE_H
+#define NDN_CONSUMER_AGGREGATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-app.hpp"
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/nstime.h"
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief NDN application that generates requests of a population of users
+ *
+ * Every one of the `Users` virtual users requests contents following Zipf-Mandelbrot
+ * distribution as a Poisson process with rate `Frequency`.  Instead of one event per user, the
+ * merged process (Poisson with rate `Users * Frequency`) is simulated and every request is
+ * attributed to a uniformly chosen user, so the cost of the application does not depend on the
+ * number of users.  The cumulative Zipf-Mandelbrot table is shared between all instances with
+ * the same parameters.
+ *
+ * Requests for the same content share the Data packet.  A user that does not receive Data
+ * within the Interest lifetime counts a timeout (requests are not retransmitted).  Per-user
+ * statistics are kept in flat arrays indexed by the user number.
+ */
+class ConsumerAggregate : public App {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerAggregate();
+
+  // From App
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+  /**
+   * @brief Number of requests made by @p user
+   */
+  uint32_t
+  GetSentInterests(uint32_t user) const;
+
+  /**
+   * @brief Number of requests of @p user that were satisfied
+   */
+  uint32_t
+  GetSatisfiedInterests(uint32_t user) const;
+
+  /**
+   * @brief Number of requests of @p user that timed out
+   */
+  uint32_t
+  GetTimedOutInterests(uint32_t user) const;
+
+  /**
+   * @brief Sum of delays between the request and the Data over satisfied requests of @p user
+   */
+  Time
+  GetTotalDelay(uint32_t user) const;
+
+public:
+  typedef void (*UserDataDelayCallback)(Ptr<App> app, uint32_t user, uint32_t seqno, Time delay);
+
+protected:
+  // from App
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+private:
+  void
+  SendPacket();
+
+  void
+  ScheduleNextPacket();
+
+  void
+  ScheduleExpiryCheck();
+
+  void
+  CheckExpiry();
+
+  uint32_t
+  GetNextSeq();
+
+  void
+  SetNumberOfContents(uint32_t numOfContents);
+
+  uint32_t
+  GetNumberOfContents() const;
+
+  void
+  SetQ(double q);
+
+  double
+  GetQ() const;
+
+  void
+  SetS(double s);
+
+  double
+  GetS() const;
+
+private:
+  Name m_interestName;     ///< @brief prefix of the requested names
+  Time m_interestLifeTime; ///< @brief lifetime of Interests
+  uint32_t m_validationFlag;
+
+  uint32_t m_nUsers;
+  double m_frequency; ///< @brief request rate of one user
+  Time m_expiryGranularity;
+
+  uint32_t m_N; ///< @brief number of the contents
+  double m_q;   ///< @brief q in (k+q)^s
+  double m_s;   ///< @brief s in (k+q)^s
+  shared_ptr<const std::vector<double>> m_Pcum; ///< @brief shared cumulative probability
+
+  Ptr<UniformRandomVariable> m_rand;
+  Ptr<ExponentialRandomVariable> m_interArrival;
+  EventId m_sendEvent;
+  EventId m_expiryEvent;
+
+  /// @cond include_hidden
+  struct Request {
+    uint32_t user;
+    Time time;
+  };
+
+  struct Expiry {
+    uint32_t seq;
+    Request request;
+  };
+
+  std::unordered_map<uint32_t, std::vector<Request>> m_pending; ///< @brief waiting users
+  std::deque<Expiry> m_expiry; ///< @brief requests in the order they were made
+
+  // per-user statistics
+  std::vector<uint32_t> m_sentInterests;
+  std::vector<uint32_t> m_satisfiedInterests;
+  std::vector<uint32_t> m_timedOutInterests;
+  std::vector<Time> m_totalDelay;
+
+  TracedCallback<Ptr<App> /* app */, uint32_t /* user */, uint32_t /* seqno */, Time /* delay */>
+    m_userDataDelay;
+  /// @endcond
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_AGGREGATE_H
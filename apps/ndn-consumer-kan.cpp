@@ -32,6 +32,7 @@
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "model/ndn-app-face.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
+#include "helper/ndn-snapshot-helper.hpp"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/ref.hpp>
@@ -59,7 +60,8 @@ ConsumerKan::GetTypeId(void)
                     MakeTimeAccessor(&ConsumerKan::m_interestLifeTime), MakeTimeChecker())
 
       .AddAttribute("RetxTimer",
-                    "Timeout defining how frequent retransmission timeouts should be checked",
+                    "Granularity of checking the retransmission timeouts (checks are scheduled "
+                    "only while there are outstanding Interests)",
                     StringValue("50ms"),
                     MakeTimeAccessor(&ConsumerKan::GetRetxTimer, &ConsumerKan::SetRetxTimer),
                     MakeTimeChecker())
@@ -92,12 +94,10 @@ ConsumerKan::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
   if (m_retxEvent.IsRunning()) {
-    // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
-    Simulator::Remove(m_retxEvent); // slower, but better for memory
+    // reschedule with the new granularity
+    Simulator::Remove(m_retxEvent);
+    ScheduleRetxCheck();
   }
-
-  // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &ConsumerKan::CheckRetxTimeout, this);
 }
 
 Time
@@ -106,6 +106,34 @@ ConsumerKan::GetRetxTimer() const
   return m_retxTimer;
 }
 
+void
+ConsumerKan::ScheduleRetxCheck()
+{
+  Time lastSent;
+  if (!m_seqTable.getEarliestSent(lastSent)) {
+    // nothing is outstanding, no need to check anything
+    if (m_retxEvent.IsRunning())
+      Simulator::Remove(m_retxEvent);
+    return;
+  }
+
+  Time delay = std::max(lastSent + m_rtt->RetransmitTimeout() - Simulator::Now(), Seconds(0));
+  if (m_retxTimer.IsStrictlyPositive()) {
+    // round up, so timeouts that are close to each other are handled by one check
+    int64_t step = m_retxTimer.GetTimeStep();
+    delay = TimeStep((delay.GetTimeStep() + step - 1) / step * step);
+  }
+
+  if (m_retxEvent.IsRunning()) {
+    if (Simulator::GetDelayLeft(m_retxEvent) <= delay)
+      return; // already armed early enough
+
+    Simulator::Remove(m_retxEvent);
+  }
+
+  m_retxEvent = Simulator::Schedule(delay, &ConsumerKan::CheckRetxTimeout, this);
+}
+
 void
 ConsumerKan::CheckRetxTimeout()
 {
@@ -114,20 +142,12 @@ ConsumerKan::CheckRetxTimeout()
   Time rto = m_rtt->RetransmitTimeout();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
-    {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
-      OnTimeout(seqNo);
-    }
-    else
-      break; // nothing else to do. All later packets need not be retransmitted
+  uint32_t seqNo;
+  while (m_seqTable.popExpired(now - rto, seqNo)) {
+    OnTimeout(seqNo);
   }
 
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &ConsumerKan::CheckRetxTimeout, this);
+  ScheduleRetxCheck();
 }
 
 // Application Methods
@@ -149,6 +169,7 @@ ConsumerKan::StopApplication() // Called at time specified by Stop
 
   // cancel periodic packet generation
   Simulator::Cancel(m_sendEvent);
+  Simulator::Cancel(m_retxEvent);
 
   // cleanup base stuff
   App::StopApplication();
@@ -164,11 +185,7 @@ ConsumerKan::SendPacket()
 
   uint32_t seq = std::numeric_limits<uint32_t>::max(); // invalid
 
-  while (m_retxSeqs.size()) {
-    seq = *m_retxSeqs.begin();
-    m_retxSeqs.erase(m_retxSeqs.begin());
-    break;
-  }
+  m_seqTable.popRetx(seq);
 
   if (seq == std::numeric_limits<uint32_t>::max()) {
     if (m_seqMax != std::numeric_limits<uint32_t>::max()) {
@@ -232,7 +249,7 @@ ConsumerKan::OnData(shared_ptr<const Data> data)
   NS_LOG_INFO("< DATA for " << seq);
 
   int hopCount = 0;
-  auto ns3PacketTag = data->getTag<Ns3PacketTag>();
+  const Ns3PacketTag* ns3PacketTag = data->findTag<Ns3PacketTag>();
   if (ns3PacketTag != nullptr) { // e.g., packet came from local node's cache
     FwHopCountTag hopCountTag;
     if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
@@ -241,24 +258,28 @@ ConsumerKan::OnData(shared_ptr<const Data> data)
     }
   }
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
-
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+  const ConsumerSeqTable::Entry* entry = m_seqTable.find(seq);
+  if (entry != nullptr) {
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->lastSent, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->firstSent, entry->retxCount,
+                             hopCount);
+    m_seqTable.erase(seq);
   }
 
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
+  m_rtt->AckSeq(SequenceNumber32(seq));
+  ScheduleRetxCheck();
+}
 
-  m_seqTimeouts.erase(seq);
-  m_retxSeqs.erase(seq);
+void
+ConsumerKan::SaveState(std::ostream& os) const
+{
+  SnapshotHelper::WriteNumber(os, m_seq);
+}
 
-  m_rtt->AckSeq(SequenceNumber32(seq));
+void
+ConsumerKan::RestoreState(std::istream& is)
+{
+  m_seq = SnapshotHelper::ReadNumber(is);
 }
 
 void
@@ -271,7 +292,7 @@ ConsumerKan::OnTimeout(uint32_t sequenceNumber)
   m_rtt->IncreaseMultiplier(); // Double the next RTO
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber),
                  1); // make sure to disable RTT calculation for this sample
-  m_retxSeqs.insert(sequenceNumber);
+  m_seqTable.scheduleRetx(sequenceNumber);
   ScheduleNextPacket();
 }
 
@@ -279,17 +300,12 @@ void
 ConsumerKan::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+                                << m_seqTable.size() << " items");
 
-  m_seqRetxCounts[sequenceNumber]++;
+  m_seqTable.sent(sequenceNumber, Simulator::Now());
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
+  ScheduleRetxCheck();
 }
 
 } // namespace ndn
@@ -31,14 +31,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.hpp"
-
-#include <set>
-#include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include "ns3/ndnSIM/utils/ndn-consumer-seq-table.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -70,6 +63,13 @@ public:
   virtual void
   OnTimeout(uint32_t sequenceNumber);
 
+  // From App
+  virtual void
+  SaveState(std::ostream& os) const;
+
+  virtual void
+  RestoreState(std::istream& is);
+
   /**
    * @brief Actually send packet
    */
@@ -115,15 +115,24 @@ protected:
   CheckRetxTimeout();
 
   /**
-   * \brief Modifies the frequency of checking the retransmission timeouts
-   * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
+   * \brief Arms (or re-arms) the retransmission check for the earliest outstanding Interest
+   *
+   * The check is not scheduled when there are no outstanding Interests.
+   */
+  void
+  ScheduleRetxCheck();
+
+  /**
+   * \brief Modifies the granularity of checking the retransmission timeouts
+   * \param retxTimer Retransmission timeouts are checked at multiples of this interval after
+   *                  the earliest outstanding Interest has been sent
    */
   void
   SetRetxTimer(Time retxTimer);
 
   /**
-   * \brief Returns the frequency of checking the retransmission timeouts
-   * \return Timeout defining how frequent retransmission timeouts should be checked
+   * \brief Returns the granularity of checking the retransmission timeouts
+   * \return Interval at multiples of which retransmission timeouts are checked
    */
   Time
   GetRetxTimer() const;
@@ -135,7 +144,8 @@ protected:
   uint32_t m_seqMax;   ///< @brief maximum number of sequence number
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
   Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
-  EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
+  EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be
+                       ///< performed (scheduled only while Interests are outstanding)
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
 
@@ -144,62 +154,7 @@ protected:
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
 
   /// @cond include_hidden
-  /**
-   * \struct This struct contains sequence numbers of packets to be retransmitted
-   */
-  struct RetxSeqsContainer : public std::set<uint32_t> {
-  };
-
-  RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
-
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
-
-    uint32_t seq;
-    Time time;
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  ConsumerSeqTable m_seqTable; ///< \brief state of outstanding and retransmitted Interests
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
@@ -0,0 +1,277 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-trace.hpp"
+#include "ns3/ptr.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include "utils/ndn-ns3-packet-tag.hpp"
+#include "utils/ndn-fw-hop-count-tag.hpp"
+#include "model/ndn-app-face.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerTrace");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerTrace);
+
+TypeId
+ConsumerTrace::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerTrace")
+      .SetGroupName("Ndn")
+      .SetParent<App>()
+      .AddConstructor<ConsumerTrace>()
+
+      .AddAttribute("Prefix", "Prefix of the names, if the trace does not contain names",
+                    StringValue("/"), MakeNameAccessor(&ConsumerTrace::m_interestName),
+                    MakeNameChecker())
+      .AddAttribute("LifeTime", "LifeTime for interest packet", StringValue("2s"),
+                    MakeTimeAccessor(&ConsumerTrace::m_interestLifeTime), MakeTimeChecker())
+      .AddAttribute("ValidationFlag", "Validation flag of the Interests", UintegerValue(0),
+                    MakeUintegerAccessor(&ConsumerTrace::m_validationFlag),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddAttribute("TraceFile", "Binary request trace to replay", StringValue(""),
+                    MakeStringAccessor(&ConsumerTrace::SetTraceFile,
+                                       &ConsumerTrace::GetTraceFile),
+                    MakeStringChecker())
+      .AddAttribute("ReadAheadWindow", "Size of the memory-mapped part of the trace, in bytes",
+                    UintegerValue(16 * 1024 * 1024),
+                    MakeUintegerAccessor(&ConsumerTrace::m_readAheadWindow),
+                    MakeUintegerChecker<uint32_t>(sizeof(RequestTrace::Record)))
+      .AddAttribute("ExpiryGranularity",
+                    "Timeouts of requests are checked at multiples of this interval",
+                    StringValue("50ms"), MakeTimeAccessor(&ConsumerTrace::m_expiryGranularity),
+                    MakeTimeChecker())
+
+      .AddTraceSource("LastRetransmittedInterestDataDelay",
+                      "Delay between last retransmitted Interest and received Data",
+                      MakeTraceSourceAccessor(&ConsumerTrace::m_lastRetransmittedInterestDataDelay),
+                      "ns3::ndn::ConsumerTrace::LastRetransmittedInterestDataDelayCallback")
+
+      .AddTraceSource("FirstInterestDataDelay",
+                      "Delay between first transmitted Interest and received Data",
+                      MakeTraceSourceAccessor(&ConsumerTrace::m_firstInterestDataDelay),
+                      "ns3::ndn::ConsumerTrace::FirstInterestDataDelayCallback");
+
+  return tid;
+}
+
+ConsumerTrace::ConsumerTrace()
+  : m_validationFlag(0)
+  , m_readAheadWindow(16 * 1024 * 1024)
+  , m_hasNext(false)
+  , m_firstRecordTime(0)
+  , m_rand(CreateObject<UniformRandomVariable>())
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+ConsumerTrace::SetTraceFile(const std::string& fileName)
+{
+  m_traceFile = fileName;
+  m_reader.reset(); // opened when the application starts
+}
+
+std::string
+ConsumerTrace::GetTraceFile() const
+{
+  return m_traceFile;
+}
+
+void
+ConsumerTrace::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  App::StartApplication();
+
+  if (m_traceFile.empty()) {
+    NS_LOG_WARN("TraceFile is not set, nothing to replay");
+    return;
+  }
+
+  if (m_reader == nullptr)
+    m_reader.reset(new RequestTraceReader(m_traceFile, m_readAheadWindow));
+  else
+    m_reader->rewind();
+
+  m_hasNext = m_reader->next(m_next);
+  m_firstRecordTime = m_next.time;
+  m_startTime = Simulator::Now();
+
+  ScheduleNextPacket();
+}
+
+void
+ConsumerTrace::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  Simulator::Cancel(m_sendEvent);
+  Simulator::Cancel(m_expiryEvent);
+
+  App::StopApplication();
+}
+
+void
+ConsumerTrace::ScheduleNextPacket()
+{
+  if (!m_hasNext)
+    return;
+
+  Time at = m_startTime + NanoSeconds(m_next.time - m_firstRecordTime);
+  m_sendEvent = Simulator::Schedule(at - Simulator::Now(), &ConsumerTrace::SendPacket, this);
+}
+
+Name
+ConsumerTrace::GetName(uint32_t nameId) const
+{
+  if (m_reader->hasNames())
+    return m_reader->getName(nameId);
+
+  return Name(m_interestName).appendSequenceNumber(nameId);
+}
+
+void
+ConsumerTrace::SendPacket()
+{
+  if (!m_active)
+    return;
+
+  // all requests with the same timestamp are sent in one event
+  int64_t now = m_next.time;
+  while (m_hasNext && m_next.time == now) {
+    shared_ptr<Interest> interest = make_shared<Interest>();
+    interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+    interest->setName(GetName(m_next.nameId));
+    time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
+    interest->setInterestLifetime(interestLifeTime);
+    interest->setPITList("");
+    interest->setValidationFlag(m_validationFlag);
+    interest->setLocationRegistration(0);
+
+    NS_LOG_INFO("> Interest for " << interest->getName() << " (user " << m_next.user << ")");
+
+    // recorded before sending, as Data can be returned from the local cache immediately
+    Request request = {m_next.nameId, Simulator::Now()};
+    m_pending[interest->getName()].push_back(request);
+    m_expiry.push_back(request);
+    ScheduleExpiryCheck();
+
+    m_hasNext = m_reader->next(m_next);
+
+    m_transmittedInterests(interest, this, m_face);
+    m_face->onReceiveInterest(*interest);
+  }
+
+  ScheduleNextPacket();
+}
+
+void
+ConsumerTrace::OnData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  App::OnData(data); // tracing inside
+
+  NS_LOG_INFO("< DATA for " << data->getName());
+
+  auto pending = m_pending.find(data->getName());
+  if (pending == m_pending.end())
+    return;
+
+  int hopCount = 0;
+  const Ns3PacketTag* ns3PacketTag = data->findTag<Ns3PacketTag>();
+  if (ns3PacketTag != nullptr) { // e.g., packet came from local node's cache
+    FwHopCountTag hopCountTag;
+    if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
+      hopCount = hopCountTag.Get();
+      NS_LOG_DEBUG("Hop count: " << hopCount);
+    }
+  }
+
+  Time now = Simulator::Now();
+  for (const Request& request : pending->second) {
+    m_lastRetransmittedInterestDataDelay(this, request.nameId, now - request.time, hopCount);
+    m_firstInterestDataDelay(this, request.nameId, now - request.time, 1, hopCount);
+  }
+
+  // records in m_expiry are dropped when they expire
+  m_pending.erase(pending);
+}
+
+void
+ConsumerTrace::ScheduleExpiryCheck()
+{
+  if (m_expiryEvent.IsRunning() || m_expiry.empty())
+    return;
+
+  // all requests have the same lifetime, so the front request always expires first
+  Time delay = std::max(m_expiry.front().time + m_interestLifeTime - Simulator::Now(),
+                        Seconds(0));
+  if (m_expiryGranularity.IsStrictlyPositive()) {
+    int64_t step = m_expiryGranularity.GetTimeStep();
+    delay = TimeStep((delay.GetTimeStep() + step - 1) / step * step);
+  }
+
+  m_expiryEvent = Simulator::Schedule(delay, &ConsumerTrace::CheckExpiry, this);
+}
+
+void
+ConsumerTrace::CheckExpiry()
+{
+  Time deadline = Simulator::Now() - m_interestLifeTime;
+
+  while (!m_expiry.empty() && m_expiry.front().time <= deadline) {
+    const Request& expired = m_expiry.front();
+
+    auto pending = m_pending.find(GetName(expired.nameId));
+    if (pending != m_pending.end()) {
+      std::vector<Request>& requests = pending->second;
+      for (auto request = requests.begin(); request != requests.end(); ++request) {
+        if (request->time == expired.time) {
+          NS_LOG_DEBUG("Request for " << pending->first << " timed out");
+          *request = requests.back();
+          requests.pop_back();
+          break;
+        }
+      }
+
+      if (requests.empty())
+        m_pending.erase(pending);
+    }
+
+    m_expiry.pop_front();
+  }
+
+  ScheduleExpiryCheck();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_TRACE_H
+#define NDN_CONSUMER_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-app.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-request-trace.hpp"
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/nstime.h"
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief NDN application replaying requests from a binary request trace
+ *
+ * Requests are replayed relative to the application start: the first record of the trace is
+ * requested when the application starts.  The trace is read sequentially through a memory-mapped
+ * window of `ReadAheadWindow` bytes and only the next request is scheduled at a time, so the
+ * memory used does not depend on the size of the trace.  See RequestTrace for the file format
+ * and ConvertCsvToRequestTrace for the converter from CSV logs.
+ *
+ * Requests are not retransmitted; requests for the same name share the Data packet.  Delays
+ * are reported through the same trace sources as Consumer (with the name id as the sequence
+ * number), so AppDelayTracer can be used.
+ */
+class ConsumerTrace : public App {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerTrace();
+
+  // From App
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+public:
+  typedef void (*LastRetransmittedInterestDataDelayCallback)(Ptr<App> app, uint32_t seqno,
+                                                             Time delay, int32_t hopCount);
+  typedef void (*FirstInterestDataDelayCallback)(Ptr<App> app, uint32_t seqno, Time delay,
+                                                 uint32_t retxCount, int32_t hopCount);
+
+protected:
+  // from App
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+private:
+  void
+  SetTraceFile(const std::string& fileName);
+
+  std::string
+  GetTraceFile() const;
+
+  void
+  ScheduleNextPacket();
+
+  void
+  SendPacket();
+
+  Name
+  GetName(uint32_t nameId) const;
+
+  void
+  ScheduleExpiryCheck();
+
+  void
+  CheckExpiry();
+
+private:
+  Name m_interestName;     ///< @brief prefix of the names for traces without names
+  Time m_interestLifeTime; ///< @brief lifetime of Interests
+  uint32_t m_validationFlag;
+  std::string m_traceFile;
+  uint32_t m_readAheadWindow;
+  Time m_expiryGranularity;
+
+  std::unique_ptr<RequestTraceReader> m_reader;
+  RequestTrace::Record m_next; ///< @brief next record to be requested
+  bool m_hasNext;
+  Time m_startTime; ///< @brief simulation time corresponding to the first record
+  int64_t m_firstRecordTime;
+
+  Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
+  EventId m_sendEvent;
+  EventId m_expiryEvent;
+
+  /// @cond include_hidden
+  struct Request {
+    uint32_t nameId;
+    Time time;
+  };
+
+  std::unordered_map<Name, std::vector<Request>> m_pending;
+  std::deque<Request> m_expiry; ///< @brief requests in the order they were made
+
+  TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
+    m_lastRetransmittedInterestDataDelay;
+  TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */,
+                 uint32_t /*retx count*/, int32_t /*hop count*/> m_firstInterestDataDelay;
+  /// @endcond
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_TRACE_H
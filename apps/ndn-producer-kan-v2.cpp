@@ -20,6 +20,7 @@
  **/
 
 #include "ndn-producer-kan-v2.hpp"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -27,12 +28,15 @@
 #include "ns3/uinteger.h"
 
 #include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-snapshot-helper.hpp"
 #include "model/ndn-app-face.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-ns3.hpp"
+#include "utils/ndn-publication-tree.hpp"
+#include "utils/ndn-virtual-payload-tag.hpp"
 
+#include <algorithm>
 #include <memory>
-#include <random>
 
 using namespace std;
 
@@ -64,6 +68,12 @@ TypeId ProducerKanV2::GetTypeId( void ) {
               UintegerValue( 1024 ),
               MakeUintegerAccessor( &ProducerKanV2::m_virtualPayloadSize ),
               MakeUintegerChecker<uint32_t>() )
+          .AddAttribute(
+              "VirtualPayload",
+              "数据包的Content为空，PayloadSize字节作为不占内存的ns-3虚拟负载传输",
+              BooleanValue( false ),
+              MakeBooleanAccessor( &ProducerKanV2::m_virtual_payload ),
+              MakeBooleanChecker() )
           .AddAttribute(
               "Freshness",
               "Freshness of data packets, if 0, then unlimited freshness",
@@ -94,132 +104,330 @@ TypeId ProducerKanV2::GetTypeId( void ) {
               "ExprimentTime", "实验时长", StringValue( "150" ),
               MakeUintegerAccessor( &ProducerKanV2::m_expriment_time ),
               MakeUintegerChecker<uint32_t>() )
+          .AddAttribute(
+              "WarmupTime",
+              "预热时长，之后才统计过期消息；从快照恢复的实验可设为0",
+              StringValue( "41" ),
+              MakeUintegerAccessor( &ProducerKanV2::m_warmup_time ),
+              MakeUintegerChecker<uint32_t>() )
           .AddAttribute( "EligibleContentsNumber", "主动推送的内容数量",
                          StringValue( "100" ),
                          MakeUintegerAccessor(
                              &ProducerKanV2::m_eligible_contents_number ),
-                         MakeUintegerChecker<uint32_t>() );
+                         MakeUintegerChecker<uint32_t>() )
+          .AddAttribute(
+              "AggregatePublications",
+              "同名内容的订阅路径合并为反向路径树，每次更新只发布一个数据包",
+              BooleanValue( true ),
+              MakeBooleanAccessor( &ProducerKanV2::m_aggregate_publications ),
+              MakeBooleanChecker() );
   return tid;
 }
 
-ProducerKanV2::ProducerKanV2() { NS_LOG_FUNCTION_NOARGS(); }
+ProducerKanV2::ProducerKanV2()
+    : m_virtual_payload( false )
+    , m_aggregate_publications( true )
+    , m_eligibleContents( nullptr )
+    , m_nextEntryId( 0 )
+    , m_rand( CreateObject<UniformRandomVariable>() ) {
+  NS_LOG_FUNCTION_NOARGS();
+}
 
 // inherited from Application base class.
 void ProducerKanV2::StartApplication() {
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
-  FibHelper::AddRoute( GetNode(), m_prefix, m_face, 0 );
-}
-
-void ProducerKanV2::StopApplication() {
-  NS_LOG_FUNCTION_NOARGS();
-  App::StopApplication();
-}
-
-void ProducerKanV2::OnInterest( shared_ptr<const Interest> interest ) {
-  App::OnInterest( interest ); // tracing inside
-
-  // cout<< m_face->getId()<<endl;
-  // cout<< m_average_update_time <<endl;
-  // cout<< m_max_pitstore_size <<endl;
-  int LocationRegistration = interest->getLocationRegistration();
-
-  NS_LOG_FUNCTION( this << interest );
-  if ( !m_active ) return;
-
-  // add by kan 20190416
-  double tnow = ns3::Simulator::Now().GetSeconds();
-  // int      average_update_time = 20;
-  // uint32_t maxSize             = max_pitstore_size;
-
-  // 更新因子，范围[0,1]，表示内容到期后，更新时间变化的概率。
-  double update_factor = 1.0;
-
-  random_device r;
-  string        eligible_contents;
-
+  // 可主动推送的内容列表只需在启动时选择一次
   switch ( m_eligible_contents_number ) {
   case 50:
-    eligible_contents = eligible_contents_50;
+    m_eligibleContents = &eligible_contents_50;
     break;
   case 60:
-    eligible_contents = eligible_contents_60;
+    m_eligibleContents = &eligible_contents_60;
     break;
   case 70:
-    eligible_contents = eligible_contents_70;
+    m_eligibleContents = &eligible_contents_70;
     break;
   case 80:
-    eligible_contents = eligible_contents_80;
+    m_eligibleContents = &eligible_contents_80;
     break;
   case 90:
-    eligible_contents = eligible_contents_90;
+    m_eligibleContents = &eligible_contents_90;
     break;
   case 100:
-    eligible_contents = eligible_contents_100;
+    m_eligibleContents = &eligible_contents_100;
     break;
   case 110:
-    eligible_contents = eligible_contents_110;
+    m_eligibleContents = &eligible_contents_110;
     break;
   case 120:
-    eligible_contents = eligible_contents_120;
+    m_eligibleContents = &eligible_contents_120;
     break;
   case 130:
-    eligible_contents = eligible_contents_130;
+    m_eligibleContents = &eligible_contents_130;
     break;
   case 140:
-    eligible_contents = eligible_contents_140;
+    m_eligibleContents = &eligible_contents_140;
     break;
   case 150:
-    eligible_contents = eligible_contents_150;
+    m_eligibleContents = &eligible_contents_150;
     break;
   case 200:
-    eligible_contents = eligible_contents_200;
+    m_eligibleContents = &eligible_contents_200;
     break;
   case 300:
-    eligible_contents = eligible_contents_300;
+    m_eligibleContents = &eligible_contents_300;
     break;
   case 400:
-    eligible_contents = eligible_contents_400;
+    m_eligibleContents = &eligible_contents_400;
     break;
   case 500:
-    eligible_contents = eligible_contents_500;
+    m_eligibleContents = &eligible_contents_500;
     break;
   case 1000:
-    eligible_contents = eligible_contents_1000;
+    m_eligibleContents = &eligible_contents_1000;
     break;
 
   default:
+    m_eligibleContents = nullptr;
     break;
   }
 
-  bool              eligibility;
-  string::size_type idx;
-  idx = eligible_contents.find( interest->getName().toUri() );
-  if ( idx == string::npos ) {
-    eligibility = false;
+  if ( !m_virtual_payload ) {
+    // Content只编码一次，所有数据包共享同一块内存
+    ::ndn::Buffer payload( m_virtualPayloadSize );
+    m_content = ::ndn::makeBinaryBlock( ::ndn::tlv::Content, payload.buf(),
+                                        payload.size() );
+  }
+
+  FibHelper::AddRoute( GetNode(), m_prefix, m_face, 0 );
+
+  ArmPublishTimer();
+}
+
+void ProducerKanV2::StopApplication() {
+  NS_LOG_FUNCTION_NOARGS();
+  Simulator::Cancel( m_publishEvent );
+  App::StopApplication();
+}
+
+int ProducerKanV2::DrawUpdateTime() {
+  // 内容更新时间，[1, 2*average_update_time-1]
+  return m_rand->GetInteger( 1, 2 * m_average_update_time - 1 );
+}
+
+void ProducerKanV2::SetPayload( Data& data ) const {
+  if ( m_virtual_payload ) {
+    data.setInlineTag( VirtualPayloadTag( m_virtualPayloadSize ) );
   } else {
-    eligibility = true;
+    data.setContent( m_content );
+  }
+}
+
+shared_ptr<Data> ProducerKanV2::MakePublication(
+    const Name& name, const std::string& PITListBack, int expiration ) const {
+  auto data = make_shared<Data>();
+  data->setName( name );
+  data->setFreshnessPeriod(
+      ::ndn::time::milliseconds( m_freshness.GetMilliSeconds() ) );
+
+  SetPayload( *data );
+
+  // 设置有有效性要求的数据包字段
+  data->setValidationDataFlag( 1 );
+  data->setExpiration( expiration );
+  data->setPITListBack( PITListBack );
+  data->setValidationPublishment( 1 );
+  data->setEligibility( 1 ); // PITListStore中只有可主动推送的内容
+
+  Signature     signature;
+  SignatureInfo signatureInfo(
+      static_cast<::ndn::tlv::SignatureTypeValue>( 255 ) );
+
+  if ( m_keyLocator.size() > 0 ) {
+    signatureInfo.setKeyLocator( m_keyLocator );
+  }
+
+  signature.setInfo( signatureInfo );
+  signature.setValue(::ndn::nonNegativeIntegerBlock(
+      ::ndn::tlv::SignatureValue, m_signature ) );
+
+  data->setSignature( signature );
+  data->wireEncode();
+  return data;
+}
+
+void ProducerKanV2::InsertEntry( PITListEntry entry ) {
+  entry.id = m_nextEntryId++;
+  PITListStore.push_front( entry );
+  m_entries[ entry.id ] = PITListStore.begin();
+
+  PublishDeadline deadline = {entry.last_update_time + entry.update_time,
+                              entry.id};
+  m_publishQueue.push( deadline );
+  ArmPublishTimer();
+}
+
+void ProducerKanV2::SaveState( std::ostream& os ) const {
+  int tnow = (int) Simulator::Now().GetSeconds();
+
+  // 从表尾开始保存，恢复时依次插入表头即得到原顺序
+  SnapshotHelper::WriteNumber( os, PITListStore.size() );
+  for ( auto entry = PITListStore.rbegin(); entry != PITListStore.rend();
+        ++entry ) {
+    SnapshotHelper::WriteString( os, entry->name.toUri() );
+    SnapshotHelper::WriteString( os, entry->PITList );
+    SnapshotHelper::WriteNumber( os, entry->insert_time - tnow );
+    SnapshotHelper::WriteNumber( os, entry->last_update_time - tnow );
+    SnapshotHelper::WriteNumber( os, entry->update_time );
+  }
+}
+
+void ProducerKanV2::RestoreState( std::istream& is ) {
+  int tnow = (int) Simulator::Now().GetSeconds();
+
+  PITListStore.clear();
+  m_entries.clear();
+  m_publishQueue = decltype( m_publishQueue )();
+
+  for ( int64_t i = SnapshotHelper::ReadNumber( is ); i > 0; i-- ) {
+    PITListEntry entry;
+    entry.name             = Name( SnapshotHelper::ReadString( is ) );
+    entry.PITList          = SnapshotHelper::ReadString( is );
+    entry.port             = 0; // 未使用
+    entry.insert_time      = SnapshotHelper::ReadNumber( is ) + tnow;
+    entry.last_update_time = SnapshotHelper::ReadNumber( is ) + tnow;
+    entry.update_time      = SnapshotHelper::ReadNumber( is );
+    InsertEntry( entry );
+  }
+}
+
+void ProducerKanV2::EraseEntry( std::list<PITListEntry>::iterator entry ) {
+  // 堆中对应的发布时间在出堆时丢弃
+  m_entries.erase( entry->id );
+  PITListStore.erase( entry );
+}
+
+bool ProducerKanV2::IsCurrent( const PublishDeadline& deadline ) const {
+  auto entry = m_entries.find( deadline.id );
+  return entry != m_entries.end() &&
+         entry->second->last_update_time + entry->second->update_time ==
+             deadline.time;
+}
+
+void ProducerKanV2::ArmPublishTimer() {
+  while ( !m_publishQueue.empty() && !IsCurrent( m_publishQueue.top() ) )
+    m_publishQueue.pop();
+
+  if ( !m_active || m_publishQueue.empty() ) return;
+
+  Time delay =
+      std::max( Seconds( m_publishQueue.top().time ) - Simulator::Now(),
+                Seconds( 0 ) );
+  if ( m_publishEvent.IsRunning() ) {
+    if ( Simulator::GetDelayLeft( m_publishEvent ) <= delay ) return;
+    Simulator::Cancel( m_publishEvent );
+  }
+  m_publishEvent = Simulator::Schedule( delay, &ProducerKanV2::Publish, this );
+}
+
+void ProducerKanV2::Publish() {
+  if ( !m_active || m_publishQueue.empty() ) return;
+
+  // 同一秒到期的内容在一次事件中批量发布
+  int tnow = m_publishQueue.top().time;
+  NS_LOG_DEBUG( "publication tick " << tnow );
+
+  // 更新因子，范围[0,1]，表示内容到期后，更新时间变化的概率。
+  double update_factor = 1.0;
+
+  // 到期的记录按内容名分组，每组只发布一个数据包；不合并时每条路径单独一组
+  std::vector<std::vector<PITListEntry*>> groups;
+  std::unordered_map<Name, size_t>        groupOfName;
+  while ( !m_publishQueue.empty() && m_publishQueue.top().time <= tnow ) {
+    PublishDeadline deadline = m_publishQueue.top();
+    m_publishQueue.pop();
+    if ( !IsCurrent( deadline ) ) continue;
+
+    PITListEntry* entry = &*m_entries[ deadline.id ];
+    if ( m_aggregate_publications ) {
+      auto group =
+          groupOfName.insert( std::make_pair( entry->name, groups.size() ) );
+      if ( group.second ) groups.emplace_back();
+      groups[ group.first->second ].push_back( entry );
+    } else {
+      groups.push_back( std::vector<PITListEntry*>( 1, entry ) );
+    }
+  }
+
+  for ( const auto& group : groups ) {
+    const PITListEntry& first       = *group.front();
+    std::string         PITListBack = first.PITList;
+    if ( group.size() > 1 ) {
+      // 多个订阅者的路径合并为反向路径树，树上每条链路只发送一次
+      PublicationTree tree;
+      for ( const PITListEntry* entry : group ) tree.addPath( entry->PITList );
+      PITListBack = tree.encode();
+    }
+
+    shared_ptr<Data> data = MakePublication( first.name, PITListBack, 0 );
+    m_transmittedDatas( data, this, m_face );
+    m_face->onReceiveData( *data );
+    NS_LOG_INFO( "publication data" );
+
+    int update_time = first.update_time;
+    if ( update_factor >= m_rand->GetValue( 0, 1 ) ) {
+      // 随机因子越靠近1，内容的更新时间越有可能发生变化
+      update_time = DrawUpdateTime();
+    }
+
+    // 当前时间-上次更新时间等于更新时间，需要重新发布一次，
+    // 并将上次更新时间置为当前时间。
+    for ( PITListEntry* entry : group ) {
+      entry->last_update_time = tnow;
+      entry->update_time      = update_time;
+
+      PublishDeadline deadline = {tnow + update_time, entry->id};
+      m_publishQueue.push( deadline );
+    }
   }
 
+  ArmPublishTimer();
+}
+
+void ProducerKanV2::OnInterest( shared_ptr<const Interest> interest ) {
+  App::OnInterest( interest ); // tracing inside
+
+  // cout<< m_face->getId()<<endl;
+  // cout<< m_average_update_time <<endl;
+  // cout<< m_max_pitstore_size <<endl;
+  int LocationRegistration = interest->getLocationRegistration();
+
+  NS_LOG_FUNCTION( this << interest );
+  if ( !m_active ) return;
+
+  // add by kan 20190416
+  double tnow = ns3::Simulator::Now().GetSeconds();
+
+  bool eligibility =
+      m_eligibleContents != nullptr &&
+      m_eligibleContents->find( interest->getName().toUri() ) != string::npos;
+
   if ( interest->getValidationFlag() == 1 && eligibility &&
        LocationRegistration == 0 ) {
     // 把具有有效性要求的内容存入PITListStore中
 
-    int                           tnow_int = (int) tnow;
-    default_random_engine         update_time_e( r() );
-    uniform_int_distribution<int> update_time_u( 1, 2 * m_average_update_time -
-                                                        1 );
+    int tnow_int = (int) tnow;
 
     struct PITListEntry pe;
     pe.name        = interest->getName();
     pe.PITList     = interest->getPITList();
     pe.insert_time = tnow_int;
-    pe.update_time = update_time_u( update_time_e );
-    default_random_engine         last_update_time_e( r() );
-    uniform_int_distribution<int> last_update_time_u(
-        tnow_int - pe.update_time + 1, tnow_int );
-    pe.last_update_time = last_update_time_u( last_update_time_e );
+    pe.update_time = DrawUpdateTime();
+    // 上次更新时间 [tnow-update_time+1, tnow]
+    pe.last_update_time =
+        tnow_int - (int) m_rand->GetInteger( 0, pe.update_time - 1 );
 
     // cout << pe.insert_time << " : " << pe.update_time << " : "
     //      << pe.last_update_time << endl;
@@ -238,7 +446,7 @@ void ProducerKanV2::OnInterest( shared_ptr<const Interest> interest ) {
           pe.insert_time      = it->insert_time;
           pe.update_time      = it->update_time;
           pe.last_update_time = it->last_update_time;
-          PITListStore.erase( it );
+          EraseEntry( it );
           // cout << "!" << endl;
         } else if ( ( it->PITList + "PITList" )
                             .find( interest->getPITList() + "PITList" ) !=
@@ -250,7 +458,7 @@ void ProducerKanV2::OnInterest( shared_ptr<const Interest> interest ) {
           pe.insert_time      = it->insert_time;
           pe.update_time      = it->update_time;
           pe.last_update_time = it->last_update_time;
-          PITListStore.erase( it );
+          EraseEntry( it );
           //
           // cout<< "!!"<<endl;
         } else if ( ( interest->getPITList() + "PITList" )
@@ -261,43 +469,23 @@ void ProducerKanV2::OnInterest( shared_ptr<const Interest> interest ) {
           pe.insert_time      = it->insert_time;
           pe.update_time      = it->update_time;
           pe.last_update_time = it->last_update_time;
-          PITListStore.erase( it );
+          EraseEntry( it );
           // cout<< "!!!"<<endl;
+        } else if ( m_aggregate_publications &&
+                    it->name == interest->getName() ) {
+          // 同名内容的所有路径共用更新时间，到期时合并发布
+          pe.update_time      = it->update_time;
+          pe.last_update_time = it->last_update_time;
         }
       }
     }
     // add by kan 20190411
     // PITListStore达到最大缓存时，删除末尾记录，在头部插入新记录
-    if ( PITListStore.size() == m_max_pitstore_size ) {
-      struct PITListEntry temp = PITListStore.back();
-      Name                dataName( temp.name );
-      auto                data = make_shared<Data>();
-      data->setName( dataName );
-      data->setFreshnessPeriod(
-          ::ndn::time::milliseconds( m_freshness.GetMilliSeconds() ) );
-
-      data->setContent( make_shared<::ndn::Buffer>( m_virtualPayloadSize ) );
-
-      // 设置有有效性要求的数据包字段
-      data->setValidationDataFlag( 1 );
-      data->setExpiration(
-          1 ); // PITListStore不再发布此数据包，用户此后请求到的可能是过期内容
-      data->setPITListBack( temp.PITList );
-      data->setValidationPublishment( 1 );
-      Signature     signature;
-      SignatureInfo signatureInfo(
-          static_cast<::ndn::tlv::SignatureTypeValue>( 255 ) );
-
-      if ( m_keyLocator.size() > 0 ) {
-        signatureInfo.setKeyLocator( m_keyLocator );
-      }
-
-      signature.setInfo( signatureInfo );
-      signature.setValue(::ndn::nonNegativeIntegerBlock(
-          ::ndn::tlv::SignatureValue, m_signature ) );
-
-      data->setSignature( signature );
-      data->wireEncode();
+    if ( !PITListStore.empty() &&
+         PITListStore.size() >= m_max_pitstore_size ) {
+      // PITListStore不再发布此数据包，用户此后请求到的可能是过期内容
+      const PITListEntry& temp = PITListStore.back();
+      shared_ptr<Data>    data = MakePublication( temp.name, temp.PITList, 1 );
 
       m_transmittedDatas( data, this, m_face );
       m_face->onReceiveData( *data );
@@ -305,88 +493,17 @@ void ProducerKanV2::OnInterest( shared_ptr<const Interest> interest ) {
       // cout << "ROOT: " <<data->getName() << " : " << data->getPITListBack()
       // <<endl;
 
-      PITListStore.pop_back(); // 删除表尾元素
-      if ( (int) tnow >= 41 && (int) tnow <= ( m_expriment_time - 10 ) )
+      EraseEntry( --PITListStore.end() ); // 删除表尾元素
+      if ( (int) tnow >= (int) m_warmup_time &&
+           (int) tnow <= ( m_expriment_time - 10 ) )
         expiration_count++;
       // cout << expiration_count << endl;
 
       // if ( (int) tnow >= 41 && (int) tnow <= 340 ) expiration_count++;
     }
-    PITListStore.push_front( pe );
-    // std::cout << PITListStore.size() << std::endl;
-  }
-  if ( LocationRegistration == 0 ) {
-    // std::cout << tnow << std::endl;
-    std::cout << PITListStore.size() << std::endl;
-    // std::cout << PITListStore.back().name << std::endl;
-    if ( (int) ( tnow * 10 ) % 10 != 0 ) {
-      published = false;
-    }
-    // std::cout << "false " << tnow << std::endl;
-    if ( (int) ( tnow * 10 ) % 10 == 0 && (int) tnow != 0 ) {
-      // 每秒检测一次PITList中是否有过期内容（即需要更新的内容），并重新分配内容的更新时间
-      // std::cout << published << std::endl;
-      if ( !published ) {
-        std::cout << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! " << tnow
-                  << std::endl;
-        // std::cout << PITListStore.size() << std::endl;
-        published = true;
-        for ( std::list<PITListEntry>::iterator it = PITListStore.begin();
-              it != PITListStore.end(); it++ ) {
-          if ( ( (int) tnow - it->last_update_time >= it->update_time ) ) {
-            // 当前时间-上次更新时间若大于等于更新时间，则需要重新发布一次，
-            // 并将上次更新时间置为当前时间。
-            it->last_update_time = (int) tnow;
-
-            Name dataName( it->name );
-            auto data = make_shared<Data>();
-            data->setName( dataName );
-            data->setFreshnessPeriod(
-                ::ndn::time::milliseconds( m_freshness.GetMilliSeconds() ) );
-
-            data->setContent(
-                make_shared<::ndn::Buffer>( m_virtualPayloadSize ) );
-
-            // 设置有有效性要求的数据包字段
-            data->setValidationDataFlag( 1 );
-            data->setExpiration( 0 );
-            data->setPITListBack( it->PITList );
-            data->setValidationPublishment( 1 );
-            data->setEligibility( 1 );
-
-            Signature     signature;
-            SignatureInfo signatureInfo(
-                static_cast<::ndn::tlv::SignatureTypeValue>( 255 ) );
-
-            if ( m_keyLocator.size() > 0 ) {
-              signatureInfo.setKeyLocator( m_keyLocator );
-            }
-
-            signature.setInfo( signatureInfo );
-            signature.setValue(::ndn::nonNegativeIntegerBlock(
-                ::ndn::tlv::SignatureValue, m_signature ) );
-
-            data->setSignature( signature );
-            data->wireEncode();
-
-            m_transmittedDatas( data, this, m_face );
-            m_face->onReceiveData( *data );
-            NS_LOG_INFO( "publication data" );
-
-            default_random_engine             update_factor_e( r() );
-            uniform_real_distribution<double> update_factor_u( 0, 1 );
-            if ( update_factor >= update_factor_u( update_factor_e ) ) {
-              // cout<<"update!!!"<<endl;
-              // 随机因子越靠近1，内容的更新时间越有可能发生变化
-              default_random_engine         update_time_e2( r() );
-              uniform_int_distribution<int> update_time_u2(
-                  1, 2 * m_average_update_time - 1 );
-              it->update_time = update_time_u2( update_time_e2 );
-            }
-          }
-        }
-      }
-    }
+    // 按下次更新时间加入发布队列
+    InsertEntry( pe );
+    NS_LOG_DEBUG( "PITListStore size " << PITListStore.size() );
   }
   // end add
   if ( LocationRegistration != 1 ) {
@@ -400,7 +517,7 @@ void ProducerKanV2::OnInterest( shared_ptr<const Interest> interest ) {
     data->setFreshnessPeriod(
         ::ndn::time::milliseconds( m_freshness.GetMilliSeconds() ) );
 
-    data->setContent( make_shared<::ndn::Buffer>( m_virtualPayloadSize ) );
+    SetPayload( *data );
 
     Signature     signature;
     SignatureInfo signatureInfo(
@@ -29,8 +29,15 @@
 
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
 #include "time.h"
 
+#include <functional>
+#include <list>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -52,6 +59,11 @@ public:
   // inherited from NdnApp
   virtual void OnInterest( shared_ptr<const Interest> interest );
 
+  // 保存/恢复PITListStore，时间相对于快照时刻
+  virtual void SaveState( std::ostream& os ) const;
+
+  virtual void RestoreState( std::istream& is );
+
   // add by kan 20190331
   struct PITListEntry {
     Name        name;
@@ -60,6 +72,7 @@ public:
     int         insert_time; // 记录插入时间
     int last_update_time; // 上次更新时间 [insert_time-update_time, insert_time)
     int update_time; //  内容更新时间，(0, 2*average_ttl]
+    uint64_t id;     // 发布队列中的标识
   };
 
   std::list<PITListEntry> PITListStore;
@@ -67,10 +80,6 @@ public:
 
   int expiration_count = 0;
 
-  // add by kan 20190401
-  bool published = false;
-  // end add
-
   // add by kan 20191231
   std::string eligible_contents_50 = "/prefix/%FE%04/prefix/%FE%08/prefix/%FE%1B/prefix/%FE%1F/prefix/%FE%12/prefix/%FE%0C/prefix/%FE%19/prefix/%FE%01/prefix/%FE%05/prefix/%FE%25/prefix/%FE%21/prefix/%FE./prefix/%FE%17/prefix/%FE%16/prefix/%FE%07/prefix/%FE%0F/prefix/%FE%15/prefix/%FE2/prefix/%FE%03/prefix/%FE%10/prefix/%FE%0B/prefix/%FE%0A/prefix/%FE%23/prefix/%FE%24/prefix/%FE%0E/prefix/%FE%2A/prefix/%FE%06/prefix/%FE%02/prefix/%FE%09/prefix/%FE+/prefix/%FE1/prefix/%FE%2C/prefix/%FE0/prefix/%FE%11/prefix/%FE%20/prefix/%FE%2F/prefix/%FE%13/prefix/%FE%22/prefix/%FE%28/prefix/%FE%1C/prefix/%FE%26/prefix/%FE%18/prefix/%FE%1E/prefix/%FE-/prefix/%FE%29/prefix/%FE%1A/prefix/%FE%1D/prefix/%FE%27/prefix/%FE%14/prefix/%FE%0D";
   std::string eligible_contents_60 = "/prefix/%FE%04/prefix/%FE%08/prefix/%FE%1B/prefix/%FE%1F/prefix/%FE%12/prefix/%FE%0C/prefix/%FE%3A/prefix/%FE%19/prefix/%FE%01/prefix/%FE%05/prefix/%FE%25/prefix/%FE%21/prefix/%FE./prefix/%FE%17/prefix/%FE8/prefix/%FE%16/prefix/%FE%07/prefix/%FE%0F/prefix/%FE%15/prefix/%FE2/prefix/%FE%03/prefix/%FE%10/prefix/%FE%0B/prefix/%FE%0A/prefix/%FE%23/prefix/%FE%24/prefix/%FE%0E/prefix/%FE%2A/prefix/%FE%06/prefix/%FE%02/prefix/%FE%09/prefix/%FE%3C/prefix/%FE+/prefix/%FE1/prefix/%FE%2C/prefix/%FE0/prefix/%FE%11/prefix/%FE5/prefix/%FE6/prefix/%FE%20/prefix/%FE%2F/prefix/%FE%13/prefix/%FE%22/prefix/%FE%28/prefix/%FE%1C/prefix/%FE4/prefix/%FE%26/prefix/%FE%18/prefix/%FE%1E/prefix/%FE-/prefix/%FE%29/prefix/%FE%1A/prefix/%FE%1D/prefix/%FE%27/prefix/%FE%14/prefix/%FE%0D/prefix/%FE%3B/prefix/%FE3/prefix/%FE7";
@@ -99,6 +108,8 @@ private:
   Name     m_prefix;
   Name     m_postfix;
   uint32_t m_virtualPayloadSize;
+  bool     m_virtual_payload;
+  Block    m_content; // 所有数据包共享的Content
   Time     m_freshness;
 
   uint32_t m_signature;
@@ -107,9 +118,53 @@ private:
   uint32_t m_max_pitstore_size;
   uint32_t m_average_update_time;
   uint32_t m_expriment_time;
+  uint32_t m_warmup_time;
   uint32_t m_eligible_contents_number;
   uint32_t m_eligible_contents;
+  bool     m_aggregate_publications;
+
+  const std::string* m_eligibleContents; // 按EligibleContentsNumber选择的列表
+
+  // 内容的下次发布时间（整秒），按时间排序的最小堆。
+  // 表项删除后对应的发布时间留在堆中，出堆时丢弃。
+  struct PublishDeadline {
+    int      time;
+    uint64_t id;
+
+    bool operator>( const PublishDeadline& other ) const {
+      return time > other.time || ( time == other.time && id > other.id );
+    }
+  };
+
+  int DrawUpdateTime();
+
+  // 设置数据包的内容：共享的Content，或只记录长度的虚拟负载
+  void SetPayload( Data& data ) const;
+
+  shared_ptr<Data> MakePublication( const Name&        name,
+                                    const std::string& PITListBack,
+                                    int                expiration ) const;
+
+  void InsertEntry( PITListEntry entry );
+
+  void EraseEntry( std::list<PITListEntry>::iterator entry );
+
+  bool IsCurrent( const PublishDeadline& deadline ) const;
+
+  // 把发布事件安排在最早的发布时间
+  void ArmPublishTimer();
+
+  // 发布所有到期的内容，并重新分配其更新时间
+  void Publish();
+
+  std::priority_queue<PublishDeadline, std::vector<PublishDeadline>,
+                      std::greater<PublishDeadline>>
+      m_publishQueue;
+  std::unordered_map<uint64_t, std::list<PITListEntry>::iterator> m_entries;
+  uint64_t m_nextEntryId;
+  EventId  m_publishEvent;
 
+  Ptr<UniformRandomVariable> m_rand; // 每个生产者一个随机数流，结果可复现
 };
 
 } // namespace ndn
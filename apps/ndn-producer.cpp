@@ -20,6 +20,7 @@
 #include "ndn-producer.hpp"
 #include "ns3/log.h"
 #include "ns3/string.h"
+#include "ns3/boolean.h"
 #include "ns3/uinteger.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -28,6 +29,7 @@
 #include "model/ndn-ns3.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "utils/ndn-virtual-payload-tag.hpp"
 
 #include <memory>
 
@@ -55,6 +57,11 @@ Producer::GetTypeId(void)
       .AddAttribute("PayloadSize", "Virtual payload size for Content packets", UintegerValue(1024),
                     MakeUintegerAccessor(&Producer::m_virtualPayloadSize),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("VirtualPayload",
+                    "If true, Content of Data packets is empty and PayloadSize bytes are carried "
+                    "as zero-filled ns-3 packet payload, which takes no memory",
+                    BooleanValue(false), MakeBooleanAccessor(&Producer::m_isVirtualPayload),
+                    MakeBooleanChecker())
       .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
                     TimeValue(Seconds(0)), MakeTimeAccessor(&Producer::m_freshness),
                     MakeTimeChecker())
@@ -70,6 +77,7 @@ Producer::GetTypeId(void)
 }
 
 Producer::Producer()
+  : m_isVirtualPayload(false)
 {
   NS_LOG_FUNCTION_NOARGS();
 }
@@ -81,6 +89,12 @@ Producer::StartApplication()
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
+  if (!m_isVirtualPayload) {
+    // Content is encoded once and shared by all Data packets
+    ::ndn::Buffer payload(m_virtualPayloadSize);
+    m_content = ::ndn::makeBinaryBlock(::ndn::tlv::Content, payload.buf(), payload.size());
+  }
+
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
 }
 
@@ -110,7 +124,12 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  if (m_isVirtualPayload) {
+    data->setInlineTag(VirtualPayloadTag(m_virtualPayloadSize));
+  }
+  else {
+    data->setContent(m_content);
+  }
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
@@ -63,6 +63,8 @@ private:
   Name m_prefix;
   Name m_postfix;
   uint32_t m_virtualPayloadSize;
+  bool m_isVirtualPayload;
+  Block m_content;
   Time m_freshness;
 
   uint32_t m_signature;
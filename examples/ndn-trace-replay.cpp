@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-replay.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/utils/ndn-request-trace.hpp"
+
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * This scenario replays a request log on the topology of ndn-simple:
+ *
+ *      +----------+     1Mbps      +--------+     1Mbps      +----------+
+ *      | consumer | <------------> | router | <------------> | producer |
+ *      +----------+         10ms   +--------+          10ms  +----------+
+ *
+ * The log is a CSV file with `<time in seconds>,<name or sequence number>[,<user>]` lines
+ * (sequence numbers are appended to /prefix).  It is first converted into the binary request
+ * trace, which is then replayed by ConsumerTrace:
+ *
+ *     ./waf --run="ndn-trace-replay --csv=requests.csv --trace=requests.trace"
+ *
+ * To replay an already converted trace, omit --csv:
+ *
+ *     NS_LOG=ndn.ConsumerTrace ./waf --run="ndn-trace-replay --trace=requests.trace"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  // setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  std::string csv;
+  std::string trace = "requests.trace";
+  double duration = 100.0;
+
+  CommandLine cmd;
+  cmd.AddValue("csv", "CSV request log to convert into the trace", csv);
+  cmd.AddValue("trace", "Binary request trace to replay", trace);
+  cmd.AddValue("duration", "Duration of the simulation in seconds", duration);
+  cmd.Parse(argc, argv);
+
+  if (!csv.empty()) {
+    std::ifstream is(csv.c_str());
+    if (!is.good()) {
+      std::cerr << "Cannot open " << csv << std::endl;
+      return 1;
+    }
+    uint64_t nRecords = ndn::ConvertCsvToRequestTrace(is, trace);
+    std::cout << "Converted " << nRecords << " requests into " << trace << std::endl;
+  }
+
+  // Creating nodes
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  // Connecting nodes using two links
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  // Choosing forwarding strategy
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  // Consumer
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerTrace");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("TraceFile", StringValue(trace));
+  consumerHelper.Install(nodes.Get(0));
+
+  // Producer replies to all requests (names in the log may have any prefix)
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(2));
+
+  ndn::AppDelayTracer::InstallAll("app-delays-trace.txt");
+
+  Simulator::Stop(Seconds(duration));
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ *and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ *terms of the GNU General Public License as published by the Free Software
+ *Foundation, either version 3 of the License, or (at your option) any later
+ *version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ *WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ *A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ *<http://www.gnu.org/licenses/>.
+ **/
+
+// validation-subpub-torus-sweep.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndnSIM/helper/ndn-sweep-helper.hpp"
+
+using namespace std;
+
+namespace ns3 {
+
+// validation-subpub-torus的参数扫描：拓扑、协议栈和路由只建立一次，
+// 每个参数组合在fork出的子进程中运行，并发数不超过CPU核数
+int main( int argc, char *argv[] ) {
+  string experiment_time = "150";
+  int    max_workers     = 0;
+
+  CommandLine cmd;
+  cmd.AddValue( "workers", "并发子进程数，0表示CPU核数", max_workers );
+  cmd.Parse( argc, argv );
+
+  AnnotatedTopologyReader topologyReader( "", 1 );
+  topologyReader.SetFileName(
+      "src/ndnSIM/examples/topologies/torus-grid-5.txt" );
+  topologyReader.Read();
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setCsSize( 0 );
+  ndnHelper.SetOldContentStore( "ns3::ndn::cs::Lru", "MaxSize", "1" );
+  ndnHelper.InstallAll();
+
+  // Choosing forwarding strategy
+  ndn::StrategyChoiceHelper::InstallAll( "/prefix",
+                                         "/localhost/nfd/strategy/best-route" );
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  Ptr<Node>     producer = Names::Find<Node>( "12" );
+  NodeContainer consumerNodes;
+  consumerNodes.Add( Names::Find<Node>( std::to_string( 2 ) ) );
+  consumerNodes.Add( Names::Find<Node>( std::to_string( 7 ) ) );
+
+  ndnGlobalRoutingHelper.AddOrigins( "/prefix", producer );
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  ndn::SweepHelper sweep;
+  if ( max_workers > 0 ) {
+    sweep.setMaxWorkers( max_workers );
+  }
+  sweep.addParameter( "zipf", { "0.8", "1.0", "1.2" } );         // 齐普夫参数
+  sweep.addParameter( "cache_size", { "1", "10", "100" } );      // 缓存大小
+  sweep.addParameter( "request_rate", { "10", "20" } );          // 请求速率
+  sweep.addParameter( "average_update_time", { "1", "5", "20" } ); // 更新时间
+  sweep.addParameter( "pit_store_size", { "100", "1000" } );     // PITStore大小
+
+  size_t nFailed = sweep.run( [&]( const ndn::SweepHelper::Point &point,
+                                   const std::string &            suffix ) {
+    Config::Set( "/NodeList/*/$ns3::ndn::ContentStore/MaxSize",
+                 StringValue( point.at( "cache_size" ) ) );
+
+    // Consumer
+    ndn::AppHelper consumerHelper( "ns3::ndn::ConsumerZipfMandelbrotKan" );
+    consumerHelper.SetAttribute( "NumberOfContents", StringValue( "20" ) );
+    consumerHelper.SetAttribute( "q", StringValue( "0" ) );
+    consumerHelper.SetAttribute( "s", StringValue( point.at( "zipf" ) ) );
+    consumerHelper.SetAttribute( "Frequency",
+                                 StringValue( point.at( "request_rate" ) ) );
+    consumerHelper.SetPrefix( "/prefix" );
+    consumerHelper.Install( consumerNodes );
+
+    // Producer
+    ndn::AppHelper producerHelper( "ns3::ndn::ProducerKanV2" );
+    producerHelper.SetPrefix( "/prefix" );
+    producerHelper.SetAttribute( "PayloadSize", StringValue( "1024" ) );
+    producerHelper.SetAttribute(
+        "AverageUpdateTime", StringValue( point.at( "average_update_time" ) ) );
+    producerHelper.SetAttribute( "MaxPITStoreSize",
+                                 StringValue( point.at( "pit_store_size" ) ) );
+    producerHelper.SetAttribute( "ExprimentTime",
+                                 StringValue( experiment_time ) );
+    producerHelper.Install( producer );
+
+    Simulator::Stop( Seconds( stod( experiment_time ) ) );
+
+    ndn::L3RateTracer::InstallAll( "rate-trace-SubPub_" + suffix + ".txt",
+                                   Seconds( 1.0 ) );
+    ndn::CsTracer::InstallAll( "cs-trace-SubPub_" + suffix + ".txt",
+                               Seconds( 1 ) );
+
+    Simulator::Run();
+    Simulator::Destroy();
+  } );
+
+  return nFailed == 0 ? 0 : 1;
+}
+
+} // namespace ns3
+
+int main( int argc, char *argv[] ) { return ns3::main( argc, argv ); }
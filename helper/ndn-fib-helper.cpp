@@ -38,7 +38,11 @@
 #include "ns3/node-list.h"
 #include "ns3/data-rate.h"
 
+#include <algorithm>
+
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/table/fib.hpp"
+#include "daemon/fw/forwarder.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
@@ -51,37 +55,31 @@ NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
-  NS_LOG_DEBUG("Add Next Hop command was initialized");
-  Block encodedParameters(parameters.wireEncode());
-
-  Name commandName("/localhost/nfd/fib");
-  commandName.append("add-nexthop");
-  commandName.append(encodedParameters);
-
-  shared_ptr<Interest> command(make_shared<Interest>(commandName));
-  StackHelper::getKeyChain().sign(*command);
+  // trusted in-process channel: no command Interest, signing and validation
+  static const Name::Component VERB("add-nexthop");
 
   Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   shared_ptr<nfd::FibManager> fibManager = l3protocol->getFibManager();
-  fibManager->onFibRequest(*command);
+  nfd::ControlResponse response = fibManager->executeTrustedCommand(VERB, parameters);
+  if (response.getCode() != 200) {
+    NS_LOG_ERROR("add-nexthop on node " << node->GetId() << " failed: " << response.getCode()
+                 << " " << response.getText());
+  }
 }
 
 void
 FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
-  NS_LOG_DEBUG("Remove Next Hop command was initialized");
-  Block encodedParameters(parameters.wireEncode());
+  // trusted in-process channel: no command Interest, signing and validation
+  static const Name::Component VERB("remove-nexthop");
 
-  Name commandName("/localhost/nfd/fib");
-  commandName.append("remove-nexthop");
-  commandName.append(encodedParameters);
-
-  shared_ptr<Interest> command(make_shared<Interest>(commandName));
-  StackHelper::getKeyChain().sign(*command);
-
-  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
-  shared_ptr<nfd::FibManager> fibManager = L3protocol->getFibManager();
-  fibManager->onFibRequest(*command);
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  shared_ptr<nfd::FibManager> fibManager = l3protocol->getFibManager();
+  nfd::ControlResponse response = fibManager->executeTrustedCommand(VERB, parameters);
+  if (response.getCode() != 200) {
+    NS_LOG_ERROR("remove-nexthop on node " << node->GetId() << " failed: " << response.getCode()
+                 << " " << response.getText());
+  }
 }
 
 void
@@ -259,6 +257,74 @@ FibHelper::RemoveRoute(const std::string& nodeName, const Name& prefix,
   RemoveRoute(node, prefix, otherNode);
 }
 
+void
+FibHelper::Batch::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face,
+                           int32_t metric)
+{
+  NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << prefix << " via " << face->getLocalUri()
+                   << " metric " << metric << " (batched)");
+
+  m_changes[node->GetId()][prefix][face] = NextHop{false, metric};
+}
+
+void
+FibHelper::Batch::RemoveRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face)
+{
+  m_changes[node->GetId()][prefix][face] = NextHop{true, 0};
+}
+
+size_t
+FibHelper::Batch::GetSize() const
+{
+  size_t size = 0;
+  for (const auto& node : m_changes) {
+    for (const auto& prefix : node.second) {
+      size += prefix.second.size();
+    }
+  }
+  return size;
+}
+
+void
+FibHelper::Batch::Commit()
+{
+  for (const auto& node : m_changes) {
+    Ptr<L3Protocol> ndn = NodeList::GetNode(node.first)->GetObject<L3Protocol>();
+    NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+    nfd::Fib& fib = ndn->getForwarder()->getFib();
+
+    // names are ordered canonically, so entries of shorter prefixes are created first
+    for (const auto& prefix : node.second) {
+      bool hasAdditions = std::any_of(prefix.second.begin(), prefix.second.end(),
+                                      [] (const NextHops::value_type& nextHop) {
+                                        return !nextHop.second.isRemoved;
+                                      });
+
+      shared_ptr<nfd::fib::Entry> entry = hasAdditions ? fib.insert(prefix.first).first
+                                                       : fib.findExactMatch(prefix.first);
+      if (entry == nullptr) {
+        continue;
+      }
+
+      for (const auto& nextHop : prefix.second) {
+        if (nextHop.second.isRemoved) {
+          entry->removeNextHop(nextHop.first);
+        }
+        else {
+          entry->addNextHop(nextHop.first, nextHop.second.metric);
+        }
+      }
+
+      if (!entry->hasNextHops()) {
+        fib.erase(*entry);
+      }
+    }
+  }
+
+  NS_LOG_DEBUG("Committed " << GetSize() << " FIB changes");
+  m_changes.clear();
+}
+
 } // namespace ndn
 
 } // namespace ns
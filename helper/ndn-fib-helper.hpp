@@ -29,6 +29,8 @@
 
 #include <ndn-cxx/management/nfd-control-parameters.hpp>
 
+#include <map>
+
 namespace ns3 {
 namespace ndn {
 
@@ -38,9 +40,10 @@ using ::ndn::nfd::ControlParameters;
  * @ingroup ndn-helpers
  * @brief Forwarding Information Base (FIB) helper
  *
- * The FIB helper interacts with the FIB manager of NFD by sending special Interest
- * commands to the manager in order to add/remove a next hop from FIB entries or add
- * routes to the FIB manually (manual configuration of FIB).
+ * The FIB helper interacts with the FIB manager of NFD in order to add/remove a next hop from
+ * FIB entries or add routes to the FIB manually (manual configuration of FIB).  Commands are
+ * passed to the manager directly, as from a trusted in-process caller, without encoding,
+ * signing, and validation of command Interests.
  */
 class FibHelper {
 public:
@@ -151,6 +154,61 @@ public:
   static void
   RemoveRoute(const std::string& nodeName, const Name& prefix, const std::string& otherNodeName);
 
+public:
+  /**
+   * @brief Batch of FIB changes on many nodes, applied at once
+   *
+   * Route changes are collected per node and prefix: a later change of the same next hop
+   * replaces an earlier one.  Commit applies them directly to the FIB of every node, in
+   * canonical order of prefixes, with one FIB (NameTree) lookup per prefix and without command
+   * Interests, which makes installation of many routes (e.g., by GlobalRoutingHelper) much
+   * faster than individual AddRoute calls.
+   *
+   * \code
+   * FibHelper::Batch batch;
+   * batch.AddRoute(node, "/prefix", face, 1);
+   * ...
+   * batch.Commit();
+   * \endcode
+   */
+  class Batch {
+  public:
+    /**
+     * \brief Add forwarding entry to the batch
+     */
+    void
+    AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric);
+
+    /**
+     * \brief Add removal of forwarding entry to the batch
+     */
+    void
+    RemoveRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face);
+
+    /**
+     * \brief Apply all changes of the batch and clear it
+     */
+    void
+    Commit();
+
+    /**
+     * \brief Get number of next hop changes in the batch
+     */
+    size_t
+    GetSize() const;
+
+  private:
+    struct NextHop {
+      bool isRemoved;
+      int32_t metric;
+    };
+
+    typedef std::map<shared_ptr<Face>, NextHop> NextHops;
+
+    // node id -> prefix -> next hop changes
+    std::map<uint32_t, std::map<Name, NextHops>> m_changes;
+  };
+
 private:
   static void
   GenerateCommand(Interest& interest);
@@ -53,6 +53,8 @@
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 
 #include <unordered_map>
+#include <queue>
+#include <set>
 
 #include "boost-graph-ndn-global-routing-helper.hpp"
 
@@ -63,6 +65,323 @@ NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 namespace ns3 {
 namespace ndn {
 
+namespace {
+
+const uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+typedef std::map<Ptr<GlobalRouter>, GlobalRouter::PathEntry> OldPathEntries;
+typedef std::map<Name, std::list<Ptr<GlobalRouter>>> OriginIndex;
+typedef std::priority_queue<std::pair<uint32_t, Ptr<GlobalRouter>>,
+                            std::vector<std::pair<uint32_t, Ptr<GlobalRouter>>>,
+                            std::greater<std::pair<uint32_t, Ptr<GlobalRouter>>>> PathQueue;
+
+uint32_t
+getWeight(const GlobalRouter::Incidency& edge)
+{
+  // the same weight as used by boost::EdgeWeights
+  if (std::get<1>(edge) == nullptr)
+    return 0;
+  else
+    return static_cast<uint16_t>(std::get<1>(edge)->getMetric());
+}
+
+/**
+ * @brief Set new path to @p vertex, remembering the original entry for the FIB update
+ */
+void
+setPath(GlobalRouter::ShortestPathTree& tree, OldPathEntries& oldEntries,
+        Ptr<GlobalRouter> vertex, const GlobalRouter::PathEntry& entry)
+{
+  auto i = tree.find(vertex);
+  if (i == tree.end()) {
+    oldEntries.insert(std::make_pair(vertex, GlobalRouter::PathEntry(Ptr<GlobalRouter>(), nullptr,
+                                                                     UNREACHABLE)));
+    tree.insert(std::make_pair(vertex, entry));
+  }
+  else {
+    oldEntries.insert(std::make_pair(vertex, i->second));
+    i->second = entry;
+  }
+}
+
+/**
+ * @brief Try to improve path to the target of @p edge through its source
+ */
+void
+relax(Ptr<GlobalRouter> root, GlobalRouter::ShortestPathTree& tree, OldPathEntries& oldEntries,
+      const GlobalRouter::Incidency& edge, PathQueue& queue)
+{
+  Ptr<GlobalRouter> from = std::get<0>(edge);
+  Ptr<GlobalRouter> to = std::get<2>(edge);
+
+  auto fromEntry = tree.find(from);
+  if (fromEntry == tree.end())
+    return;
+
+  uint32_t distance = std::get<2>(fromEntry->second) + getWeight(edge);
+  auto toEntry = tree.find(to);
+  if (toEntry != tree.end() && std::get<2>(toEntry->second) <= distance)
+    return;
+
+  shared_ptr<Face> firstHop = from == root ? std::get<1>(edge) : std::get<1>(fromEntry->second);
+  setPath(tree, oldEntries, to, GlobalRouter::PathEntry(from, firstHop, distance));
+  queue.push(std::make_pair(distance, to));
+}
+
+/**
+ * @brief Dijkstra continuation from already seeded @p queue
+ */
+void
+propagate(Ptr<GlobalRouter> root, GlobalRouter::ShortestPathTree& tree, OldPathEntries& oldEntries,
+          PathQueue& queue)
+{
+  while (!queue.empty()) {
+    std::pair<uint32_t, Ptr<GlobalRouter>> top = queue.top();
+    queue.pop();
+
+    auto entry = tree.find(top.second);
+    if (entry == tree.end() || std::get<2>(entry->second) != top.first)
+      continue; // stale queue record
+
+    for (const auto& edge : top.second->GetIncidencies()) {
+      relax(root, tree, oldEntries, edge, queue);
+    }
+  }
+}
+
+/**
+ * @brief Recompute subtrees of @p root's shortest path tree hanging off the failed link a--b
+ */
+void
+repairAfterLinkDown(Ptr<GlobalRouter> root, Ptr<GlobalRouter> a, Ptr<GlobalRouter> b,
+                    OldPathEntries& oldEntries)
+{
+  GlobalRouter::ShortestPathTree& tree = root->GetShortestPathTree();
+
+  std::list<Ptr<GlobalRouter>> detached;
+  auto entryA = tree.find(a);
+  auto entryB = tree.find(b);
+  if (entryB != tree.end() && std::get<0>(entryB->second) == a)
+    detached.push_back(b);
+  if (entryA != tree.end() && std::get<0>(entryA->second) == b)
+    detached.push_back(a);
+
+  if (detached.empty())
+    return; // the tree does not use the link
+
+  std::map<Ptr<GlobalRouter>, std::list<Ptr<GlobalRouter>>> children;
+  for (const auto& entry : tree) {
+    if (std::get<0>(entry.second) != 0)
+      children[std::get<0>(entry.second)].push_back(entry.first);
+  }
+
+  // detach affected subtrees
+  std::set<Ptr<GlobalRouter>> affected;
+  while (!detached.empty()) {
+    Ptr<GlobalRouter> vertex = detached.front();
+    detached.pop_front();
+    if (!affected.insert(vertex).second)
+      continue;
+
+    auto i = tree.find(vertex);
+    oldEntries.insert(*i);
+    tree.erase(i);
+
+    auto c = children.find(vertex);
+    if (c != children.end())
+      detached.insert(detached.end(), c->second.begin(), c->second.end());
+  }
+
+  // reattach through the best remaining edges from unaffected part of the tree
+  // (graph is symmetric: every incidency has a reverse one)
+  PathQueue queue;
+  for (const auto& vertex : affected) {
+    for (const auto& edge : vertex->GetIncidencies()) {
+      Ptr<GlobalRouter> neighbor = std::get<2>(edge);
+      if (affected.count(neighbor) > 0)
+        continue;
+
+      for (const auto& reverse : neighbor->GetIncidencies()) {
+        if (std::get<2>(reverse) == vertex)
+          relax(root, tree, oldEntries, reverse, queue);
+      }
+    }
+  }
+
+  propagate(root, tree, oldEntries, queue);
+}
+
+/**
+ * @brief Propagate paths that become shorter through the restored link a--b
+ */
+void
+repairAfterLinkUp(Ptr<GlobalRouter> root, Ptr<GlobalRouter> a, Ptr<GlobalRouter> b,
+                  OldPathEntries& oldEntries)
+{
+  GlobalRouter::ShortestPathTree& tree = root->GetShortestPathTree();
+
+  PathQueue queue;
+  for (const auto& edge : a->GetIncidencies()) {
+    if (std::get<2>(edge) == b)
+      relax(root, tree, oldEntries, edge, queue);
+  }
+  for (const auto& edge : b->GetIncidencies()) {
+    if (std::get<2>(edge) == a)
+      relax(root, tree, oldEntries, edge, queue);
+  }
+
+  propagate(root, tree, oldEntries, queue);
+}
+
+typedef std::map<shared_ptr<Face>, uint32_t> NextHops;
+typedef std::map<Name, NextHops> PrefixNextHops;
+
+/**
+ * @brief Add next hop @p face with @p cost, keeping the lower cost if @p face is already there
+ *
+ * Several origins of a prefix can be reached through the same face.  Both the full route
+ * calculation and the incremental repair use this rule, so they install the same FIB.
+ */
+void
+addNextHop(NextHops& nextHops, shared_ptr<Face> face, uint32_t cost)
+{
+  auto nextHop = nextHops.insert(std::make_pair(face, cost));
+  if (!nextHop.second)
+    nextHop.first->second = std::min(nextHop.first->second, cost);
+}
+
+/**
+ * @brief Add the collected @p routes of @p node to @p batch
+ */
+void
+addRoutes(FibHelper::Batch& batch, Ptr<Node> node, const PrefixNextHops& routes)
+{
+  for (const auto& route : routes) {
+    for (const auto& nextHop : route.second) {
+      batch.AddRoute(node, route.first, nextHop.first, nextHop.second);
+    }
+  }
+}
+
+/**
+ * @brief Best next hops (face -> cost) towards all origins of @p prefix
+ */
+NextHops
+getNextHops(Ptr<GlobalRouter> root, const std::list<Ptr<GlobalRouter>>& origins,
+            const OldPathEntries* oldEntries)
+{
+  NextHops nextHops;
+
+  const GlobalRouter::ShortestPathTree& tree = root->GetShortestPathTree();
+  for (const auto& origin : origins) {
+    if (origin == root)
+      continue;
+
+    const GlobalRouter::PathEntry* entry = nullptr;
+    if (oldEntries != nullptr) {
+      auto i = oldEntries->find(origin);
+      if (i != oldEntries->end())
+        entry = &i->second;
+    }
+    if (entry == nullptr) {
+      auto i = tree.find(origin);
+      if (i != tree.end())
+        entry = &i->second;
+    }
+
+    if (entry == nullptr || std::get<1>(*entry) == nullptr)
+      continue;
+
+    addNextHop(nextHops, std::get<1>(*entry), std::get<2>(*entry));
+  }
+
+  return nextHops;
+}
+
+/**
+ * @brief Patch FIB of @p root's node for prefixes of vertices whose paths have changed
+ */
+void
+updateFib(Ptr<GlobalRouter> root, const OldPathEntries& oldEntries, const OriginIndex& origins,
+          FibHelper::Batch& batch)
+{
+  std::set<Name> prefixes;
+  for (const auto& entry : oldEntries) {
+    for (const auto& prefix : entry.first->GetLocalPrefixes()) {
+      prefixes.insert(*prefix);
+    }
+  }
+
+  Ptr<Node> node = root->GetObject<Node>();
+  for (const auto& prefix : prefixes) {
+    const std::list<Ptr<GlobalRouter>>& prefixOrigins = origins.find(prefix)->second;
+
+    NextHops oldNextHops = getNextHops(root, prefixOrigins, &oldEntries);
+    NextHops newNextHops = getNextHops(root, prefixOrigins, nullptr);
+
+    for (const auto& nextHop : oldNextHops) {
+      if (newNextHops.count(nextHop.first) == 0) {
+        NS_LOG_DEBUG("Node " << node->GetId() << ": prefix " << prefix
+                     << " is no longer reachable via face " << *nextHop.first);
+        batch.RemoveRoute(node, prefix, nextHop.first);
+      }
+    }
+
+    for (const auto& nextHop : newNextHops) {
+      auto old = oldNextHops.find(nextHop.first);
+      if (old == oldNextHops.end() || old->second != nextHop.second) {
+        NS_LOG_DEBUG("Node " << node->GetId() << ": prefix " << prefix << " reachable via face "
+                     << *nextHop.first << " with distance " << nextHop.second);
+        batch.AddRoute(node, prefix, nextHop.first, nextHop.second);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Repair routes of all nodes after the change of the link a--b
+ */
+void
+repairRoutes(Ptr<GlobalRouter> a, Ptr<GlobalRouter> b, bool isUp)
+{
+  OriginIndex origins;
+  bool hasOrigins = false;
+  FibHelper::Batch batch;
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> root = (*node)->GetObject<GlobalRouter>();
+    if (root == 0 || root->GetShortestPathTree().empty())
+      continue; // routes were not calculated for this node
+
+    OldPathEntries oldEntries;
+    if (isUp)
+      repairAfterLinkUp(root, a, b, oldEntries);
+    else
+      repairAfterLinkDown(root, a, b, oldEntries);
+
+    if (oldEntries.empty())
+      continue;
+
+    if (!hasOrigins) {
+      for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); i++) {
+        Ptr<GlobalRouter> gr = (*i)->GetObject<GlobalRouter>();
+        if (gr == 0)
+          continue;
+        for (const auto& prefix : gr->GetLocalPrefixes()) {
+          origins[*prefix].push_back(gr);
+        }
+      }
+      hasOrigins = true;
+    }
+
+    updateFib(root, oldEntries, origins, batch);
+  }
+
+  batch.Commit();
+}
+
+} // anonymous namespace
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -228,6 +547,9 @@ GlobalRoutingHelper::CalculateRoutes()
   boost::NdnGlobalRouterGraph graph;
   // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
 
+  // routes of all nodes are installed at once
+  FibHelper::Batch batch;
+
   // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
   // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
   // the graph, which
@@ -240,11 +562,11 @@ GlobalRoutingHelper::CalculateRoutes()
     }
 
     boost::DistancesMap distances;
+    boost::PredecessorsMap predecessors;
 
     dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
+                            predecessor_map(boost::ref(predecessors))
+                              .distance_map(boost::ref(distances))
                               .distance_inf(boost::WeightInf)
                               .distance_zero(boost::WeightZero)
                               .distance_compare(boost::WeightCompare())
@@ -255,6 +577,12 @@ GlobalRoutingHelper::CalculateRoutes()
     Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
     shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
 
+    // remember the tree, so it can be repaired incrementally when links go down or up
+    GlobalRouter::ShortestPathTree& tree = source->GetShortestPathTree();
+    tree.clear();
+    tree[source] = GlobalRouter::PathEntry(Ptr<GlobalRouter>(), nullptr, 0);
+
+    PrefixNextHops routes;
     NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
     for (const auto& dist : distances) {
       if (dist.first == source)
@@ -265,18 +593,24 @@ GlobalRoutingHelper::CalculateRoutes()
           // cout << " is unreachable" << endl;
         }
         else {
+          tree[dist.first] = GlobalRouter::PathEntry(predecessors[dist.first],
+                                                     std::get<0>(dist.second),
+                                                     std::get<1>(dist.second));
+
           for (const auto& prefix : dist.first->GetLocalPrefixes()) {
             NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
                          << " with distance " << std::get<1>(dist.second) << " with delay "
                          << std::get<2>(dist.second));
 
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
+            addNextHop(routes[*prefix], std::get<0>(dist.second), std::get<1>(dist.second));
           }
         }
       }
     }
+    addRoutes(batch, *node, routes);
   }
+
+  batch.Commit();
 }
 
 void
@@ -293,6 +627,9 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes()
   boost::NdnGlobalRouterGraph graph;
   // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
 
+  // routes of all nodes are installed at once
+  FibHelper::Batch batch;
+
   // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
   // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
   // the graph, which
@@ -324,6 +661,7 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes()
       // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
     }
 
+    PrefixNextHops routes;
     for (auto& faceId : faceIds) {
       shared_ptr<Face> k = l3->getForwarder()->getFaceTable().get(faceId);
       shared_ptr<NetDeviceFace> face = std::dynamic_pointer_cast<NetDeviceFace>(k);
@@ -368,8 +706,7 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes()
               if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
                 continue;
 
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
+              addNextHop(routes[*prefix], std::get<0>(dist.second), std::get<1>(dist.second));
             }
           }
         }
@@ -383,7 +720,54 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes()
     for (auto& i : originalMetrics) {
       l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
     }
+
+    addRoutes(batch, *node, routes);
   }
+
+  batch.Commit();
+}
+
+void
+GlobalRoutingHelper::UpdateRoutesOnLinkDown(Ptr<Node> node1, shared_ptr<Face> face1,
+                                            Ptr<Node> node2, shared_ptr<Face> face2)
+{
+  Ptr<GlobalRouter> gr1 = node1->GetObject<GlobalRouter>();
+  Ptr<GlobalRouter> gr2 = node2->GetObject<GlobalRouter>();
+  if (gr1 == 0 || gr2 == 0) {
+    NS_LOG_DEBUG("GlobalRouter is not installed on the nodes, nothing to update");
+    return;
+  }
+
+  // both sides are checked first, so that the graph is not left with only one direction changed
+  if (!gr1->HasIncidency(face1) || !gr2->HasIncidency(face2)) {
+    NS_LOG_DEBUG("Link is already down");
+    return;
+  }
+  gr1->DisableIncidency(face1);
+  gr2->DisableIncidency(face2);
+
+  repairRoutes(gr1, gr2, false);
+}
+
+void
+GlobalRoutingHelper::UpdateRoutesOnLinkUp(Ptr<Node> node1, shared_ptr<Face> face1,
+                                          Ptr<Node> node2, shared_ptr<Face> face2)
+{
+  Ptr<GlobalRouter> gr1 = node1->GetObject<GlobalRouter>();
+  Ptr<GlobalRouter> gr2 = node2->GetObject<GlobalRouter>();
+  if (gr1 == 0 || gr2 == 0) {
+    NS_LOG_DEBUG("GlobalRouter is not installed on the nodes, nothing to update");
+    return;
+  }
+
+  if (!gr1->HasDisabledIncidency(face1) || !gr2->HasDisabledIncidency(face2)) {
+    NS_LOG_DEBUG("Link is already up");
+    return;
+  }
+  gr1->EnableIncidency(face1);
+  gr2->EnableIncidency(face2);
+
+  repairRoutes(gr1, gr2, true);
 }
 
 } // namespace ndn
@@ -21,6 +21,7 @@
 #define NDN_GLOBAL_ROUTING_HELPER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-face.hpp"
 
 #include "ns3/ptr.h"
 
@@ -111,6 +112,37 @@ public:
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Incrementally repair routes after the link between two nodes went down
+   *
+   * The link is excluded from the graph.  For every node, whose shortest path tree (computed
+   * by CalculateRoutes) used the link, only the affected subtree is recomputed and only FIB
+   * next hops that actually changed are updated.
+   *
+   * @param node1 one node
+   * @param face1 face of node1 that belongs to the link
+   * @param node2 another node
+   * @param face2 face of node2 that belongs to the link
+   */
+  static void
+  UpdateRoutesOnLinkDown(Ptr<Node> node1, shared_ptr<Face> face1,
+                         Ptr<Node> node2, shared_ptr<Face> face2);
+
+  /**
+   * @brief Incrementally repair routes after the link between two nodes went up again
+   *
+   * The link is returned back to the graph and shortest paths that become shorter through the
+   * link are propagated; only FIB next hops that actually changed are updated.
+   *
+   * @param node1 one node
+   * @param face1 face of node1 that belongs to the link
+   * @param node2 another node
+   * @param face2 face of node2 that belongs to the link
+   */
+  static void
+  UpdateRoutesOnLinkUp(Ptr<Node> node1, shared_ptr<Face> face1,
+                       Ptr<Node> node2, shared_ptr<Face> face2);
+
 private:
   void
   Install(Ptr<Channel> channel);
@@ -33,6 +33,7 @@
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-face.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
 
 #include "fw/forwarder.hpp"
 
@@ -84,6 +85,15 @@ LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRa
 
       nd1->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
       nd2->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
+
+      // keep routes calculated by GlobalRoutingHelper in sync with the link status
+      shared_ptr<Face> otherFace = ndn2->getFaceByNetDevice(nd2);
+      if (errorRate >= 1.0) {
+        GlobalRoutingHelper::UpdateRoutesOnLinkDown(node1, ndFace, node2, otherFace);
+      }
+      else {
+        GlobalRoutingHelper::UpdateRoutesOnLinkUp(node1, ndFace, node2, otherFace);
+      }
       return;
     }
   }
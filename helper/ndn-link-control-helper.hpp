@@ -41,6 +41,9 @@ public:
    * The helper will attempt to find NDN link between node1 and
    * node2 and set NDN face to DOWN state
    *
+   * If routes were calculated with GlobalRoutingHelper::CalculateRoutes, they are
+   * incrementally repaired to avoid the failed link
+   *
    * Note that only PointToPointChannels are supported by this helper method
    *
    * @param node1 one node
@@ -71,6 +74,9 @@ public:
    * The helper will attempt to find NDN link between node1 and
    * node2 and set NDN face to UP state
    *
+   * If routes were calculated with GlobalRoutingHelper::CalculateRoutes, they are
+   * incrementally updated to use the restored link
+   *
    * Note that only PointToPointChannels are supported by this helper method
    *
    * @param node1 one node
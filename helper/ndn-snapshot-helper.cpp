@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-snapshot-helper.hpp"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/apps/ndn-app.hpp"
+#include "ns3/ndnSIM/utils/ndn-virtual-payload-tag.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SnapshotHelper");
+
+namespace ns3 {
+namespace ndn {
+
+static const std::string SNAPSHOT_MAGIC = "ndnSIM-snapshot";
+static const int64_t SNAPSHOT_VERSION = 1;
+
+static void
+writeData(std::ostream& os, const Data& data)
+{
+  const Block& wire = data.wireEncode();
+  SnapshotHelper::WriteString(os, std::string(reinterpret_cast<const char*>(wire.wire()),
+                                              wire.size()));
+
+  const VirtualPayloadTag* payloadTag = data.findTag<VirtualPayloadTag>();
+  SnapshotHelper::WriteNumber(os, payloadTag != nullptr ? payloadTag->getSize() : 0);
+}
+
+static shared_ptr<Data>
+readData(std::istream& is)
+{
+  std::string wire = SnapshotHelper::ReadString(is);
+  auto data = make_shared<Data>(Block(reinterpret_cast<const uint8_t*>(wire.data()), wire.size()));
+
+  int64_t payloadSize = SnapshotHelper::ReadNumber(is);
+  if (payloadSize > 0) {
+    data->setInlineTag(VirtualPayloadTag(payloadSize));
+  }
+  return data;
+}
+
+void
+SnapshotHelper::Save(const std::string& file, Time when)
+{
+  Simulator::Schedule(when - Simulator::Now(), &SnapshotHelper::SaveNow, file);
+}
+
+void
+SnapshotHelper::SaveNow(const std::string& file)
+{
+  std::ofstream os(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Snapshot is not saved");
+    return;
+  }
+
+  WriteString(os, SNAPSHOT_MAGIC);
+  WriteNumber(os, SNAPSHOT_VERSION);
+  WriteNumber(os, NodeList::GetNNodes());
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    WriteNumber(os, (*node)->GetId());
+
+    // ndnSIM content store, in the order in which the Data is added back on restore
+    std::vector<Ptr<cs::Entry>> cached;
+    Ptr<ContentStore> cs = (*node)->GetObject<ContentStore>();
+    if (cs != nullptr) {
+      cached = cs->GetEntriesInPolicyOrder();
+    }
+    WriteNumber(os, cached.size());
+    for (const auto& entry : cached) {
+      writeData(os, *entry->GetData());
+    }
+
+    // NFD content store
+    Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
+    if (l3 != nullptr) {
+      const nfd::Cs& nfdCs = l3->getForwarder()->getCs();
+      WriteNumber(os, nfdCs.size());
+      for (const nfd::cs::Entry& entry : nfdCs) {
+        writeData(os, entry.getData());
+        WriteNumber(os, entry.isUnsolicited());
+      }
+    }
+    else {
+      WriteNumber(os, 0);
+    }
+
+    // applications
+    std::vector<std::pair<uint32_t, Ptr<App>>> apps;
+    for (uint32_t i = 0; i < (*node)->GetNApplications(); i++) {
+      Ptr<App> app = DynamicCast<App>((*node)->GetApplication(i));
+      if (app != nullptr) {
+        apps.push_back(std::make_pair(i, app));
+      }
+    }
+    WriteNumber(os, apps.size());
+    for (const auto& app : apps) {
+      WriteNumber(os, app.first);
+      WriteString(os, app.second->GetInstanceTypeId().GetName());
+
+      std::ostringstream state;
+      app.second->SaveState(state);
+      WriteString(os, state.str());
+    }
+  }
+
+  NS_LOG_INFO("Snapshot of " << NodeList::GetNNodes() << " nodes saved to " << file);
+}
+
+void
+SnapshotHelper::Restore(const std::string& file)
+{
+  std::ifstream is(file.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    NS_FATAL_ERROR("Snapshot file " << file << " cannot be opened");
+  }
+
+  try {
+    if (ReadString(is) != SNAPSHOT_MAGIC || ReadNumber(is) != SNAPSHOT_VERSION) {
+      NS_FATAL_ERROR("File " << file << " is not a snapshot of this version");
+    }
+    if (ReadNumber(is) != static_cast<int64_t>(NodeList::GetNNodes())) {
+      NS_FATAL_ERROR("Snapshot " << file << " was saved for a different number of nodes");
+    }
+
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      if (ReadNumber(is) != static_cast<int64_t>((*node)->GetId())) {
+        NS_FATAL_ERROR("Snapshot " << file << " does not match node " << (*node)->GetId());
+      }
+
+      // ndnSIM content store
+      Ptr<ContentStore> cs = (*node)->GetObject<ContentStore>();
+      for (int64_t i = ReadNumber(is); i > 0; i--) {
+        shared_ptr<Data> data = readData(is);
+        if (cs != nullptr) {
+          cs->Add(data);
+        }
+      }
+
+      // NFD content store
+      Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
+      for (int64_t i = ReadNumber(is); i > 0; i--) {
+        shared_ptr<Data> data = readData(is);
+        bool isUnsolicited = ReadNumber(is) != 0;
+        if (l3 != nullptr) {
+          l3->getForwarder()->getCs().insert(*data, isUnsolicited);
+        }
+      }
+
+      // applications
+      for (int64_t i = ReadNumber(is); i > 0; i--) {
+        uint32_t index = ReadNumber(is);
+        std::string typeName = ReadString(is);
+        std::istringstream state(ReadString(is));
+
+        Ptr<App> app;
+        if (index < (*node)->GetNApplications()) {
+          app = DynamicCast<App>((*node)->GetApplication(index));
+        }
+        if (app == nullptr || app->GetInstanceTypeId().GetName() != typeName) {
+          NS_FATAL_ERROR("Snapshot " << file << " does not match application " << index
+                                     << " (" << typeName << ") of node " << (*node)->GetId());
+        }
+        app->RestoreState(state);
+      }
+    }
+  }
+  catch (const std::runtime_error& e) {
+    NS_FATAL_ERROR("Snapshot " << file << " cannot be read: " << e.what());
+  }
+
+  NS_LOG_INFO("Snapshot of " << NodeList::GetNNodes() << " nodes restored from " << file);
+}
+
+void
+SnapshotHelper::WriteNumber(std::ostream& os, int64_t value)
+{
+  // zigzag and base-128 encoding: small numbers of either sign take one byte
+  uint64_t bits = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  while (bits >= 0x80) {
+    os.put(static_cast<char>((bits & 0x7f) | 0x80));
+    bits >>= 7;
+  }
+  os.put(static_cast<char>(bits));
+}
+
+int64_t
+SnapshotHelper::ReadNumber(std::istream& is)
+{
+  uint64_t bits = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = is.get();
+    if (byte == std::char_traits<char>::eof()) {
+      throw std::runtime_error("Unexpected end of snapshot");
+    }
+    bits |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return static_cast<int64_t>(bits >> 1) ^ -static_cast<int64_t>(bits & 1);
+    }
+  }
+  throw std::runtime_error("Malformed number in snapshot");
+}
+
+void
+SnapshotHelper::WriteString(std::ostream& os, const std::string& value)
+{
+  WriteNumber(os, value.size());
+  os.write(value.data(), value.size());
+}
+
+std::string
+SnapshotHelper::ReadString(std::istream& is)
+{
+  int64_t size = ReadNumber(is);
+  if (size < 0) {
+    throw std::runtime_error("Malformed string in snapshot");
+  }
+
+  std::string value(size, '\0');
+  if (!is.read(&value[0], size)) {
+    throw std::runtime_error("Unexpected end of snapshot");
+  }
+  return value;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SNAPSHOT_HELPER_HPP
+#define NDN_SNAPSHOT_HELPER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <iosfwd>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to save warm state of a simulation and to restore it in later runs
+ *
+ * The snapshot is a compact binary file with the state of every node:
+ * - Data packets of ndnSIM ContentStore (entries that are not invalidated)
+ * - Data packets of NFD's Cs
+ * - state of ndnSIM applications, as saved by App::SaveState (e.g., PITListStore of
+ *   ProducerKanV2 or sequence numbers of consumers)
+ *
+ * A run of the scenario saves the state after the warm-up period:
+ *
+ *     ndn::SnapshotHelper::Save("warm-state.bin", Seconds(40.0));
+ *
+ * Later runs of the same scenario (same topology, stack and applications, installed in the same
+ * order) restore the state before Simulator::Run and start measuring immediately:
+ *
+ *     ndn::SnapshotHelper::Restore("warm-state.bin");
+ *     Simulator::Run();
+ *
+ * Times in the state of applications are saved relative to the time of the snapshot and restored
+ * relative to the time of restoration.  States of random variable streams cannot be extracted
+ * from ns-3 and are not saved: restored runs continue with streams defined by the run number.
+ */
+class SnapshotHelper
+{
+public:
+  /**
+   * @brief Schedule saving of the state of all nodes at the given simulation time
+   */
+  static void
+  Save(const std::string& file, Time when);
+
+  /**
+   * @brief Save the state of all nodes now
+   */
+  static void
+  SaveNow(const std::string& file);
+
+  /**
+   * @brief Restore the state of all nodes from the snapshot file
+   *
+   * Should be called after the stack and applications are installed.  The simulation stops with
+   * an error if the snapshot cannot be read or was saved for a different scenario.
+   */
+  static void
+  Restore(const std::string& file);
+
+public:
+  /**
+   * @brief Write signed number in variable-length encoding
+   */
+  static void
+  WriteNumber(std::ostream& os, int64_t value);
+
+  /**
+   * @brief Read signed number in variable-length encoding
+   * @throw std::runtime_error if the stream ends
+   */
+  static int64_t
+  ReadNumber(std::istream& is);
+
+  static void
+  WriteString(std::ostream& os, const std::string& value);
+
+  /**
+   * @throw std::runtime_error if the stream ends
+   */
+  static std::string
+  ReadString(std::istream& is);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SNAPSHOT_HELPER_HPP
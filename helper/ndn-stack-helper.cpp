@@ -42,6 +42,7 @@ namespace ndn {
 StackHelper::StackHelper()
   : m_needSetDefaultRoutes(false)
   , m_maxCsSize(100)
+  , m_maxCsBytes(0)
 {
   setCustomNdnCxxClocks();
 
@@ -121,6 +122,12 @@ StackHelper::setCsSize(size_t maxSize)
   m_maxCsSize = maxSize;
 }
 
+void
+StackHelper::setCsMaxBytes(size_t maxBytes)
+{
+  m_maxCsBytes = maxBytes;
+}
+
 Ptr<FaceContainer>
 StackHelper::Install(const NodeContainer& c) const
 {
@@ -150,6 +157,7 @@ StackHelper::Install(Ptr<Node> node) const
 
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
   ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+  ndn->getConfig().put("tables.cs_max_bytes", m_maxCsBytes);
 
   // Create and aggregate content store if NFD's contest store has been disabled
   if (m_maxCsSize == 0) {
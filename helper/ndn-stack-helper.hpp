@@ -75,6 +75,14 @@ public:
   void
   setCsSize(size_t maxSize);
 
+  /**
+   * @brief Set maximum size for NFD's Content Store (in bytes of cached Data packets)
+   *
+   * The limit applies in addition to the limit in number of packets; 0 disables it.
+   */
+  void
+  setCsMaxBytes(size_t maxBytes);
+
   /**
    * @brief Set ndnSIM 1.0 content store implementation and its attributes
    * @param contentStoreClass string, representing class of the content store
@@ -232,6 +240,7 @@ private:
 
   bool m_needSetDefaultRoutes;
   size_t m_maxCsSize;
+  size_t m_maxCsBytes;
 
   typedef std::list<std::pair<TypeId, NetDeviceFaceCreateCallback>> NetDeviceCallbackList;
   NetDeviceCallbackList m_netDeviceCallbacks;
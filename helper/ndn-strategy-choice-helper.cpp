@@ -31,18 +31,17 @@ NS_LOG_COMPONENT_DEFINE("ndn.StrategyChoiceHelper");
 void
 StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node> node)
 {
-  NS_LOG_DEBUG("Strategy choice command was initialized");
-  Block encodedParameters(parameters.wireEncode());
+  // trusted in-process channel: no command Interest, signing and validation
+  static const Name::Component VERB_SET("set");
 
-  Name commandName("/localhost/nfd/strategy-choice");
-  commandName.append("set");
-  commandName.append(encodedParameters);
-
-  shared_ptr<Interest> command(make_shared<Interest>(commandName));
-  StackHelper::getKeyChain().sign(*command);
   Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
   auto strategyChoiceManager = L3protocol->getStrategyChoiceManager();
-  strategyChoiceManager->onStrategyChoiceRequest(*command);
+  nfd::ControlResponse response = strategyChoiceManager->executeTrustedCommand(VERB_SET, parameters);
+  if (response.getCode() != 200) {
+    NS_LOG_ERROR("Strategy choice on node " << node->GetId() << " failed: " << response.getCode()
+                 << " " << response.getText());
+    return;
+  }
   NS_LOG_DEBUG("Forwarding strategy installed in node " << node->GetId());
 }
 
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-sweep-helper.hpp"
+
+#include "ns3/log.h"
+
+#include "ns3/ndnSIM/utils/tracers/l2-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-memory-tracer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SweepHelper");
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Flush and close output streams of the tracers installed by the worker
+ */
+static void
+destroyTracers()
+{
+  L2RateTracer::Destroy();
+  AppDelayTracer::Destroy();
+  CsTracer::Destroy();
+  L3RateTracer::Destroy();
+  MemoryTracer::Destroy();
+}
+
+SweepHelper::SweepHelper()
+{
+  long nProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+  m_maxWorkers = nProcessors > 0 ? static_cast<size_t>(nProcessors) : 1;
+}
+
+void
+SweepHelper::addParameter(const std::string& name, const std::vector<std::string>& values)
+{
+  m_parameters.push_back(std::make_pair(name, values));
+}
+
+void
+SweepHelper::addPoint(const Point& point)
+{
+  m_points.push_back(point);
+}
+
+std::vector<SweepHelper::Point>
+SweepHelper::getPoints() const
+{
+  std::vector<Point> points;
+  if (!m_parameters.empty()) {
+    points.push_back(Point());
+    for (const auto& parameter : m_parameters) {
+      std::vector<Point> combinations;
+      for (const Point& point : points) {
+        for (const std::string& value : parameter.second) {
+          combinations.push_back(point);
+          combinations.back()[parameter.first] = value;
+        }
+      }
+      points.swap(combinations);
+    }
+  }
+
+  points.insert(points.end(), m_points.begin(), m_points.end());
+  return points;
+}
+
+std::string
+SweepHelper::getSuffix(const Point& point)
+{
+  std::string suffix;
+  for (const auto& parameter : point) {
+    if (!suffix.empty()) {
+      suffix += "_";
+    }
+    suffix += parameter.first + "-" + parameter.second;
+  }
+
+  // the suffix is used as a part of file names
+  for (char& c : suffix) {
+    if (c == '/' || c == ' ') {
+      c = '-';
+    }
+  }
+  return suffix;
+}
+
+void
+SweepHelper::setMaxWorkers(size_t maxWorkers)
+{
+  m_maxWorkers = std::max<size_t>(maxWorkers, 1);
+}
+
+size_t
+SweepHelper::getMaxWorkers() const
+{
+  return m_maxWorkers;
+}
+
+size_t
+SweepHelper::run(const Worker& worker)
+{
+  std::map<pid_t, std::string> workers; // suffix of running workers
+  size_t nFailed = 0;
+
+  auto waitForWorker = [&workers, &nFailed] {
+    int status = 0;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno != EINTR) {
+        NS_LOG_ERROR("Cannot wait for workers: " << std::strerror(errno));
+        nFailed += workers.size();
+        workers.clear();
+      }
+      return;
+    }
+
+    auto it = workers.find(pid);
+    if (it == workers.end()) {
+      return;
+    }
+
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+      NS_LOG_INFO("Worker " << it->second << " finished");
+    }
+    else {
+      NS_LOG_ERROR("Worker " << it->second << " failed");
+      ++nFailed;
+    }
+    workers.erase(it);
+  };
+
+  for (const Point& point : getPoints()) {
+    while (workers.size() >= m_maxWorkers) {
+      waitForWorker();
+    }
+
+    std::string suffix = getSuffix(point);
+
+    // otherwise, buffered output of the parent is written again by the worker
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+      NS_LOG_ERROR("Cannot fork worker " << suffix << ": " << std::strerror(errno));
+      ++nFailed;
+      continue;
+    }
+
+    if (pid == 0) {
+      int status = 0;
+      try {
+        worker(point, suffix);
+        destroyTracers();
+      }
+      catch (const std::exception& e) {
+        std::cerr << "Worker " << suffix << " failed: " << e.what() << std::endl;
+        status = 1;
+      }
+      catch (...) {
+        std::cerr << "Worker " << suffix << " failed: unknown exception" << std::endl;
+        status = 1;
+      }
+
+      // Static objects and buffered streams inherited from the parent belong to the parent, and
+      // their destructors would write the parent's buffered output again, so they are skipped
+      std::cout.flush();
+      std::cerr.flush();
+      std::fflush(nullptr);
+      _exit(status);
+    }
+
+    NS_LOG_INFO("Worker " << suffix << " started (pid " << pid << ")");
+    workers[pid] = suffix;
+  }
+
+  while (!workers.empty()) {
+    waitForWorker();
+  }
+  return nFailed;
+}
+
+} // namespace ndn
+} // namespace ns3
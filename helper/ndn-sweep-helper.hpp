@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SWEEP_HELPER_HPP
+#define NDN_SWEEP_HELPER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper class to run a parameter sweep of a scenario in parallel worker processes
+ *
+ * The part of the scenario that is the same for all parameter points (reading topology,
+ * installing NDN stack, calculating routes) is done once before calling run().  For every
+ * parameter point, run() forks a worker process, which shares the prepared simulation with the
+ * parent (copy-on-write), applies the parameters of its point (e.g., installs applications,
+ * sets attributes with Config::Set), installs tracers writing to uniquely named files, and runs
+ * the simulation.  At most getMaxWorkers() workers run at the same time.
+ *
+ *     // shared setup
+ *     AnnotatedTopologyReader topologyReader("", 1);
+ *     ...
+ *     ndn::GlobalRoutingHelper::CalculateRoutes();
+ *
+ *     ndn::SweepHelper sweep;
+ *     sweep.addParameter("zipf", {"0.8", "1.0", "1.2"});
+ *     sweep.addParameter("request_rate", {"10", "20"});
+ *
+ *     return sweep.run([] (const ndn::SweepHelper::Point& point, const std::string& suffix) {
+ *         ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrot");
+ *         consumerHelper.SetAttribute("s", StringValue(point.at("zipf")));
+ *         consumerHelper.SetAttribute("Frequency", StringValue(point.at("request_rate")));
+ *         ...
+ *         ndn::L3RateTracer::InstallAll("rate-trace-" + suffix + ".txt", Seconds(1.0));
+ *         Simulator::Run();
+ *         Simulator::Destroy();
+ *       });
+ *
+ * Tracers must be installed by the worker, not before run().  When the worker function returns
+ * (or throws), run() destroys the ndnSIM tracers (L3RateTracer, L2RateTracer, CsTracer,
+ * AppDelayTracer, MemoryTracer) to flush their files and ends the worker process with _exit,
+ * which skips destructors of static objects, as they belong to the parent: output that is
+ * still buffered in streams opened before run() would otherwise be written once per worker.
+ * Other streams opened by the worker must be flushed or closed by the worker function, which
+ * should not return before the simulation is finished.
+ */
+class SweepHelper
+{
+public:
+  /**
+   * @brief Values of all parameters, by parameter name
+   */
+  typedef std::map<std::string, std::string> Point;
+
+  /**
+   * @brief Function that runs the simulation for one parameter point
+   *
+   * The second argument is a unique suffix for trace file names, e.g., "request_rate-10_zipf-0.8"
+   */
+  typedef std::function<void(const Point& point, const std::string& suffix)> Worker;
+
+public:
+  /**
+   * @brief Create helper with the number of workers equal to the number of online processors
+   */
+  SweepHelper();
+
+  /**
+   * @brief Add parameter, points of the sweep are all combinations of parameter values
+   */
+  void
+  addParameter(const std::string& name, const std::vector<std::string>& values);
+
+  /**
+   * @brief Add parameter point in addition to combinations of parameter values
+   */
+  void
+  addPoint(const Point& point);
+
+  /**
+   * @brief Get all parameter points of the sweep, in the order they are run
+   */
+  std::vector<Point>
+  getPoints() const;
+
+  /**
+   * @brief Get unique suffix of file names for the parameter point
+   */
+  static std::string
+  getSuffix(const Point& point);
+
+  void
+  setMaxWorkers(size_t maxWorkers);
+
+  size_t
+  getMaxWorkers() const;
+
+  /**
+   * @brief Fork a worker process for every parameter point and wait until all workers finish
+   * @return number of workers that failed (exited with non-zero status or were killed)
+   */
+  size_t
+  run(const Worker& worker);
+
+private:
+  std::vector<std::pair<std::string, std::vector<std::string>>> m_parameters;
+  std::vector<Point> m_points;
+  size_t m_maxWorkers;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SWEEP_HELPER_HPP
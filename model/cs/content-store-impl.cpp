@@ -23,6 +23,12 @@
 #include "../../utils/trie/lru-policy.hpp"
 #include "../../utils/trie/fifo-policy.hpp"
 #include "../../utils/trie/lfu-policy.hpp"
+#include "../../utils/trie/lfu2-policy.hpp"
+#include "../../utils/trie/random2-policy.hpp"
+#include "../../utils/trie/s4lru-policy.hpp"
+#include "../../utils/trie/arc-policy.hpp"
+#include "../../utils/trie/wtinylfu-policy.hpp"
+#include "../../utils/trie/gdsf-policy.hpp"
 #include "../../utils/trie/multi-policy.hpp"
 #include "../../utils/trie/aggregate-stats-policy.hpp"
 
@@ -63,10 +69,47 @@ template class ContentStoreImpl<fifo_policy_traits>;
  **/
 template class ContentStoreImpl<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore with Least Frequently Used (LFU) cache replacement policy with O(1)
+ *        operations
+ **/
+template class ContentStoreImpl<lfu2_policy_traits>;
+
+/**
+ * @brief ContentStore with random cache replacement policy with O(1) operations
+ **/
+template class ContentStoreImpl<random2_policy_traits>;
+
+/**
+ * @brief ContentStore and quadruply-segmented LRU (S4LRU) cache replacement policy
+ **/
+template class ContentStoreImpl<s4lru_policy_traits>;
+
+/**
+ * @brief ContentStore and Adaptive Replacement Cache (ARC) cache replacement policy
+ **/
+template class ContentStoreImpl<arc_policy_traits>;
+
+/**
+ * @brief ContentStore and Window TinyLFU (W-TinyLFU) admission and cache replacement policy
+ **/
+template class ContentStoreImpl<wtinylfu_policy_traits>;
+
+/**
+ * @brief ContentStore and size-aware Greedy-Dual-Size-Frequency (GDSF) cache replacement policy
+ **/
+template class ContentStoreImpl<gdsf_policy_traits>;
+
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fifo_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu2_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random2_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, s4lru_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, arc_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, wtinylfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, gdsf_policy_traits);
 
 typedef multi_policy_traits<boost::mpl::vector2<lru_policy_traits, aggregate_stats_policy_traits>>
   LruWithCountsTraits;
@@ -90,6 +133,18 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, FifoWithCountsTraits);
 template class ContentStoreImpl<LfuWithCountsTraits>;
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuWithCountsTraits);
 
+typedef multi_policy_traits<boost::mpl::vector2<lfu2_policy_traits, aggregate_stats_policy_traits>>
+  Lfu2WithCountsTraits;
+typedef multi_policy_traits<boost::mpl::vector2<random2_policy_traits,
+                                                aggregate_stats_policy_traits>>
+  Random2WithCountsTraits;
+
+template class ContentStoreImpl<Lfu2WithCountsTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, Lfu2WithCountsTraits);
+
+template class ContentStoreImpl<Random2WithCountsTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, Random2WithCountsTraits);
+
 #ifdef DOXYGEN
 // /**
 //  * \brief Content Store implementing LRU cache replacement policy
@@ -114,6 +169,46 @@ class Random : public ContentStoreImpl<random_policy_traits> {
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> {
 };
+
+/**
+ * \brief Content Store implementing Least Frequently Used cache replacement policy with O(1)
+ *        update and eviction (frequency buckets)
+ */
+class Lfu2 : public ContentStoreImpl<lfu2_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing Random cache replacement policy with O(1) eviction
+ *        (dense index array)
+ */
+class Random2 : public ContentStoreImpl<random2_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing quadruply-segmented LRU (S4LRU) cache replacement policy
+ */
+class S4Lru : public ContentStoreImpl<s4lru_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing Adaptive Replacement Cache (ARC) cache replacement policy
+ */
+class Arc : public ContentStoreImpl<arc_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing Window TinyLFU (W-TinyLFU) admission and cache replacement
+ *        policy
+ */
+class WTinyLfu : public ContentStoreImpl<wtinylfu_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing size-aware Greedy-Dual-Size-Frequency (GDSF) cache replacement
+ *        policy
+ */
+class Gdsf : public ContentStoreImpl<gdsf_policy_traits> {
+};
 #endif
 
 } // namespace cs
@@ -32,11 +32,23 @@
 #include "ns3/string.h"
 
 #include "../../utils/trie/trie-with-policy.hpp"
+#include "../../utils/trie/detail/byte-budget.hpp"
+#include "../../utils/ndn-virtual-payload-tag.hpp"
 
 namespace ns3 {
 namespace ndn {
 namespace cs {
 
+/**
+ * @brief Get number of bytes accounted for a cached Data, including virtual payload
+ */
+inline size_t
+GetDataSize(const Data& data)
+{
+  const VirtualPayloadTag* payloadTag = data.findTag<VirtualPayloadTag>();
+  return data.wireEncode().size() + (payloadTag != nullptr ? payloadTag->getSize() : 0);
+}
+
 /**
  * @ingroup ndn-cs
  * @brief Cache entry implementation with additional references to the base container
@@ -50,7 +62,16 @@ public:
   EntryImpl(Ptr<ContentStore> cs, shared_ptr<const Data> data)
     : Entry(cs, data)
     , item_(0)
+    , isInvalidated_(false)
+    , cs_(static_cast<CS*>(PeekPointer(cs)))
+    , bytes_(GetDataSize(*data))
+  {
+    cs_->m_nBytes += bytes_;
+  }
+
+  ~EntryImpl()
   {
+    cs_->m_nBytes -= bytes_;
   }
 
   void
@@ -70,34 +91,81 @@ public:
     return item_;
   }
 
+  /**
+   * @brief Mark the entry as stale, to be evicted when it is looked up or replaced
+   */
+  void
+  Invalidate()
+  {
+    isInvalidated_ = true;
+  }
+
+  bool
+  IsInvalidated() const
+  {
+    return isInvalidated_;
+  }
+
+  /**
+   * @brief Get number of bytes accounted for the cached Data
+   */
+  size_t
+  GetBytes() const
+  {
+    return bytes_;
+  }
+
 private:
   typename CS::super::iterator item_;
+  bool isInvalidated_;
+  CS* cs_;       ///< @brief owner of the entry, kept alive by the base class
+  size_t bytes_; ///< @brief accounted size of the Data
+};
+
+/**
+ * @ingroup ndn-cs
+ * @brief Payload traits of the cache entries, reporting entry size to byte-budgeted policies
+ */
+template<class CS>
+struct EntryPayloadTraits : public ndnSIM::smart_pointer_payload_traits<EntryImpl<CS>, Entry> {
+  /**
+   * @brief Get number of bytes taken by the cached Data packet (wire encoding size plus
+   *        virtual payload)
+   */
+  static size_t
+  size(Ptr<const EntryImpl<CS>> entry)
+  {
+    return entry->GetBytes();
+  }
 };
 
 /**
  * @ingroup ndn-cs
  * @brief Base implementation of NDN content store
+ *
+ * Invalidation does not unlink entries from the trie or the policy: Invalidate and
+ * InvalidatePrefix only mark the cached entries of the name (prefix) as stale, and nothing is
+ * recorded for names that are not cached.  Stale entries are skipped (and evicted) by Lookup and
+ * replaced by Add.  Until then they still take space in the cache and are reported by GetSize.
  */
 template<class Policy>
 class ContentStoreImpl
   : public ContentStore,
-    protected ndnSIM::
-      trie_with_policy<Name,
-                       ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
-                                                            Entry>,
-                       Policy> {
+    protected ndnSIM::trie_with_policy<Name, EntryPayloadTraits<ContentStoreImpl<Policy>>, Policy> {
 public:
-  typedef ndnSIM::
-    trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
-                                                                Entry>,
-                     Policy> super;
+  typedef ndnSIM::trie_with_policy<Name, EntryPayloadTraits<ContentStoreImpl<Policy>>, Policy>
+    super;
 
   typedef EntryImpl<ContentStoreImpl<Policy>> entry;
 
   static TypeId
   GetTypeId();
 
-  ContentStoreImpl(){};
+  ContentStoreImpl()
+    : m_nBytes(0)
+  {
+  }
+
   virtual ~ContentStoreImpl(){};
 
   // from ContentStore
@@ -113,6 +181,12 @@ public:
   Erase(shared_ptr<const Data> data);
   // end add
 
+  virtual inline void
+  Invalidate(const Name& name);
+
+  virtual inline void
+  InvalidatePrefix(const Name& prefix);
+
   // virtual bool
   // Remove (shared_ptr<Interest> header);
 
@@ -122,6 +196,15 @@ public:
   virtual uint32_t
   GetSize() const;
 
+  /**
+   * @brief Get number of bytes taken by the Data packets of existing entries
+   *
+   * Entries are accounted from creation to destruction, including entries that are still
+   * referenced (e.g., by tracers) after being evicted.
+   */
+  virtual uint64_t
+  GetBytes() const;
+
   virtual Ptr<Entry>
   Begin();
 
@@ -130,6 +213,9 @@ public:
 
   virtual Ptr<Entry> Next(Ptr<Entry>);
 
+  virtual std::vector<Ptr<Entry>>
+  GetEntriesInPolicyOrder();
+
   const typename super::policy_container&
   GetPolicy() const
   {
@@ -152,9 +238,36 @@ private:
   uint32_t
   GetMaxSize() const;
 
+  void
+  SetMaxBytes(uint64_t maxBytes);
+
+  uint64_t
+  GetMaxBytes() const;
+
+  /**
+   * @brief Check if the entry was invalidated by name or by prefix after it was added
+   */
+  bool
+  IsInvalidated(const entry& item) const;
+
+  /**
+   * @brief Mark all entries in the subtree of the trie node as invalidated
+   */
+  void
+  InvalidateSubtree(typename super::parent_trie& node);
+
+  /**
+   * @brief Evict invalidated entry
+   */
+  void
+  EraseInvalidated(typename super::iterator node);
+
 private:
   static LogComponent g_log; ///< @brief Logging variable
 
+  uint64_t m_nBytes; ///< @brief updated by the entries
+  friend entry;
+
   /// @brief trace of for entry additions (fired every time entry is successfully added to the
   /// cache): first parameter is pointer to the CS entry
   TracedCallback<Ptr<const Entry>> m_didAddEntry;
@@ -181,6 +294,12 @@ ContentStoreImpl<Policy>::GetTypeId()
                     StringValue("100"), MakeUintegerAccessor(&ContentStoreImpl<Policy>::GetMaxSize,
                                                              &ContentStoreImpl<Policy>::SetMaxSize),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("MaxBytes",
+                    "Set maximum number of bytes (wire size of cached Data packets) in "
+                    "ContentStore. If 0, limit is not enforced",
+                    UintegerValue(0), MakeUintegerAccessor(&ContentStoreImpl<Policy>::GetMaxBytes,
+                                                           &ContentStoreImpl<Policy>::SetMaxBytes),
+                    MakeUintegerChecker<uint64_t>())
 
       .AddTraceSource("DidAddEntry",
                       "Trace fired every time entry is successfully added to the cache",
@@ -212,13 +331,21 @@ ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION(this << interest->getName());
 
-  typename super::const_iterator node;
-  if (interest->getExclude().empty()) {
-    node = this->deepest_prefix_match(interest->getName());
-  }
-  else {
-    node = this->deepest_prefix_match_if_next_level(interest->getName(),
-                                                    isNotExcluded(interest->getExclude()));
+  typename super::iterator node;
+  for (;;) {
+    if (interest->getExclude().empty()) {
+      node = this->deepest_prefix_match(interest->getName());
+    }
+    else {
+      node = this->deepest_prefix_match_if_next_level(interest->getName(),
+                                                      isNotExcluded(interest->getExclude()));
+    }
+
+    if (node == this->end() || !IsInvalidated(*node->payload()))
+      break;
+
+    // invalidated entries are evicted lazily, a less specific entry may still match
+    EraseInvalidated(node);
   }
 
   if (node != this->end()) {
@@ -242,6 +369,12 @@ ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
   Ptr<entry> newEntry = Create<entry>(this, data);
   std::pair<typename super::iterator, bool> result = super::insert(data->getName(), newEntry);
 
+  if (result.first != super::end() && !result.second && IsInvalidated(*result.first->payload())) {
+    // payload cannot be replaced in place, as its size may be accounted by the policy
+    EraseInvalidated(result.first);
+    result = super::insert(data->getName(), newEntry);
+  }
+
   if (result.first != super::end()) {
     if (result.second) {
       newEntry->SetTrie(result.first);
@@ -267,6 +400,58 @@ ContentStoreImpl<Policy>::Erase(shared_ptr<const Data> data)
   super::erase(data->getName());
 }
 
+template<class Policy>
+void
+ContentStoreImpl<Policy>::Invalidate(const Name& name)
+{
+  NS_LOG_FUNCTION(this << name);
+
+  typename super::iterator node = super::find_exact(name);
+  if (node != super::end())
+    node->payload()->Invalidate();
+}
+
+template<class Policy>
+void
+ContentStoreImpl<Policy>::InvalidatePrefix(const Name& prefix)
+{
+  NS_LOG_FUNCTION(this << prefix);
+
+  typename super::iterator foundItem, lastItem;
+  bool reachLast;
+  std::tie(foundItem, reachLast, lastItem) = super::getTrie().find(prefix);
+  if (reachLast)
+    InvalidateSubtree(*lastItem);
+}
+
+template<class Policy>
+void
+ContentStoreImpl<Policy>::InvalidateSubtree(typename super::parent_trie& node)
+{
+  if (node.payload() != 0)
+    node.payload()->Invalidate();
+
+  typename super::parent_trie::point_iterator child(node), end(0);
+  for (; child != end; child++) {
+    InvalidateSubtree(*child);
+  }
+}
+
+template<class Policy>
+bool
+ContentStoreImpl<Policy>::IsInvalidated(const entry& item) const
+{
+  return item.IsInvalidated();
+}
+
+template<class Policy>
+void
+ContentStoreImpl<Policy>::EraseInvalidated(typename super::iterator node)
+{
+  NS_LOG_DEBUG("Evicting invalidated " << node->payload()->GetName());
+  super::erase(node);
+}
+
 template<class Policy>
 void
 ContentStoreImpl<Policy>::Print(std::ostream& os) const
@@ -291,6 +476,25 @@ ContentStoreImpl<Policy>::GetMaxSize() const
   return this->getPolicy().get_max_size();
 }
 
+template<class Policy>
+void
+ContentStoreImpl<Policy>::SetMaxBytes(uint64_t maxBytes)
+{
+  ndnSIM::detail::set_max_bytes(this->getPolicy(), maxBytes, 0);
+
+  if (maxBytes != 0 && ndnSIM::detail::get_max_bytes(this->getPolicy(), 0) != maxBytes) {
+    NS_FATAL_ERROR("Cache replacement policy " << Policy::GetName()
+                                               << " does not support byte limits");
+  }
+}
+
+template<class Policy>
+uint64_t
+ContentStoreImpl<Policy>::GetMaxBytes() const
+{
+  return ndnSIM::detail::get_max_bytes(this->getPolicy(), 0);
+}
+
 template<class Policy>
 uint32_t
 ContentStoreImpl<Policy>::GetSize() const
@@ -298,13 +502,20 @@ ContentStoreImpl<Policy>::GetSize() const
   return this->getPolicy().size();
 }
 
+template<class Policy>
+uint64_t
+ContentStoreImpl<Policy>::GetBytes() const
+{
+  return m_nBytes;
+}
+
 template<class Policy>
 Ptr<Entry>
 ContentStoreImpl<Policy>::Begin()
 {
   typename super::parent_trie::recursive_iterator item(super::getTrie()), end(0);
   for (; item != end; item++) {
-    if (item->payload() == 0)
+    if (item->payload() == 0 || IsInvalidated(*item->payload()))
       continue;
     break;
   }
@@ -333,7 +544,7 @@ ContentStoreImpl<Policy>::Next(Ptr<Entry> from)
     end(0);
 
   for (item++; item != end; item++) {
-    if (item->payload() == 0)
+    if (item->payload() == 0 || IsInvalidated(*item->payload()))
       continue;
     break;
   }
@@ -344,6 +555,19 @@ ContentStoreImpl<Policy>::Next(Ptr<Entry> from)
     return item->payload();
 }
 
+template<class Policy>
+std::vector<Ptr<Entry>>
+ContentStoreImpl<Policy>::GetEntriesInPolicyOrder()
+{
+  std::vector<Ptr<Entry>> entries;
+  for (typename super::policy_container::iterator item = this->getPolicy().begin();
+       item != this->getPolicy().end(); item++) {
+    if (!IsInvalidated(*item->payload()))
+      entries.push_back(item->payload());
+  }
+  return entries;
+}
+
 } // namespace cs
 } // namespace ndn
 } // namespace ns3
@@ -67,6 +67,16 @@ Nocache::Erase(shared_ptr<const Data> data)
 {
 }
 
+void
+Nocache::Invalidate(const Name& name)
+{
+}
+
+void
+Nocache::InvalidatePrefix(const Name& prefix)
+{
+}
+
 void
 Nocache::Print(std::ostream& os) const
 {
@@ -61,6 +61,12 @@ public:
   virtual void
   Erase(shared_ptr<const Data> data);
 
+  virtual void
+  Invalidate(const Name& name);
+
+  virtual void
+  InvalidatePrefix(const Name& prefix);
+
   virtual void
   Print(std::ostream& os) const;
 
@@ -23,6 +23,12 @@
 #include "../../utils/trie/lru-policy.hpp"
 #include "../../utils/trie/fifo-policy.hpp"
 #include "../../utils/trie/lfu-policy.hpp"
+#include "../../utils/trie/lfu2-policy.hpp"
+#include "../../utils/trie/random2-policy.hpp"
+#include "../../utils/trie/s4lru-policy.hpp"
+#include "../../utils/trie/arc-policy.hpp"
+#include "../../utils/trie/wtinylfu-policy.hpp"
+#include "../../utils/trie/gdsf-policy.hpp"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
   static struct X##type##templ##RegistrationClass {                                                \
@@ -61,11 +67,51 @@ template class ContentStoreWithFreshness<fifo_policy_traits>;
  **/
 template class ContentStoreWithFreshness<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore with freshness and Least Frequently Used (LFU) cache replacement policy
+ *        with O(1) operations
+ **/
+template class ContentStoreWithFreshness<lfu2_policy_traits>;
+
+/**
+ * @brief ContentStore with freshness and random cache replacement policy with O(1)
+ *        operations
+ **/
+template class ContentStoreWithFreshness<random2_policy_traits>;
+
+/**
+ * @brief ContentStore with freshness and quadruply-segmented LRU (S4LRU) cache replacement policy
+ **/
+template class ContentStoreWithFreshness<s4lru_policy_traits>;
+
+/**
+ * @brief ContentStore with freshness and Adaptive Replacement Cache (ARC) cache replacement policy
+ **/
+template class ContentStoreWithFreshness<arc_policy_traits>;
+
+/**
+ * @brief ContentStore with freshness and Window TinyLFU (W-TinyLFU) admission and cache
+ *        replacement policy
+ **/
+template class ContentStoreWithFreshness<wtinylfu_policy_traits>;
+
+/**
+ * @brief ContentStore with freshness and size-aware Greedy-Dual-Size-Frequency (GDSF) cache
+ *        replacement policy
+ **/
+template class ContentStoreWithFreshness<gdsf_policy_traits>;
+
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, fifo_policy_traits);
 
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, lfu2_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, random2_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, s4lru_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, arc_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, wtinylfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, gdsf_policy_traits);
 
 #ifdef DOXYGEN
 // /**
@@ -92,6 +138,48 @@ class Freshness::Random : public ContentStoreWithFreshness<random_policy_traits>
 class Freshness::Lfu : public ContentStoreWithFreshness<lfu_policy_traits> {
 };
 
+/**
+ * \brief Content Store with freshness implementing Least Frequently Used cache replacement policy
+ *        with O(1) update and eviction (frequency buckets)
+ */
+class Freshness::Lfu2 : public ContentStoreWithFreshness<lfu2_policy_traits> {
+};
+
+/**
+ * \brief Content Store with freshness implementing Random cache replacement policy with O(1)
+ *        eviction (dense index array)
+ */
+class Freshness::Random2 : public ContentStoreWithFreshness<random2_policy_traits> {
+};
+
+/**
+ * \brief Content Store with freshness implementing quadruply-segmented LRU (S4LRU) cache
+ *        replacement policy
+ */
+class Freshness::S4Lru : public ContentStoreWithFreshness<s4lru_policy_traits> {
+};
+
+/**
+ * \brief Content Store with freshness implementing Adaptive Replacement Cache (ARC) cache
+ *        replacement policy
+ */
+class Freshness::Arc : public ContentStoreWithFreshness<arc_policy_traits> {
+};
+
+/**
+ * \brief Content Store with freshness implementing Window TinyLFU (W-TinyLFU) admission and cache
+ *        replacement policy
+ */
+class Freshness::WTinyLfu : public ContentStoreWithFreshness<wtinylfu_policy_traits> {
+};
+
+/**
+ * \brief Content Store with freshness implementing size-aware Greedy-Dual-Size-Frequency (GDSF)
+ *        cache replacement policy
+ */
+class Freshness::Gdsf : public ContentStoreWithFreshness<gdsf_policy_traits> {
+};
+
 #endif
 
 } // namespace cs
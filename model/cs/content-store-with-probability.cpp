@@ -23,6 +23,12 @@
 #include "../../utils/trie/lru-policy.hpp"
 #include "../../utils/trie/fifo-policy.hpp"
 #include "../../utils/trie/lfu-policy.hpp"
+#include "../../utils/trie/lfu2-policy.hpp"
+#include "../../utils/trie/random2-policy.hpp"
+#include "../../utils/trie/s4lru-policy.hpp"
+#include "../../utils/trie/arc-policy.hpp"
+#include "../../utils/trie/wtinylfu-policy.hpp"
+#include "../../utils/trie/gdsf-policy.hpp"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
   static struct X##type##templ##RegistrationClass {                                                \
@@ -61,11 +67,51 @@ template class ContentStoreWithProbability<fifo_policy_traits>;
  **/
 template class ContentStoreWithProbability<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore with freshness and Least Frequently Used (LFU) cache replacement policy
+ *        with O(1) operations
+ **/
+template class ContentStoreWithProbability<lfu2_policy_traits>;
+
+/**
+ * @brief ContentStore with freshness and random cache replacement policy with O(1)
+ *        operations
+ **/
+template class ContentStoreWithProbability<random2_policy_traits>;
+
+/**
+ * @brief ContentStore with freshness and quadruply-segmented LRU (S4LRU) cache replacement policy
+ **/
+template class ContentStoreWithProbability<s4lru_policy_traits>;
+
+/**
+ * @brief ContentStore with freshness and Adaptive Replacement Cache (ARC) cache replacement policy
+ **/
+template class ContentStoreWithProbability<arc_policy_traits>;
+
+/**
+ * @brief ContentStore with freshness and Window TinyLFU (W-TinyLFU) admission and cache
+ *        replacement policy
+ **/
+template class ContentStoreWithProbability<wtinylfu_policy_traits>;
+
+/**
+ * @brief ContentStore with freshness and size-aware Greedy-Dual-Size-Frequency (GDSF) cache
+ *        replacement policy
+ **/
+template class ContentStoreWithProbability<gdsf_policy_traits>;
+
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, fifo_policy_traits);
 
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, lfu2_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, random2_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, s4lru_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, arc_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, wtinylfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithProbability, gdsf_policy_traits);
 
 #ifdef DOXYGEN
 // /**
@@ -92,6 +138,48 @@ class Probability::Random : public ContentStoreWithProbability<random_policy_tra
 class Probability::Lfu : public ContentStoreWithProbability<lfu_policy_traits> {
 };
 
+/**
+ * \brief Content Store with freshness implementing Least Frequently Used cache replacement policy
+ *        with O(1) update and eviction (frequency buckets)
+ */
+class Probability::Lfu2 : public ContentStoreWithProbability<lfu2_policy_traits> {
+};
+
+/**
+ * \brief Content Store with freshness implementing Random cache replacement policy with O(1)
+ *        eviction (dense index array)
+ */
+class Probability::Random2 : public ContentStoreWithProbability<random2_policy_traits> {
+};
+
+/**
+ * \brief Content Store with freshness implementing quadruply-segmented LRU (S4LRU) cache
+ *        replacement policy
+ */
+class Probability::S4Lru : public ContentStoreWithProbability<s4lru_policy_traits> {
+};
+
+/**
+ * \brief Content Store with freshness implementing Adaptive Replacement Cache (ARC) cache
+ *        replacement policy
+ */
+class Probability::Arc : public ContentStoreWithProbability<arc_policy_traits> {
+};
+
+/**
+ * \brief Content Store with freshness implementing Window TinyLFU (W-TinyLFU) admission and cache
+ *        replacement policy
+ */
+class Probability::WTinyLfu : public ContentStoreWithProbability<wtinylfu_policy_traits> {
+};
+
+/**
+ * \brief Content Store with freshness implementing size-aware Greedy-Dual-Size-Frequency (GDSF)
+ *        cache replacement policy
+ */
+class Probability::Gdsf : public ContentStoreWithProbability<gdsf_policy_traits> {
+};
+
 #endif
 
 } // namespace cs
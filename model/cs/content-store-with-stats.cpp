@@ -23,6 +23,12 @@
 #include "../../utils/trie/lru-policy.hpp"
 #include "../../utils/trie/fifo-policy.hpp"
 #include "../../utils/trie/lfu-policy.hpp"
+#include "../../utils/trie/lfu2-policy.hpp"
+#include "../../utils/trie/random2-policy.hpp"
+#include "../../utils/trie/s4lru-policy.hpp"
+#include "../../utils/trie/arc-policy.hpp"
+#include "../../utils/trie/wtinylfu-policy.hpp"
+#include "../../utils/trie/gdsf-policy.hpp"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
   static struct X##type##templ##RegistrationClass {                                                \
@@ -61,11 +67,51 @@ template class ContentStoreWithStats<fifo_policy_traits>;
  **/
 template class ContentStoreWithStats<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore with stats and Least Frequently Used (LFU) cache replacement policy
+ *        with O(1) operations
+ **/
+template class ContentStoreWithStats<lfu2_policy_traits>;
+
+/**
+ * @brief ContentStore with stats and random cache replacement policy with O(1)
+ *        operations
+ **/
+template class ContentStoreWithStats<random2_policy_traits>;
+
+/**
+ * @brief ContentStore with stats and quadruply-segmented LRU (S4LRU) cache replacement policy
+ **/
+template class ContentStoreWithStats<s4lru_policy_traits>;
+
+/**
+ * @brief ContentStore with stats and Adaptive Replacement Cache (ARC) cache replacement policy
+ **/
+template class ContentStoreWithStats<arc_policy_traits>;
+
+/**
+ * @brief ContentStore with stats and Window TinyLFU (W-TinyLFU) admission and cache replacement
+ *        policy
+ **/
+template class ContentStoreWithStats<wtinylfu_policy_traits>;
+
+/**
+ * @brief ContentStore with stats and size-aware Greedy-Dual-Size-Frequency (GDSF) cache
+ *        replacement policy
+ **/
+template class ContentStoreWithStats<gdsf_policy_traits>;
+
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, fifo_policy_traits);
 
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, lfu2_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, random2_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, s4lru_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, arc_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, wtinylfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithStats, gdsf_policy_traits);
 
 #ifdef DOXYGEN
 // /**
@@ -92,6 +138,48 @@ class Stats::Random : public ContentStoreWithStats<random_policy_traits> {
 class Stats::Lfu : public ContentStoreWithStats<lfu_policy_traits> {
 };
 
+/**
+ * \brief Content Store with stats implementing Least Frequently Used cache replacement policy
+ *        with O(1) update and eviction (frequency buckets)
+ */
+class Stats::Lfu2 : public ContentStoreWithStats<lfu2_policy_traits> {
+};
+
+/**
+ * \brief Content Store with stats implementing Random cache replacement policy with O(1)
+ *        eviction (dense index array)
+ */
+class Stats::Random2 : public ContentStoreWithStats<random2_policy_traits> {
+};
+
+/**
+ * \brief Content Store with stats implementing quadruply-segmented LRU (S4LRU) cache replacement
+ *        policy
+ */
+class Stats::S4Lru : public ContentStoreWithStats<s4lru_policy_traits> {
+};
+
+/**
+ * \brief Content Store with stats implementing Adaptive Replacement Cache (ARC) cache replacement
+ *        policy
+ */
+class Stats::Arc : public ContentStoreWithStats<arc_policy_traits> {
+};
+
+/**
+ * \brief Content Store with stats implementing Window TinyLFU (W-TinyLFU) admission and cache
+ *        replacement policy
+ */
+class Stats::WTinyLfu : public ContentStoreWithStats<wtinylfu_policy_traits> {
+};
+
+/**
+ * \brief Content Store with stats implementing size-aware Greedy-Dual-Size-Frequency (GDSF) cache
+ *        replacement policy
+ */
+class Stats::Gdsf : public ContentStoreWithStats<gdsf_policy_traits> {
+};
+
 #endif
 
 } // namespace cs
@@ -52,6 +52,22 @@ ContentStore::~ContentStore()
 {
 }
 
+uint64_t
+ContentStore::GetBytes() const
+{
+  return 0;
+}
+
+std::vector<Ptr<cs::Entry>>
+ContentStore::GetEntriesInPolicyOrder()
+{
+  std::vector<Ptr<cs::Entry>> entries;
+  for (Ptr<cs::Entry> entry = Begin(); entry != End(); entry = Next(entry)) {
+    entries.push_back(entry);
+  }
+  return entries;
+}
+
 namespace cs {
 
 //////////////////////////////////////////////////////////////////////
@@ -27,6 +27,7 @@
 #include "ns3/traced-callback.h"
 
 #include <tuple>
+#include <vector>
 
 namespace ns3 {
 
@@ -133,6 +134,23 @@ public:
   virtual void
   Erase(shared_ptr<const Data> data) = 0;
 
+  /**
+   * \brief Invalidate the cached version of the content with the given name
+   *
+   * The entry (if any) is not removed immediately: it stops matching Interests and is evicted
+   * when it is looked up or replaced by a newer version.  Data added after the call is not
+   * affected.
+   */
+  virtual void
+  Invalidate(const Name& name) = 0;
+
+  /**
+   * \brief Invalidate cached versions of all contents under the given prefix
+   * \see Invalidate
+   */
+  virtual void
+  InvalidatePrefix(const Name& prefix) = 0;
+
   // /*
   //  * \brief Add a new content to the content store.
   //  *
@@ -154,8 +172,16 @@ public:
   virtual uint32_t
   GetSize() const = 0;
 
+  /**
+   * @brief Get number of bytes taken by the cached Data packets (wire encoding size)
+   */
+  virtual uint64_t
+  GetBytes() const;
+
   /**
    * @brief Return first element of content store (no order guaranteed)
+   *
+   * Invalidated entries are not enumerated
    */
   virtual Ptr<cs::Entry>
   Begin() = 0;
@@ -171,6 +197,17 @@ public:
    */
   virtual Ptr<cs::Entry> Next(Ptr<cs::Entry>) = 0;
 
+  /**
+   * @brief Get entries in the order of the replacement policy, the entry to be evicted first
+   *        being the first
+   *
+   * Adding the entries back in this order restores the order of recency-based policies (e.g.,
+   * LRU and FIFO).  The default implementation returns entries in the order of Begin() and
+   * Next().  Invalidated entries are not returned.
+   */
+  virtual std::vector<Ptr<cs::Entry>>
+  GetEntriesInPolicyOrder();
+
   ////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////
@@ -24,6 +24,8 @@
 
 #include "ns3/channel.h"
 
+#include <algorithm>
+
 namespace ns3 {
 namespace ndn {
 
@@ -83,6 +85,62 @@ GlobalRouter::GetIncidencies()
   return m_incidencies;
 }
 
+Ptr<GlobalRouter>
+GlobalRouter::DisableIncidency(shared_ptr<Face> face)
+{
+  for (auto i = m_incidencies.begin(); i != m_incidencies.end(); ++i) {
+    if (std::get<1>(*i) == face) {
+      Ptr<GlobalRouter> other = std::get<2>(*i);
+      m_disabledIncidencies.splice(m_disabledIncidencies.end(), m_incidencies, i);
+      return other;
+    }
+  }
+  return 0;
+}
+
+Ptr<GlobalRouter>
+GlobalRouter::EnableIncidency(shared_ptr<Face> face)
+{
+  for (auto i = m_disabledIncidencies.begin(); i != m_disabledIncidencies.end(); ++i) {
+    if (std::get<1>(*i) == face) {
+      Ptr<GlobalRouter> other = std::get<2>(*i);
+      m_incidencies.splice(m_incidencies.end(), m_disabledIncidencies, i);
+      return other;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Check whether an edge in @p incidencies uses @p face
+ */
+static bool
+hasFace(const GlobalRouter::IncidencyList& incidencies, shared_ptr<Face> face)
+{
+  return std::any_of(incidencies.begin(), incidencies.end(),
+                     [&face](const GlobalRouter::Incidency& incidency) {
+                       return std::get<1>(incidency) == face;
+                     });
+}
+
+bool
+GlobalRouter::HasIncidency(shared_ptr<Face> face) const
+{
+  return hasFace(m_incidencies, face);
+}
+
+bool
+GlobalRouter::HasDisabledIncidency(shared_ptr<Face> face) const
+{
+  return hasFace(m_disabledIncidencies, face);
+}
+
+GlobalRouter::ShortestPathTree&
+GlobalRouter::GetShortestPathTree()
+{
+  return m_shortestPathTree;
+}
+
 const GlobalRouter::LocalPrefixList&
 GlobalRouter::GetLocalPrefixes() const
 {
@@ -27,6 +27,7 @@
 #include "ns3/ptr.h"
 
 #include <list>
+#include <map>
 #include <tuple>
 
 namespace ns3 {
@@ -55,6 +56,14 @@ public:
    * @brief List of locally exported prefixes
    */
   typedef std::list<shared_ptr<Name>> LocalPrefixList;
+  /**
+   * @brief Entry of the shortest path tree: parent vertex, first-hop face, and distance
+   */
+  typedef std::tuple<Ptr<GlobalRouter>, shared_ptr<Face>, uint32_t> PathEntry;
+  /**
+   * @brief Shortest path tree rooted at this node (contains only reachable vertices)
+   */
+  typedef std::map<Ptr<GlobalRouter>, PathEntry> ShortestPathTree;
 
   /**
    * \brief Interface ID
@@ -102,6 +111,41 @@ public:
   IncidencyList&
   GetIncidencies();
 
+  /**
+   * @brief Exclude edge that uses @p face from the graph (e.g., when the link has failed)
+   * @return GlobalRouter on the other side of the edge or 0 if no active edge uses @p face
+   */
+  Ptr<GlobalRouter>
+  DisableIncidency(shared_ptr<Face> face);
+
+  /**
+   * @brief Return previously disabled edge that uses @p face back to the graph
+   * @return GlobalRouter on the other side of the edge or 0 if no disabled edge uses @p face
+   */
+  Ptr<GlobalRouter>
+  EnableIncidency(shared_ptr<Face> face);
+
+  /**
+   * @brief Check whether an active edge uses @p face
+   */
+  bool
+  HasIncidency(shared_ptr<Face> face) const;
+
+  /**
+   * @brief Check whether a disabled edge uses @p face
+   */
+  bool
+  HasDisabledIncidency(shared_ptr<Face> face) const;
+
+  /**
+   * @brief Get shortest path tree rooted at this node
+   *
+   * The tree is filled by GlobalRoutingHelper::CalculateRoutes and then maintained
+   * incrementally when links go down or up
+   */
+  ShortestPathTree&
+  GetShortestPathTree();
+
   /**
    * @brief Get list of locally exported prefixes
    */
@@ -125,6 +169,8 @@ private:
   Ptr<L3Protocol> m_ndn;
   LocalPrefixList m_localPrefixes;
   IncidencyList m_incidencies;
+  IncidencyList m_disabledIncidencies;
+  ShortestPathTree m_shortestPathTree;
 
   static uint32_t m_idCounter;
 };
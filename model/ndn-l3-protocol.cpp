@@ -24,6 +24,7 @@
 #include "ns3/log.h"
 #include "ns3/callback.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/object-vector.h"
 #include "ns3/pointer.h"
@@ -38,6 +39,7 @@
 #include <boost/property_tree/info_parser.hpp>
 
 #include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/validation-stage.hpp"
 #include "ns3/ndnSIM/NFD/daemon/mgmt/internal-face.hpp"
 #include "ns3/ndnSIM/NFD/daemon/mgmt/fib-manager.hpp"
 #include "ns3/ndnSIM/NFD/daemon/mgmt/face-manager.hpp"
@@ -69,6 +71,12 @@ L3Protocol::GetTypeId(void)
       .SetParent<Object>()
       .AddConstructor<L3Protocol>()
 
+      .AddAttribute("ValidationStage",
+                    "Install content validation stage (PITList paths, publications, location "
+                    "registration) into forwarding pipelines",
+                    BooleanValue(true), MakeBooleanAccessor(&L3Protocol::m_validationStage),
+                    MakeBooleanChecker())
+
       .AddTraceSource("OutInterests", "OutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_outInterests),
                       "ns3::ndn::L3Protocol::InterestTraceCallback")
@@ -171,6 +179,7 @@ private:
 
 L3Protocol::L3Protocol()
   : m_impl(new Impl())
+  , m_validationStage(true)
 {
   NS_LOG_FUNCTION(this);
 }
@@ -184,6 +193,10 @@ void
 L3Protocol::initialize()
 {
   m_impl->m_forwarder = make_shared<nfd::Forwarder>();
+  if (m_validationStage) {
+    m_impl->m_forwarder->addPipelineStage(
+      make_shared<nfd::fw::ValidationStage>(std::ref(*m_impl->m_forwarder)));
+  }
 
   initializeManagement();
   Simulator::ScheduleWithContext(m_node->GetId(), Seconds(0), &L3Protocol::initializeRibManager, this);
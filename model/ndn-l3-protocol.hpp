@@ -189,6 +189,8 @@ private:
   // These objects are aggregated, but for optimization, get them here
   Ptr<Node> m_node; ///< \brief node on which ndn stack is installed
 
+  bool m_validationStage; ///< \brief whether content validation stage is installed in forwarder
+
   TracedCallback<const Interest&, const Face&>
     m_inInterests; ///< @brief trace of incoming Interests
   TracedCallback<const Interest&, const Face&>
@@ -25,6 +25,7 @@
 
 #include "ndn-header.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
+#include "../utils/ndn-virtual-payload-tag.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -37,7 +38,12 @@ Convert::FromPacket(Ptr<Packet> packet)
   packet->RemoveHeader(header);
 
   auto pkt = header.getPacket();
-  pkt->setTag(make_shared<Ns3PacketTag>(packet));
+  // tags are stored by value inside the packet, no allocation per hop
+  pkt->setInlineTag(Ns3PacketTag(packet));
+  if (packet->GetSize() > 0) {
+    // bytes after the header are virtual payload of the packet
+    pkt->setInlineTag(VirtualPayloadTag(packet->GetSize()));
+  }
 
   return pkt;
 }
@@ -56,12 +62,19 @@ Convert::ToPacket(const T& pkt)
 
   Ptr<Packet> packet;
 
-  auto tag = pkt.template getTag<Ns3PacketTag>();
+  const Ns3PacketTag* tag = pkt.template findTag<Ns3PacketTag>();
   if (tag != nullptr) {
     packet = tag->getPacket()->Copy();
   }
   else {
-    packet = Create<Packet>();
+    const VirtualPayloadTag* payloadTag = pkt.template findTag<VirtualPayloadTag>();
+    if (payloadTag != nullptr) {
+      // zero-filled payload, which takes no memory
+      packet = Create<Packet>(payloadTag->getSize());
+    }
+    else {
+      packet = Create<Packet>();
+    }
   }
 
   packet->AddHeader(header);
@@ -25,23 +25,77 @@
 #include "common.hpp"
 #include "tag.hpp"
 
+#include <array>
+#include <atomic>
 #include <map>
+#include <new>
+#include <type_traits>
 
 namespace ndn {
 
+namespace detail {
+
+/** \brief allocate the next dense slot number for a tag type
+ */
+inline size_t
+allocateTagSlot()
+{
+  static std::atomic<size_t> nSlots(0);
+  return nSlots++;
+}
+
+/** \return slot number of tag type T, registered on the first use of T
+ */
+template<typename T>
+inline size_t
+getTagSlot()
+{
+  static const size_t slot = allocateTagSlot();
+  return slot;
+}
+
+} // namespace detail
+
 /** \brief Base class to store tag information (e.g., inside Interest and Data packets)
+ *
+ *  Every tag type is registered in a process-wide slot on its first use.  Tags of the first
+ *  N_SLOTS registered types are kept in a fixed array; other tags are kept in a map allocated
+ *  on demand.  Small tags set with setInlineTag are stored by value inside the tag host, so
+ *  that attaching, copying, removing and reading them with findTag does not allocate memory.
  */
 class TagHost
 {
 public:
+  TagHost() = default;
+
+  TagHost(const TagHost& other);
+
+  TagHost&
+  operator=(const TagHost& other);
+
+  ~TagHost();
+
   /** \brief get a tag item
    *  \tparam T type of the tag, which must be a subclass of ndn::Tag
    *  \retval nullptr if no Tag of type T is stored
+   *  \note The returned pointer always owns the tag.  If the tag is stored by value (see
+   *        setInlineTag), it owns a newly allocated copy of the tag; use findTag to read such
+   *        a tag without allocation.
    */
   template<typename T>
   shared_ptr<T>
   getTag() const;
 
+  /** \brief get a tag item without taking ownership
+   *  \tparam T type of the tag, which must be a subclass of ndn::Tag
+   *  \retval nullptr if no Tag of type T is stored
+   *  \warning The returned pointer is valid only until the tag is replaced or removed, or the
+   *           tag host is destroyed.  It must not be kept beyond the processing of the packet.
+   */
+  template<typename T>
+  const T*
+  findTag() const;
+
   /** \brief set a tag item
    *  \tparam T type of the tag, which must be a subclass of ndn::Tag
    *  \note Tag can be set even on a const tag host instance
@@ -50,6 +104,17 @@ public:
   void
   setTag(shared_ptr<T> tag) const;
 
+  /** \brief set a tag item stored by value inside the tag host
+   *  \tparam T type of the tag, which must be a copyable subclass of ndn::Tag
+   *
+   *  Up to N_INLINE_TAGS tags of at most INLINE_TAG_SIZE bytes are stored without memory
+   *  allocation; beyond that, a copy of the tag is allocated as with setTag.
+   *  \note Tag can be set even on a const tag host instance
+   */
+  template<typename T>
+  void
+  setInlineTag(const T& tag) const;
+
   /** \brief remove tag item
    *  \note Tag can be removed even on a const tag host instance
    */
@@ -57,10 +122,181 @@ public:
   void
   removeTag() const;
 
+public:
+  static constexpr size_t N_SLOTS = 4;
+  static constexpr size_t N_INLINE_TAGS = 2;
+  static constexpr size_t INLINE_TAG_SIZE = 2 * sizeof(void*);
+
 private:
-  mutable std::map<size_t, shared_ptr<Tag>> m_tags;
+  /** \return pointer to the tag in \p slot, or nullptr if the slot has not been used
+   */
+  const shared_ptr<Tag>*
+  findSlot(size_t slot) const;
+
+  shared_ptr<Tag>&
+  getSlot(size_t slot) const;
+
+  /** \return whether \p tag is stored by value inside this tag host
+   */
+  bool
+  isInline(const Tag* tag) const;
+
+  /** \brief remove tag from \p slot, destroying it if it is stored by value
+   */
+  void
+  resetSlot(size_t slot) const;
+
+  void
+  copyFrom(const TagHost& other);
+
+  void
+  clear();
+
+  template<typename T>
+  static Tag*
+  copyInlineTag(const Tag& tag, void* storage)
+  {
+    return new (storage) T(static_cast<const T&>(tag));
+  }
+
+private:
+  struct InlineTag
+  {
+    std::aligned_storage<INLINE_TAG_SIZE, alignof(void*)>::type storage;
+    size_t slot;
+    Tag* (*copy)(const Tag& tag, void* storage) = nullptr; ///< nullptr if storage is not used
+
+    bool
+    contains(const Tag* tag) const
+    {
+      auto begin = reinterpret_cast<const char*>(&storage);
+      auto ptr = reinterpret_cast<const char*>(tag);
+      return copy != nullptr && ptr >= begin && ptr < begin + sizeof(storage);
+    }
+  };
+
+  mutable std::array<shared_ptr<Tag>, N_SLOTS> m_slots;
+  mutable unique_ptr<std::map<size_t, shared_ptr<Tag>>> m_moreSlots;
+  mutable std::array<InlineTag, N_INLINE_TAGS> m_inlineTags;
 };
 
+inline
+TagHost::TagHost(const TagHost& other)
+{
+  copyFrom(other);
+}
+
+inline TagHost&
+TagHost::operator=(const TagHost& other)
+{
+  if (this != &other) {
+    clear();
+    copyFrom(other);
+  }
+  return *this;
+}
+
+inline
+TagHost::~TagHost()
+{
+  clear();
+}
+
+inline const shared_ptr<Tag>*
+TagHost::findSlot(size_t slot) const
+{
+  if (slot < N_SLOTS) {
+    return &m_slots[slot];
+  }
+  if (m_moreSlots == nullptr) {
+    return nullptr;
+  }
+  auto it = m_moreSlots->find(slot);
+  return it == m_moreSlots->end() ? nullptr : &it->second;
+}
+
+inline shared_ptr<Tag>&
+TagHost::getSlot(size_t slot) const
+{
+  if (slot < N_SLOTS) {
+    return m_slots[slot];
+  }
+  if (m_moreSlots == nullptr) {
+    m_moreSlots.reset(new std::map<size_t, shared_ptr<Tag>>);
+  }
+  return (*m_moreSlots)[slot];
+}
+
+inline bool
+TagHost::isInline(const Tag* tag) const
+{
+  for (const InlineTag& inlineTag : m_inlineTags) {
+    if (inlineTag.contains(tag)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline void
+TagHost::resetSlot(size_t slot) const
+{
+  const shared_ptr<Tag>* tag = findSlot(slot);
+  if (tag == nullptr || *tag == nullptr) {
+    return;
+  }
+
+  for (InlineTag& inlineTag : m_inlineTags) {
+    if (inlineTag.contains(tag->get())) {
+      (*tag)->~Tag();
+      inlineTag.copy = nullptr;
+      break;
+    }
+  }
+
+  if (slot < N_SLOTS) {
+    m_slots[slot].reset();
+  }
+  else {
+    m_moreSlots->erase(slot);
+  }
+}
+
+inline void
+TagHost::copyFrom(const TagHost& other)
+{
+  m_slots = other.m_slots;
+  if (other.m_moreSlots != nullptr) {
+    m_moreSlots.reset(new std::map<size_t, shared_ptr<Tag>>(*other.m_moreSlots));
+  }
+
+  // re-point tags stored by value to copies in this tag host
+  for (size_t i = 0; i < N_INLINE_TAGS; ++i) {
+    const InlineTag& otherTag = other.m_inlineTags[i];
+    if (otherTag.copy == nullptr) {
+      continue;
+    }
+    Tag* tag = otherTag.copy(**other.findSlot(otherTag.slot), &m_inlineTags[i].storage);
+    m_inlineTags[i].slot = otherTag.slot;
+    m_inlineTags[i].copy = otherTag.copy;
+    getSlot(otherTag.slot) = shared_ptr<Tag>(shared_ptr<Tag>(), tag);
+  }
+}
+
+inline void
+TagHost::clear()
+{
+  for (InlineTag& inlineTag : m_inlineTags) {
+    if (inlineTag.copy != nullptr) {
+      resetSlot(inlineTag.slot);
+    }
+  }
+
+  for (shared_ptr<Tag>& tag : m_slots) {
+    tag.reset();
+  }
+  m_moreSlots.reset();
+}
 
 template<typename T>
 inline shared_ptr<T>
@@ -68,11 +304,28 @@ TagHost::getTag() const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
-  auto it = m_tags.find(T::getTypeId());
-  if (it == m_tags.end()) {
+  const shared_ptr<Tag>* tag = findSlot(detail::getTagSlot<T>());
+  if (tag == nullptr || *tag == nullptr) {
     return nullptr;
   }
-  return static_pointer_cast<T>(it->second);
+  if (isInline(tag->get())) {
+    // the caller may keep the tag beyond the lifetime of the tag host
+    return make_shared<T>(static_cast<const T&>(**tag));
+  }
+  return static_pointer_cast<T>(*tag);
+}
+
+template<typename T>
+inline const T*
+TagHost::findTag() const
+{
+  static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
+
+  const shared_ptr<Tag>* tag = findSlot(detail::getTagSlot<T>());
+  if (tag == nullptr) {
+    return nullptr;
+  }
+  return static_cast<const T*>(tag->get());
 }
 
 template<typename T>
@@ -81,19 +334,43 @@ TagHost::setTag(shared_ptr<T> tag) const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
-  if (tag == nullptr) {
-    m_tags.erase(T::getTypeId());
-    return;
+  size_t slot = detail::getTagSlot<T>();
+  resetSlot(slot);
+
+  if (tag != nullptr) {
+    getSlot(slot) = tag;
+  }
+}
+
+template<typename T>
+inline void
+TagHost::setInlineTag(const T& tag) const
+{
+  static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
+
+  size_t slot = detail::getTagSlot<T>();
+  resetSlot(slot);
+
+  if (sizeof(T) <= INLINE_TAG_SIZE && alignof(T) <= alignof(void*)) {
+    for (InlineTag& inlineTag : m_inlineTags) {
+      if (inlineTag.copy == nullptr) {
+        Tag* stored = copyInlineTag<T>(tag, &inlineTag.storage);
+        inlineTag.slot = slot;
+        inlineTag.copy = &copyInlineTag<T>;
+        getSlot(slot) = shared_ptr<Tag>(shared_ptr<Tag>(), stored);
+        return;
+      }
+    }
   }
 
-  m_tags[T::getTypeId()] = tag;
+  getSlot(slot) = make_shared<T>(tag);
 }
 
 template<typename T>
 inline void
 TagHost::removeTag() const
 {
-  setTag<T>(nullptr);
+  resetSlot(detail::getTagSlot<T>());
 }
 
 } // namespace ndn
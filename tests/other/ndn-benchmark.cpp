@@ -0,0 +1,413 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <sys/time.h>
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+#include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * Throughput benchmark of the forwarding hot paths.
+ *
+ * One run simulates one scenario, a combination of
+ *
+ *  - topology: line, tree (binary), grid or rocketfuel (.cch map file given with --topology-file)
+ *  - workload: cbr (ConsumerCbr/Producer), zipf (ConsumerZipfMandelbrot/Producer) or
+ *    kan (ConsumerZipfMandelbrotKan/ProducerKanV2, validation and publications)
+ *  - content store: empty for NFD's CS, or an old content store class (e.g., ns3::ndn::cs::Lru)
+ *  - forwarding strategy
+ *
+ * and appends one tab-separated line to the output (header is written when the output is empty):
+ * wall-clock time, number of scheduled simulator events per real second, number of Interests
+ * received by forwarders per real second, peak resident set size and the number of entries of
+ * every table summed over all nodes.
+ *
+ * Links are fast enough not to drop packets, so the numbers reflect forwarding work only.
+ * Random streams depend only on --RngSeed and --RngRun, so a scenario is reproducible between
+ * builds.
+ *
+ *     ./waf --run "ndn-benchmark --topology=grid --size=5 --workload=zipf --output=bench.txt"
+ *
+ * ndn-benchmark.sh runs the whole matrix of scenarios.
+ */
+
+class Benchmark {
+public:
+  Benchmark()
+    : m_topology("line")
+    , m_size(5)
+    , m_workload("cbr")
+    , m_csSize(100)
+    , m_strategy("/localhost/nfd/strategy/best-route")
+    , m_interestRate(100)
+    , m_nContents(10000)
+    , m_simulationTime(Seconds(20))
+    , m_output("-")
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  bool
+  createTopology();
+
+  void
+  installApps();
+
+  void
+  printResults(std::ostream& os, bool shouldPrintHeader, double realTime, uint64_t nEvents);
+
+private:
+  std::string m_topology;
+  uint32_t m_size;
+  std::string m_topologyFile;
+  std::string m_workload;
+  std::string m_oldContentStore;
+  size_t m_csSize;
+  std::string m_strategy;
+  double m_interestRate;
+  uint32_t m_nContents;
+  Time m_simulationTime;
+  std::string m_output;
+
+  NodeContainer m_consumers;
+  Ptr<Node> m_producer;
+};
+
+static void
+noop()
+{
+}
+
+bool
+Benchmark::createTopology()
+{
+  PointToPointHelper p2p;
+
+  if (m_topology == "line") {
+    // consumer -- ( ) -- ... -- ( ) -- producer
+    NodeContainer nodes;
+    nodes.Create(std::max<uint32_t>(m_size, 2));
+    for (uint32_t i = 1; i < nodes.GetN(); i++) {
+      p2p.Install(nodes.Get(i - 1), nodes.Get(i));
+    }
+    m_consumers.Add(nodes.Get(0));
+    m_producer = nodes.Get(nodes.GetN() - 1);
+  }
+  else if (m_topology == "tree") {
+    // producer at the root of the binary tree of depth m_size, consumers at the leaves
+    NodeContainer nodes;
+    nodes.Create((1 << (std::max<uint32_t>(m_size, 1) + 1)) - 1);
+    for (uint32_t i = 1; i < nodes.GetN(); i++) {
+      p2p.Install(nodes.Get((i - 1) / 2), nodes.Get(i));
+      if (2 * i + 1 >= nodes.GetN()) {
+        m_consumers.Add(nodes.Get(i));
+      }
+    }
+    m_producer = nodes.Get(0);
+  }
+  else if (m_topology == "grid") {
+    // consumers in the first column, producer in the opposite corner
+    PointToPointGridHelper grid(m_size, m_size, p2p);
+    grid.BoundingBox(100, 100, 200, 200);
+    for (uint32_t row = 0; row < m_size; row++) {
+      m_consumers.Add(grid.GetNode(row, 0));
+    }
+    m_producer = grid.GetNode(m_size - 1, m_size - 1);
+  }
+  else if (m_topology == "rocketfuel") {
+    // consumers at the customer routers, producer at a backbone router
+    RocketfuelParams params;
+    params.averageRtt = 2.0;
+    params.clientNodeDegrees = 2;
+    params.minb2bBandwidth = "10000Mbps";
+    params.minb2bDelay = "5ms";
+    params.maxb2bBandwidth = "10000Mbps";
+    params.maxb2bDelay = "10ms";
+    params.minb2gBandwidth = "10000Mbps";
+    params.minb2gDelay = "5ms";
+    params.maxb2gBandwidth = "10000Mbps";
+    params.maxb2gDelay = "10ms";
+    params.ming2cBandwidth = "10000Mbps";
+    params.ming2cDelay = "5ms";
+    params.maxg2cBandwidth = "10000Mbps";
+    params.maxg2cDelay = "10ms";
+
+    RocketfuelMapReader reader("", 1.0);
+    reader.SetFileName(m_topologyFile);
+    reader.Read(params);
+    if (reader.GetBackboneRouters().GetN() == 0 || reader.GetCustomerRouters().GetN() == 0) {
+      std::cerr << "Cannot read Rocketfuel map from [" << m_topologyFile << "]" << std::endl;
+      return false;
+    }
+    m_consumers.Add(reader.GetCustomerRouters());
+    m_producer = reader.GetBackboneRouters().Get(0);
+  }
+  else {
+    std::cerr << "Unknown topology [" << m_topology << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void
+Benchmark::installApps()
+{
+  std::string prefix = "/prefix";
+  std::string rate = std::to_string(m_interestRate);
+  std::string nContents = std::to_string(m_nContents);
+
+  if (m_workload == "cbr") {
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix(prefix);
+    consumerHelper.SetAttribute("Frequency", StringValue(rate));
+    consumerHelper.Install(m_consumers);
+
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(prefix);
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(m_producer);
+  }
+  else if (m_workload == "zipf") {
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrot");
+    consumerHelper.SetPrefix(prefix);
+    consumerHelper.SetAttribute("Frequency", StringValue(rate));
+    consumerHelper.SetAttribute("NumberOfContents", StringValue(nContents));
+    consumerHelper.SetAttribute("q", StringValue("0"));
+    consumerHelper.SetAttribute("s", StringValue("1.2"));
+    consumerHelper.Install(m_consumers);
+
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(prefix);
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(m_producer);
+  }
+  else {
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrotKan");
+    consumerHelper.SetPrefix(prefix);
+    consumerHelper.SetAttribute("Frequency", StringValue(rate));
+    consumerHelper.SetAttribute("NumberOfContents", StringValue(nContents));
+    consumerHelper.SetAttribute("q", StringValue("0"));
+    consumerHelper.SetAttribute("s", StringValue("1.2"));
+    consumerHelper.Install(m_consumers);
+
+    ndn::AppHelper producerHelper("ns3::ndn::ProducerKanV2");
+    producerHelper.SetPrefix(prefix);
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.SetAttribute("AverageUpdateTime", StringValue("5"));
+    producerHelper.SetAttribute("ExprimentTime",
+                                StringValue(std::to_string(
+                                  static_cast<uint32_t>(m_simulationTime.GetSeconds()))));
+    producerHelper.Install(m_producer);
+  }
+}
+
+void
+Benchmark::printResults(std::ostream& os, bool shouldPrintHeader, double realTime,
+                        uint64_t nEvents)
+{
+  uint64_t nInterests = 0;
+  uint64_t nFib = 0;
+  uint64_t nPit = 0;
+  uint64_t nMeasurements = 0;
+  uint64_t nNameTree = 0;
+  uint64_t nCs = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<ndn::L3Protocol> l3 = (*node)->GetObject<ndn::L3Protocol>();
+    if (l3 == nullptr)
+      continue;
+
+    shared_ptr<nfd::Forwarder> forwarder = l3->getForwarder();
+    nInterests += forwarder->getCounters().getNInInterests();
+    nFib += forwarder->getFib().size();
+    nPit += forwarder->getPit().size();
+    nMeasurements += forwarder->getMeasurements().size();
+    nNameTree += forwarder->getNameTree().size();
+
+    Ptr<ndn::ContentStore> cs = (*node)->GetObject<ndn::ContentStore>();
+    if (cs != nullptr) {
+      nCs += cs->GetSize();
+    }
+    else {
+      nCs += forwarder->getCs().size();
+    }
+  }
+
+  if (shouldPrintHeader) {
+    os << "Topology"
+       << "\t"
+       << "Nodes"
+       << "\t"
+       << "Workload"
+       << "\t"
+       << "Cs"
+       << "\t"
+       << "Strategy"
+       << "\t"
+       << "SimulationTime"
+       << "\t"
+       << "RealTime"
+       << "\t"
+       << "Events"
+       << "\t"
+       << "EventsPerSec"
+       << "\t"
+       << "Interests"
+       << "\t"
+       << "InterestsPerSec"
+       << "\t"
+       << "PeakRssKiB"
+       << "\t"
+       << "Fib"
+       << "\t"
+       << "Pit"
+       << "\t"
+       << "Measurements"
+       << "\t"
+       << "NameTree"
+       << "\t"
+       << "CsEntries"
+       << "\n";
+  }
+
+  os << m_topology << "\t" << NodeList::GetNNodes() << "\t" << m_workload << "\t"
+     << (m_oldContentStore.empty() ? "nfd" : m_oldContentStore) << "\t" << m_strategy << "\t"
+     << m_simulationTime.ToDouble(Time::S) << "\t" << realTime << "\t" << nEvents << "\t"
+     << nEvents / realTime << "\t" << nInterests << "\t" << nInterests / realTime << "\t"
+     << MemUsage::GetPeak() / 1024 << "\t" << nFib << "\t" << nPit << "\t" << nMeasurements
+     << "\t" << nNameTree << "\t" << nCs << "\n";
+}
+
+int
+Benchmark::run(int argc, char* argv[])
+{
+  // fast links, so that the benchmark measures forwarding rather than queue drops
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10000Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("1000"));
+
+  CommandLine cmd;
+  cmd.AddValue("topology", "Topology (line, tree, grid, rocketfuel)", m_topology);
+  cmd.AddValue("size", "Number of nodes of line, depth of tree, or side of grid", m_size);
+  cmd.AddValue("topology-file", "Rocketfuel map file (.cch) for rocketfuel topology",
+               m_topologyFile);
+  cmd.AddValue("workload", "Workload (cbr, zipf, kan)", m_workload);
+  cmd.AddValue("old-cs", "Old content store to use, NFD's CS if empty "
+                         "(e.g., ns3::ndn::cs::Lru, ns3::ndn::cs::Lfu, ...)",
+               m_oldContentStore);
+  cmd.AddValue("cs-size", "Maximum number of cached packets per node", m_csSize);
+  cmd.AddValue("strategy", "Forwarding strategy "
+                           "(e.g., /localhost/nfd/strategy/multicast, "
+                           "/localhost/nfd/strategy/best-route, ...)",
+               m_strategy);
+  cmd.AddValue("rate", "Interest rate per consumer", m_interestRate);
+  cmd.AddValue("contents", "Number of contents for zipf and kan workloads", m_nContents);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.AddValue("output", "File to which results are appended, - for std::cout", m_output);
+  cmd.Parse(argc, argv);
+
+  if (m_workload != "cbr" && m_workload != "zipf" && m_workload != "kan") {
+    std::cerr << "Unknown workload [" << m_workload << "]" << std::endl;
+    return 1;
+  }
+
+  // validation and publications are handled by ndnSIM's content store only
+  if (m_workload == "kan" && m_oldContentStore.empty()) {
+    m_oldContentStore = "ns3::ndn::cs::Lru";
+  }
+
+  if (!createTopology()) {
+    return 1;
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setCsSize(m_csSize);
+  if (!m_oldContentStore.empty()) {
+    ndnHelper.setCsSize(0);
+    ndnHelper.SetOldContentStore(m_oldContentStore, "MaxSize", std::to_string(m_csSize));
+  }
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", m_strategy);
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  installApps();
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", m_producer);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Simulator::Stop(m_simulationTime);
+
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  double beginRealTime = t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+
+  Simulator::Run();
+
+  gettimeofday(&t, NULL);
+  double realTime = t.tv_sec + (0.000001 * (unsigned)t.tv_usec) - beginRealTime;
+
+  // event uids are assigned sequentially, so the uid of a new event is the number of
+  // events scheduled during the run
+  EventId probe = Simulator::ScheduleNow(&noop);
+  uint64_t nEvents = probe.GetUid();
+  Simulator::Cancel(probe);
+
+  if (m_output == "-") {
+    printResults(std::cout, true, realTime, nEvents);
+  }
+  else {
+    bool shouldPrintHeader = !std::ifstream(m_output.c_str()).good();
+    std::ofstream os(m_output.c_str(), std::ios_base::out | std::ios_base::app);
+    if (!os.is_open()) {
+      std::cerr << "File " << m_output << " cannot be opened for writing" << std::endl;
+      return 1;
+    }
+    printResults(os, shouldPrintHeader, realTime, nEvents);
+  }
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Benchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,42 @@
+#!/bin/bash
+
+# Runs the matrix of ndn-benchmark scenarios and appends results to ${output}
+# (tab-separated, one line per scenario).  A Rocketfuel map can be given as the first argument,
+# e.g., ./ndn-benchmark.sh maps/1755.r0.cch
+
+rocketfuel=$1
+output=${OUTPUT:-benchmark-$(date +%Y%m%d-%H%M%S).txt}
+sim_time=20
+rate=100
+
+topologies="line:10 tree:5 grid:5"
+if [ -n "${rocketfuel}" ]; then
+  topologies="${topologies} rocketfuel:0"
+fi
+
+run() {
+  ../../../waf --run ndn-benchmark --command-template="%s --RngSeed=1 --RngRun=1 --output=${output} --sim-time=${sim_time} --rate=${rate} --topology-file=${rocketfuel} $*"
+}
+
+echo "Writing results to ${output}.."
+
+for topology in ${topologies}; do
+  name=${topology%:*}
+  size=${topology#*:}
+
+  # forwarding strategies, using NFD's CS
+  for strategy in best-route multicast ncc; do
+    for workload in cbr zipf; do
+      echo "topology=${name}, workload=${workload}, strategy=${strategy}"
+      run --topology=${name} --size=${size} --workload=${workload} --strategy=/localhost/nfd/strategy/${strategy}
+    done
+  done
+
+  # content store implementations, using best route strategy
+  for cs in Lru Fifo Random Lfu Lfu2 Random2 S4Lru Arc WTinyLfu Gdsf Nocache; do
+    for workload in zipf kan; do
+      echo "topology=${name}, workload=${workload}, cs=${cs}"
+      run --topology=${name} --size=${size} --workload=${workload} --old-cs=ns3::ndn::cs::${cs}
+    done
+  done
+done
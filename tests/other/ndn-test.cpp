@@ -48,6 +48,8 @@ public:
   Tester()
     : m_csSize(100)
     , m_interestRate(1000)
+    , m_consumer("ns3::ndn::ConsumerCbr")
+    , m_nContents(0)
     , m_shouldEvaluatePit(false)
     , m_simulationTime(Seconds(2000) / m_interestRate)
   {
@@ -66,6 +68,8 @@ private:
   std::string m_oldContentStore;
   size_t m_csSize;
   double m_interestRate;
+  std::string m_consumer;
+  uint32_t m_nContents;
   bool m_shouldEvaluatePit;
   std::string m_strategy;
   double m_initialOverhead;
@@ -110,7 +114,7 @@ Tester::printStats(std::ostream& os, Time nextPrintTime, double beginRealTime)
     if (pitSize != 0)
       pitCount += pitSize;
 
-    if (true != true) {
+    if (!m_oldContentStore.empty()) {
       Ptr<ndn::ContentStore> cs = (*node)->GetObject<ndn::ContentStore>();
       if (cs != 0)
         csCount += cs->GetSize();
@@ -168,6 +172,11 @@ Tester::run(int argc, char* argv[])
                m_oldContentStore);
   cmd.AddValue("cs-size", "Maximum number of cached packets per node", m_csSize);
   cmd.AddValue("rate", "Interest rate", m_interestRate);
+  cmd.AddValue("consumer", "Consumer application to use "
+                           "(e.g., ns3::ndn::ConsumerCbr, ns3::ndn::ConsumerZipfMandelbrot)",
+               m_consumer);
+  cmd.AddValue("contents", "Number of contents requested by ns3::ndn::ConsumerZipfMandelbrot",
+               m_nContents);
   cmd.AddValue("pit", "Perform PIT evaluation if this parameter is true",
                m_shouldEvaluatePit);
   cmd.AddValue("strategy", "Choose forwarding strategy "
@@ -203,10 +212,13 @@ Tester::run(int argc, char* argv[])
   // Installing applications
 
   // Consumer
-  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
-  // Consumer will request /prefix/0, /prefix/1, ...
+  ndn::AppHelper consumerHelper(m_consumer);
+  // Consumer will request /prefix/0, /prefix/1, ... (or a Zipf-Mandelbrot sample of them)
   consumerHelper.SetPrefix("/prefix");
   consumerHelper.SetAttribute("Frequency", DoubleValue(m_interestRate));
+  if (m_nContents > 0) {
+    consumerHelper.SetAttribute("NumberOfContents", UintegerValue(m_nContents));
+  }
   consumerHelper.Install(nodes.Get(0)); // first node
 
   if (!m_shouldEvaluatePit) {
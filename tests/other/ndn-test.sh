@@ -52,3 +52,26 @@ echo
 echo "Using best route forwarding strategy.."
 
 ../../../waf --run ndn-test --command-template="%s --cs-size=${size} --rate=${rate} --strategy="/localhost/nfd/strategy/best-route" --sim-time=${sim_time}"
+
+echo
+
+rate=1000
+sim_time=200
+
+# scenarios comparing the original and O(1) replacement policies of the ndnSIM CS
+echo "Comparing ndnSIM's CS replacement policies.."
+
+# Zipf-Mandelbrot requests over ten times more contents than the CS holds, so that the CS fills
+# within the first part of the run and popular names are requested again
+for size in 1000 10000; do
+  contents=$(( 10 * size ))
+  echo "CS size = " $size, "contents = " $contents, "interest rate = " $rate
+
+  for policy in Lfu Lfu2 Random Random2; do
+    echo "Using ns3::ndn::cs::${policy} replacement policy.."
+
+    ../../../waf --run ndn-test --command-template="%s --old-cs=ns3::ndn::cs::${policy} --cs-size=${size} --rate=${rate} --consumer=ns3::ndn::ConsumerZipfMandelbrot --contents=${contents} --strategy="/localhost/nfd/strategy/best-route" --sim-time=${sim_time}"
+
+    echo
+  done
+done
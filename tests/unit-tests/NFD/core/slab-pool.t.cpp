@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/core/slab-pool.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::SlabPool;
+using nfd::SlabAllocator;
+
+BOOST_FIXTURE_TEST_SUITE(NfdCoreSlabPool, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Reuse)
+{
+  SlabPool pool(4);
+
+  void* b1 = pool.allocate(20);
+  void* b2 = pool.allocate(24);
+  BOOST_CHECK(b1 != b2);
+  BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(b1) % SlabPool::ALIGNMENT, 0);
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), 2);
+  BOOST_CHECK_EQUAL(pool.getNBytesReserved(), 4 * 2 * SlabPool::ALIGNMENT);
+
+  pool.deallocate(b1, 20);
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), 1);
+
+  // same size class reuses the freed block without a new slab
+  void* b3 = pool.allocate(32);
+  BOOST_CHECK(b3 == b1);
+  BOOST_CHECK_EQUAL(pool.getNBytesReserved(), 4 * 2 * SlabPool::ALIGNMENT);
+
+  void* big = pool.allocate(SlabPool::MAX_BLOCK_SIZE + 1);
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), 3);
+  pool.deallocate(big, SlabPool::MAX_BLOCK_SIZE + 1);
+  BOOST_CHECK_EQUAL(pool.getNBytesReserved(), 4 * 2 * SlabPool::ALIGNMENT);
+
+  pool.deallocate(b2, 24);
+  pool.deallocate(b3, 32);
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), 0);
+  BOOST_CHECK_EQUAL(pool.getNBytesInUse(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AllocateShared)
+{
+  shared_ptr<SlabPool> pool = make_shared<SlabPool>();
+  shared_ptr<Name> name = std::allocate_shared<Name>(SlabAllocator<Name>(pool), "/A/B");
+  BOOST_CHECK_EQUAL(*name, "/A/B");
+  BOOST_CHECK_EQUAL(pool->getNBlocksInUse(), 1);
+
+  // the object keeps the pool alive
+  weak_ptr<SlabPool> weakPool = pool;
+  pool.reset();
+  BOOST_CHECK(!weakPool.expired());
+
+  name.reset();
+  BOOST_CHECK(weakPool.expired());
+}
+
+BOOST_AUTO_TEST_CASE(PitEntries)
+{
+  nfd::Forwarder forwarder;
+  nfd::Pit& pit = forwarder.getPit();
+  const SlabPool& pool = forwarder.getNameTree().getPool();
+  size_t nBlocksBaseline = pool.getNBlocksInUse();
+
+  std::vector<shared_ptr<nfd::pit::Entry>> entries;
+  for (int i = 0; i < 100; i++) {
+    entries.push_back(pit.insert(*make_shared<Interest>(Name("/pit").appendNumber(i))).first);
+  }
+  BOOST_CHECK_EQUAL(pit.size(), 100);
+  BOOST_CHECK_GT(pool.getNBlocksInUse(), nBlocksBaseline);
+  size_t nBytesReserved = pool.getNBytesReserved();
+
+  for (const shared_ptr<nfd::pit::Entry>& entry : entries) {
+    pit.erase(entry);
+  }
+  entries.clear();
+  BOOST_CHECK_EQUAL(pit.size(), 0);
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), nBlocksBaseline);
+
+  // the same entries again reuse the freed blocks
+  for (int i = 0; i < 100; i++) {
+    entries.push_back(pit.insert(*make_shared<Interest>(Name("/pit").appendNumber(i))).first);
+  }
+  BOOST_CHECK_EQUAL(pool.getNBytesReserved(), nBytesReserved);
+
+  for (const shared_ptr<nfd::pit::Entry>& entry : entries) {
+    pit.erase(entry);
+  }
+  entries.clear();
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), nBlocksBaseline);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
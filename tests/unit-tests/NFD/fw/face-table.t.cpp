@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/fw/face-table.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "NFD/tests/daemon/face/dummy-face.hpp"
+
+#include "../../tests-common.hpp"
+
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::tests::DummyFace;
+
+BOOST_FIXTURE_TEST_SUITE(NfdFwFaceTable, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(ReuseSlot)
+{
+  nfd::Forwarder forwarder;
+  nfd::FaceTable& faceTable = forwarder.getFaceTable();
+
+  shared_ptr<nfd::Face> face1 = make_shared<DummyFace>();
+  shared_ptr<nfd::Face> face2 = make_shared<DummyFace>();
+  shared_ptr<nfd::Face> face3 = make_shared<DummyFace>();
+  faceTable.add(face1);
+  faceTable.add(face2);
+  nfd::FaceId oldId1 = face1->getId();
+  nfd::FaceId id2 = face2->getId();
+
+  face1->close();
+  BOOST_CHECK(faceTable.get(oldId1) == nullptr);
+  BOOST_CHECK(faceTable.get(id2) == face2);
+
+  // slot of face1 is reused, but its old FaceId does not find the new Face
+  faceTable.add(face3);
+  BOOST_CHECK_NE(face3->getId(), oldId1);
+  BOOST_CHECK_GT(face3->getId(), nfd::FACEID_RESERVED_MAX);
+  BOOST_CHECK(faceTable.get(oldId1) == nullptr);
+  BOOST_CHECK(faceTable.get(face3->getId()) == face3);
+  BOOST_CHECK(faceTable.get(id2) == face2);
+  BOOST_CHECK(faceTable.get(nfd::INVALID_FACEID) == nullptr);
+  BOOST_CHECK_EQUAL(faceTable.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(StaleIdAfterRemoval)
+{
+  nfd::Forwarder forwarder;
+  nfd::FaceTable& faceTable = forwarder.getFaceTable();
+
+  shared_ptr<nfd::Face> face1 = make_shared<DummyFace>();
+  faceTable.add(face1);
+  nfd::FaceId firstId = face1->getId();
+  face1->close();
+  BOOST_CHECK(faceTable.get(firstId) == nullptr);
+  BOOST_CHECK_EQUAL(faceTable.size(), 0);
+
+  // the slot is reused until its generation is exhausted, and is then retired, so the first
+  // FaceId never resolves to a live Face
+  std::set<nfd::FaceId> ids = {firstId};
+  for (int i = 0; i < 3000; i++) {
+    shared_ptr<nfd::Face> face = make_shared<DummyFace>();
+    faceTable.add(face);
+    BOOST_REQUIRE(ids.insert(face->getId()).second);
+    BOOST_REQUIRE(faceTable.get(firstId) == nullptr);
+    BOOST_REQUIRE(faceTable.get(face->getId()) == face);
+    face->close();
+  }
+  BOOST_CHECK_EQUAL(faceTable.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/fw/validation-stage.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "NFD/tests/daemon/face/dummy-face.hpp"
+
+#include "model/cs/content-store-impl.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::tests::DummyFace;
+
+class ValidationStageFixture : public CleanupFixture
+{
+public:
+  ValidationStageFixture()
+    : stage(make_shared<nfd::fw::ValidationStage>(std::ref(forwarder)))
+    , face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+  {
+    forwarder.addPipelineStage(stage);
+    forwarder.addFace(face1);
+    forwarder.addFace(face2);
+    forwarder.getFib().insert("/A").first->addNextHop(face2, 0);
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name, int validationDataFlag, int eligibility)
+  {
+    auto data = make_shared<Data>(name);
+    data->setValidationDataFlag(validationDataFlag);
+    data->setValidationPublishment(0);
+    data->setExpiration(0);
+    data->setEligibility(eligibility);
+    StackHelper::getKeyChain().sign(*data);
+    return data;
+  }
+
+  /**
+   * @brief Sends an Interest from face1 to face2, and returns the Data from face2
+   * @return whether the Data was forwarded back to face1
+   */
+  bool
+  fetch(const shared_ptr<Data>& data)
+  {
+    auto interest = make_shared<Interest>(data->getName());
+    interest->setNonce(++nonce);
+    face1->receiveInterest(*interest);
+
+    size_t nSentDatas = face1->m_sentDatas.size();
+    face2->receiveData(*data);
+    return face1->m_sentDatas.size() == nSentDatas + 1;
+  }
+
+public:
+  nfd::Forwarder forwarder;
+  shared_ptr<nfd::fw::ValidationStage> stage;
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+  uint32_t nonce = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdFwValidationStage, ValidationStageFixture)
+
+BOOST_AUTO_TEST_CASE(WithoutNdnSimCs)
+{
+  // plain Data is cached by the NFD Cs
+  BOOST_CHECK(!stage->beforeCacheInsert(*face2, *makeData("/A/0", 0, 0), makeData("/A/0", 0, 0)));
+  BOOST_CHECK(fetch(makeData("/A/0", 0, 0)));
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 1);
+
+  // Data answering a validation Interest is forwarded, but not cached
+  BOOST_CHECK(stage->beforeCacheInsert(*face2, *makeData("/A/1", 1, 0), makeData("/A/1", 1, 0)));
+  BOOST_CHECK(fetch(makeData("/A/1", 1, 0)));
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 1);
+
+  // eligible Data is cached by the NFD Cs, without a location registration
+  size_t nSentInterests = face2->m_sentInterests.size();
+  BOOST_CHECK(!stage->beforeCacheInsert(*face2, *makeData("/A/2", 1, 1), makeData("/A/2", 1, 1)));
+  BOOST_CHECK(fetch(makeData("/A/2", 1, 1)));
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 2);
+  BOOST_CHECK_EQUAL(face2->m_sentInterests.size(), nSentInterests + 1); // only the Interest
+}
+
+BOOST_AUTO_TEST_CASE(WithNdnSimCs)
+{
+  Ptr<ContentStore> cs = CreateObject<cs::ContentStoreImpl<ndnSIM::lru_policy_traits>>();
+  forwarder.setCsFromNdnSim(cs);
+
+  BOOST_CHECK(fetch(makeData("/A/0", 0, 0)));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 1);
+
+  BOOST_CHECK(fetch(makeData("/A/1", 1, 0)));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 1);
+
+  // eligible Data registers the location of this forwarder when it is cached for the first time
+  size_t nSentInterests = face2->m_sentInterests.size();
+  BOOST_CHECK(fetch(makeData("/A/2", 1, 1)));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+  BOOST_REQUIRE_EQUAL(face2->m_sentInterests.size(), nSentInterests + 2);
+  BOOST_CHECK_EQUAL(face2->m_sentInterests.back().getLocationRegistration(), 1);
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/table/cs.hpp"
+#include "NFD/daemon/table/cs-policy-lru.hpp"
+
+#include "helper/ndn-stack-helper.hpp"
+#include "utils/ndn-virtual-payload-tag.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class NfdCsFixture : public CleanupFixture
+{
+public:
+  static shared_ptr<Data>
+  makeData(const Name& name)
+  {
+    auto data = make_shared<Data>(name);
+    StackHelper::getKeyChain().sign(*data);
+    return data;
+  }
+
+  /**
+   * @brief Returns whether the Cs has a Data that matches the name
+   */
+  static bool
+  isCached(const nfd::Cs& cs, const Name& name)
+  {
+    bool isHit = false;
+    cs.find(Interest(name),
+            [&isHit] (const Interest&, const Data&) { isHit = true; },
+            [] (const Interest&) {});
+    return isHit;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdTableCs, NfdCsFixture)
+
+BOOST_AUTO_TEST_CASE(EvictByByteLimit)
+{
+  nfd::Cs cs(100);
+  cs.setPolicy(unique_ptr<nfd::cs::Policy>(new nfd::cs::LruPolicy()));
+
+  shared_ptr<Data> dataA = makeData("/A");
+  size_t dataSize = dataA->wireEncode().size();
+  cs.setByteLimit(2 * dataSize);
+
+  cs.insert(*dataA);
+  cs.insert(*makeData("/B"));
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 2 * dataSize);
+
+  // evict A
+  cs.insert(*makeData("/C"));
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 2 * dataSize);
+  BOOST_CHECK(!isCached(cs, "/A"));
+
+  // shrinking the limit evicts B
+  cs.setByteLimit(dataSize);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK(!isCached(cs, "/B"));
+  BOOST_CHECK(isCached(cs, "/C"));
+}
+
+BOOST_AUTO_TEST_CASE(VirtualPayloadBytes)
+{
+  nfd::Cs cs(100);
+  cs.setPolicy(unique_ptr<nfd::cs::Policy>(new nfd::cs::LruPolicy()));
+
+  shared_ptr<Data> dataA = makeData("/A");
+  size_t wireSize = dataA->wireEncode().size();
+  dataA->setInlineTag(VirtualPayloadTag(1024));
+  cs.setByteLimit(2 * wireSize + 1024);
+
+  cs.insert(*dataA);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), wireSize + 1024);
+  cs.insert(*makeData("/B"));
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 2 * wireSize + 1024);
+
+  // refreshing an entry does not count its bytes again
+  cs.insert(*dataA);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 2 * wireSize + 1024);
+
+  // the virtual payload counts towards the byte limit: C evicts B, then A
+  shared_ptr<Data> dataC = makeData("/C");
+  dataC->setInlineTag(VirtualPayloadTag(1024));
+  cs.insert(*dataC);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), wireSize + 1024);
+  BOOST_CHECK(!isCached(cs, "/A"));
+  BOOST_CHECK(!isCached(cs, "/B"));
+  BOOST_CHECK(isCached(cs, "/C"));
+
+  cs.setLimit(0);
+  BOOST_CHECK_EQUAL(cs.size(), 0);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
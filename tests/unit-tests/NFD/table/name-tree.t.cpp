@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/table/name-tree.hpp"
+#include "NFD/daemon/table/name-tree-prefix.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::NameTree;
+namespace name_tree = nfd::name_tree;
+
+BOOST_FIXTURE_TEST_SUITE(NfdTableNameTree, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Prefix)
+{
+  name_tree::Prefix root;
+  BOOST_CHECK(root.empty());
+  BOOST_CHECK_EQUAL(root.size(), 0);
+  BOOST_CHECK(root.equals(Name("/")));
+  BOOST_CHECK_EQUAL(root.toName(), Name("/"));
+
+  name_tree::Prefix a = root.append(name::Component("a"));
+  name_tree::Prefix ab = a.append(name::Component("b"));
+  name_tree::Prefix ac = a.append(name::Component("c"));
+  BOOST_CHECK_EQUAL(ab.size(), 2);
+  BOOST_CHECK_EQUAL(ab.back(), name::Component("b"));
+  BOOST_CHECK_EQUAL(ab.toName(), Name("/a/b"));
+  BOOST_CHECK_EQUAL(ac.toName(), Name("/a/c"));
+  BOOST_CHECK_EQUAL(a.toName(), Name("/a"));
+
+  BOOST_CHECK(ab.equals(Name("/a/b")));
+  BOOST_CHECK(!ab.equals(Name("/a/c")));
+  BOOST_CHECK(!ab.equals(Name("/x/b")));
+  BOOST_CHECK(!ab.equals(Name("/a")));
+  BOOST_CHECK(!ab.equals(Name("/a/b/c")));
+  BOOST_CHECK(ab.equals(Name("/a/b/c"), 2));
+  BOOST_CHECK(!ab.equals(Name("/a/b/c"), 1));
+  BOOST_CHECK(!ab.equals(Name("/a/x/c"), 2));
+
+  name_tree::Prefix abc(Name("/a/b/c"));
+  BOOST_CHECK_EQUAL(abc.size(), 3);
+  BOOST_CHECK(abc.equals(Name("/a/b/c")));
+}
+
+BOOST_AUTO_TEST_CASE(PrefixOwnsComponent)
+{
+  name_tree::Prefix prefix;
+  {
+    // the component is taken from a name that goes away, as from a packet
+    Name name("/packet/component");
+    prefix = prefix.append(name.get(0)).append(name.get(1));
+  }
+  BOOST_CHECK_EQUAL(prefix.toName(), Name("/packet/component"));
+  BOOST_CHECK_EQUAL(prefix.back(), name::Component("component"));
+}
+
+BOOST_AUTO_TEST_CASE(SharedPrefix)
+{
+  NameTree nt;
+
+  shared_ptr<name_tree::Entry> npeABC = nt.lookup("/a/b/c");
+  shared_ptr<name_tree::Entry> npeABD = nt.lookup("/a/bb/d");
+  BOOST_CHECK_EQUAL(npeABC->getPrefix(), "/a/b/c");
+  BOOST_CHECK_EQUAL(npeABD->getPrefix(), "/a/bb/d");
+  BOOST_CHECK_EQUAL(nt.size(), 6);
+
+  // each entry stores only its last component
+  BOOST_CHECK_EQUAL(nt.getNNameBytes(), 3 + 3 + 3 + 4 + 3);
+
+  // the name the entry was created from does not need to be alive
+  {
+    Name nameAE("/a/e");
+    nt.lookup(nameAE);
+  }
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/a/e")->getPrefix(), "/a/e");
+  BOOST_CHECK(nt.findExactMatch("/a/e/f") == nullptr);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/a/b/x")->getPrefix(), "/a/b");
+
+  nt.eraseEntryIfEmpty(npeABD);
+  BOOST_CHECK_EQUAL(nt.size(), 5);
+  BOOST_CHECK_EQUAL(nt.getNNameBytes(), 3 + 3 + 3 + 3);
+}
+
+BOOST_AUTO_TEST_CASE(InsertMatchesParentAndLastComponent)
+{
+  NameTree nt;
+
+  shared_ptr<name_tree::Entry> npeAC = nt.lookup("/a/c");
+  shared_ptr<name_tree::Entry> npeBC = nt.lookup("/b/c");
+  shared_ptr<name_tree::Entry> npeCA = nt.lookup("/c/a");
+  BOOST_CHECK_EQUAL(nt.size(), 6);
+
+  // the same last component under another parent is another entry
+  BOOST_CHECK_NE(npeAC, npeBC);
+  BOOST_CHECK_EQUAL(npeAC->getParent(), nt.findExactMatch("/a"));
+  BOOST_CHECK_EQUAL(npeBC->getParent(), nt.findExactMatch("/b"));
+  BOOST_CHECK_EQUAL(npeCA->getParent(), nt.findExactMatch("/c"));
+
+  // a repeated lookup, including of every proper prefix, finds the existing entries
+  BOOST_CHECK_EQUAL(nt.lookup("/a/c"), npeAC);
+  BOOST_CHECK_EQUAL(nt.lookup("/b/c"), npeBC);
+  BOOST_CHECK_EQUAL(nt.lookup("/c"), npeCA->getParent());
+  BOOST_CHECK_EQUAL(nt.size(), 6);
+
+  // an existing prefix gets a new child
+  shared_ptr<name_tree::Entry> npeACD = nt.lookup("/a/c/d");
+  BOOST_CHECK_EQUAL(npeACD->getParent(), npeAC);
+  BOOST_CHECK_EQUAL(npeACD->getPrefix(), "/a/c/d");
+  BOOST_CHECK_EQUAL(nt.size(), 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/table/subscription-table.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "NFD/daemon/fw/validation-stage.hpp"
+#include "NFD/tests/daemon/face/dummy-face.hpp"
+
+#include "model/cs/content-store-impl.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "utils/ndn-time.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::tests::DummyFace;
+
+/**
+ * @brief Runs the simulator, which drives the NFD scheduler and the clocks in ndnSIM
+ */
+class SubscriptionTableFixture : public CleanupFixture
+{
+public:
+  SubscriptionTableFixture()
+  {
+    ::ndn::time::setCustomClocks(make_shared<time::CustomSteadyClock>(),
+                                 make_shared<time::CustomSystemClock>());
+  }
+
+  void
+  advanceClocks(Time duration)
+  {
+    Simulator::Stop(duration);
+    Simulator::Run();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdTableSubscriptionTable, SubscriptionTableFixture)
+
+BOOST_AUTO_TEST_CASE(LeaseExpiry)
+{
+  nfd::NameTree nameTree;
+  nfd::SubscriptionTable table(nameTree);
+  table.setLease(::ndn::time::seconds(10));
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+
+  table.subscribeDownstream("/A", *face1);
+  advanceClocks(Seconds(5));
+  table.subscribeDownstream("/A", *face2);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+  BOOST_CHECK_EQUAL(table.getDownstreamFaces("/A").size(), 2);
+
+  // lease of face1 expired, face2 still subscribed
+  advanceClocks(Seconds(6));
+  std::vector<shared_ptr<nfd::Face>> faces = table.getDownstreamFaces("/A");
+  BOOST_REQUIRE_EQUAL(faces.size(), 1);
+  BOOST_CHECK(faces.front() == face2);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+
+  // renewing face2 prunes the expired record of face1
+  table.subscribeDownstream("/A", *face2);
+  BOOST_CHECK_EQUAL(table.findExactMatch("/A")->getDownstreams().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(EraseOnLastLease)
+{
+  nfd::NameTree nameTree;
+  nfd::SubscriptionTable table(nameTree);
+  table.setLease(::ndn::time::seconds(10));
+  auto face1 = make_shared<DummyFace>();
+  size_t nNameTreeEntriesBefore = nameTree.size();
+
+  table.subscribeDownstream("/A/B", *face1);
+  advanceClocks(Seconds(8));
+  table.subscribeUpstream("/A/B");
+  BOOST_CHECK(table.findExactMatch("/A/B")->isSubscribedUpstream());
+
+  // downstream lease expired, upstream lease keeps the entry
+  advanceClocks(Seconds(8));
+  BOOST_CHECK_EQUAL(table.size(), 1);
+  BOOST_CHECK_EQUAL(table.getDownstreamFaces("/A/B").size(), 0);
+
+  // last lease expired
+  advanceClocks(Seconds(3));
+  BOOST_CHECK_EQUAL(table.size(), 0);
+  BOOST_CHECK(table.findExactMatch("/A/B") == nullptr);
+  BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
+}
+
+BOOST_AUTO_TEST_CASE(UnsubscribeUpstream)
+{
+  nfd::NameTree nameTree;
+  nfd::SubscriptionTable table(nameTree);
+
+  table.subscribeUpstream("/A");
+  BOOST_CHECK(table.findExactMatch("/A")->isSubscribedUpstream());
+
+  table.unsubscribeUpstream("/A");
+  BOOST_REQUIRE(table.findExactMatch("/A") != nullptr);
+  BOOST_CHECK(!table.findExactMatch("/A")->isSubscribedUpstream());
+
+  // names without subscription do not create NameTree entries
+  size_t nNameTreeEntriesBefore = nameTree.size();
+  table.unsubscribeUpstream("/B/C");
+  BOOST_CHECK_EQUAL(table.getDownstreamFaces("/B/C").size(), 0);
+  BOOST_CHECK(table.findExactMatch("/B/C") == nullptr);
+  BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(AbsorbValidationInterest)
+{
+  nfd::Forwarder forwarder;
+  forwarder.addPipelineStage(make_shared<nfd::fw::ValidationStage>(std::ref(forwarder)));
+  forwarder.setCsFromNdnSim(CreateObject<cs::ContentStoreImpl<ndnSIM::lru_policy_traits>>());
+
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  auto face3 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.addFace(face3);
+  forwarder.getFib().insert("/A").first->addNextHop(face3, 0);
+
+  auto interest1 = make_shared<Interest>("/A/1");
+  interest1->setValidationFlag(1);
+  interest1->setNonce(1);
+  auto interest2 = make_shared<Interest>("/A/1");
+  interest2->setValidationFlag(1);
+  interest2->setNonce(2);
+
+  // the first validation Interest is forwarded and subscribes this forwarder upstream
+  face1->receiveInterest(*interest1);
+  BOOST_CHECK_EQUAL(face3->m_sentInterests.size(), 1);
+  shared_ptr<nfd::subscription::Entry> entry =
+    forwarder.getSubscriptionTable().findExactMatch("/A/1");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK(entry->isSubscribedUpstream());
+
+  // the second one is absorbed in the PIT entry
+  face2->receiveInterest(*interest2);
+  BOOST_CHECK_EQUAL(face3->m_sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(entry->getDownstreams().size(), 2);
+
+  std::pair<shared_ptr<nfd::pit::Entry>, bool> pitEntry = forwarder.getPit().insert(*interest2);
+  BOOST_REQUIRE(!pitEntry.second);
+  BOOST_CHECK_EQUAL(std::distance(pitEntry.first->getInRecords().begin(),
+                                  pitEntry.first->getInRecords().end()), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-aggregate.hpp"
+#include "NFD/core/scheduler.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ConsumerAggregateFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ConsumerAggregateFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100"));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"1", "2", "/black-hole", 1},
+      });
+  }
+
+  /**
+   * @brief Install ConsumerAggregate requesting @p prefix on node 1
+   *
+   * The consumer stops making requests at 5s, so all of them are resolved by 8s.
+   */
+  Ptr<ConsumerAggregate>
+  addConsumer(const std::string& prefix)
+  {
+    addApps({
+        {"1", "ns3::ndn::ConsumerAggregate",
+            {{"Prefix", prefix}, {"Users", "10"}, {"Frequency", "2"}, {"LifeTime", "1s"},
+             {"NumberOfContents", "50"}},
+            "0s", "100s"},
+      });
+
+    Ptr<Node> node = getNode("1");
+    Ptr<ConsumerAggregate> consumer =
+      DynamicCast<ConsumerAggregate>(node->GetApplication(node->GetNApplications() - 1));
+    nfd::scheduler::schedule(time::seconds(5), [consumer] {
+        consumer->SetAttribute("Frequency", DoubleValue(0));
+      });
+    return consumer;
+  }
+
+public:
+  static const uint32_t N_USERS = 10;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsConsumerAggregate, ConsumerAggregateFixture)
+
+BOOST_AUTO_TEST_CASE(Satisfied)
+{
+  Ptr<ConsumerAggregate> consumer = addConsumer("/prefix");
+  addApps({
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"},
+    });
+
+  Simulator::Stop(Seconds(8));
+  Simulator::Run();
+
+  uint32_t nSent = 0;
+  for (uint32_t user = 0; user < N_USERS; user++) {
+    BOOST_CHECK_EQUAL(consumer->GetSatisfiedInterests(user), consumer->GetSentInterests(user));
+    BOOST_CHECK_EQUAL(consumer->GetTimedOutInterests(user), 0);
+    if (consumer->GetSatisfiedInterests(user) > 0) {
+      BOOST_CHECK(consumer->GetTotalDelay(user).IsStrictlyPositive());
+    }
+    nSent += consumer->GetSentInterests(user);
+  }
+  // 10 users at 2 requests per second for 5 seconds
+  BOOST_CHECK_GT(nSent, 50);
+  BOOST_CHECK_LT(nSent, 200);
+  BOOST_CHECK_EQUAL(consumer->GetSentInterests(N_USERS), 0);
+}
+
+BOOST_AUTO_TEST_CASE(BlackHole)
+{
+  Ptr<ConsumerAggregate> consumer = addConsumer("/black-hole");
+
+  Simulator::Stop(Seconds(8));
+  Simulator::Run();
+
+  uint32_t nSent = 0;
+  for (uint32_t user = 0; user < N_USERS; user++) {
+    BOOST_CHECK_EQUAL(consumer->GetTimedOutInterests(user), consumer->GetSentInterests(user));
+    BOOST_CHECK_EQUAL(consumer->GetSatisfiedInterests(user), 0);
+    BOOST_CHECK_EQUAL(consumer->GetTotalDelay(user), Seconds(0));
+    nSent += consumer->GetSentInterests(user);
+  }
+  BOOST_CHECK_GT(nSent, 50);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
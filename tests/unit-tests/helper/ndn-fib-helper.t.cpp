@@ -18,9 +18,16 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "NFD/daemon/mgmt/fib-manager.hpp"
+#include "NFD/tests/daemon/face/dummy-face.hpp"
 
 #include "../tests-common.hpp"
 
+#include <boost/test/output_test_stream.hpp>
+
 namespace ns3 {
 namespace ndn {
 
@@ -97,8 +104,101 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  FibHelper::Batch batch;
+  batch.AddRoute(getNode("1"), Name("/prefix"), getFace("1", "2"), 10);
+  batch.AddRoute(getNode("1"), Name("/prefix"), getFace("1", "2"), 1);
+  batch.AddRoute(getNode("1"), Name("/other"), getFace("1", "2"), 1);
+  batch.RemoveRoute(getNode("1"), Name("/other"), getFace("1", "2"));
+  BOOST_CHECK_EQUAL(batch.GetSize(), 2);
+
+  batch.Commit();
+  BOOST_CHECK_EQUAL(batch.GetSize(), 0);
+
+  nfd::Fib& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  shared_ptr<nfd::fib::Entry> entry = fib.findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), 1);
+  BOOST_CHECK(fib.findExactMatch("/other") == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
+class TrustedCommandFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TrustedCommandFixture()
+  {
+    createTopology({
+        {"1", "2"}
+      });
+  }
+
+  nfd::Fib&
+  getFib()
+  {
+    return getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(TrustedCommand, TrustedCommandFixture)
+
+BOOST_AUTO_TEST_CASE(ExecuteVerbs)
+{
+  shared_ptr<nfd::FibManager> fibManager = getNode("1")->GetObject<L3Protocol>()->getFibManager();
+
+  ControlParameters parameters;
+  parameters.setName("/hello");
+  parameters.setFaceId(getFace("1", "2")->getId());
+  parameters.setCost(101);
+
+  // no command Interest is sent, so neither signature nor authorization is checked
+  nfd::ControlResponse response =
+    fibManager->executeTrustedCommand(Name::Component("add-nexthop"), parameters);
+  BOOST_CHECK_EQUAL(response.getCode(), 200);
+  shared_ptr<nfd::fib::Entry> entry = getFib().findExactMatch("/hello");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), 101);
+
+  response = fibManager->executeTrustedCommand(Name::Component("remove-nexthop"), parameters);
+  BOOST_CHECK_EQUAL(response.getCode(), 200);
+  BOOST_CHECK(getFib().findExactMatch("/hello") == nullptr);
+
+  response = fibManager->executeTrustedCommand(Name::Component("list"), parameters);
+  BOOST_CHECK_EQUAL(response.getCode(), 501);
+}
+
+BOOST_AUTO_TEST_CASE(UnknownFace)
+{
+  FibHelper::AddRoute(getNode("1"), Name("/known"), getFace("1", "2"), 1);
+  size_t nEntries = getFib().size();
+
+#ifdef NS3_LOG_ENABLE
+  boost::test_tools::output_test_stream output;
+  std::streambuf* clogBuf = std::clog.rdbuf(output.rdbuf());
+  LogComponentEnable("ndn.FibHelper", LOG_LEVEL_ERROR);
+#endif // NS3_LOG_ENABLE
+
+  // the Face was never added to the node, so the manager answers 410
+  FibHelper::AddRoute(getNode("1"), Name("/unknown"), make_shared<nfd::tests::DummyFace>(), 1);
+
+#ifdef NS3_LOG_ENABLE
+  LogComponentDisable("ndn.FibHelper", LOG_LEVEL_ERROR);
+  std::clog.rdbuf(clogBuf);
+  BOOST_CHECK(output.str().find("add-nexthop on node " + std::to_string(getNode("1")->GetId())
+                                + " failed: 410") != std::string::npos);
+#endif // NS3_LOG_ENABLE
+
+  BOOST_CHECK_EQUAL(getFib().size(), nEntries);
+  BOOST_CHECK(getFib().findExactMatch("/unknown") == nullptr);
+  BOOST_CHECK(getFib().findExactMatch("/known") != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TrustedCommand
+
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
 
 } // namespace ndn
@@ -18,6 +18,7 @@
  **/
 
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
@@ -146,6 +147,190 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+BOOST_AUTO_TEST_CASE(IncrementalRepairOnLinkFailure)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    100 1ms 100\n"
+        << "A3      C3  10Mbps    500  1ms 100\n"
+        << "B3      C3  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C3"));
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  auto getNextHops = [] (const std::string& nodeName) {
+    std::map<std::string, uint64_t> nextHops;
+    auto ndn = Names::Find<Node>(nodeName)->GetObject<ndn::L3Protocol>();
+    shared_ptr<nfd::fib::Entry> entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+    if (entry == nullptr)
+      return nextHops;
+
+    for (auto& nextHop : entry->getNextHops()) {
+      auto face = dynamic_pointer_cast<ndn::NetDeviceFace>(nextHop.getFace());
+      if (face == nullptr)
+        continue;
+      Ptr<Channel> channel = face->GetNetDevice()->GetChannel();
+      Ptr<Node> other = channel->GetDevice(0)->GetNode();
+      if (other == Names::Find<Node>(nodeName))
+        other = channel->GetDevice(1)->GetNode();
+      nextHops[Names::FindName(other)] = nextHop.getCost();
+    }
+    return nextHops;
+  };
+
+  BOOST_CHECK_EQUAL(getNextHops("A3").size(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("A3")["B3"], 101);
+
+  LinkControlHelper::FailLink(Names::Find<Node>("A3"), Names::Find<Node>("B3"));
+  BOOST_CHECK_EQUAL(getNextHops("A3").size(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("A3")["C3"], 500);
+  BOOST_CHECK_EQUAL(getNextHops("B3")["C3"], 1);
+
+  LinkControlHelper::FailLink(Names::Find<Node>("A3"), Names::Find<Node>("C3"));
+  BOOST_CHECK_EQUAL(getNextHops("A3").size(), 0);
+
+  LinkControlHelper::UpLink(Names::Find<Node>("A3"), Names::Find<Node>("B3"));
+  LinkControlHelper::UpLink(Names::Find<Node>("A3"), Names::Find<Node>("C3"));
+  BOOST_CHECK_EQUAL(getNextHops("A3").size(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("A3")["B3"], 101);
+}
+
+BOOST_AUTO_TEST_CASE(SeveralOriginsViaSameFace)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A5  NA  1 1 1\n"
+        << "B5  NA  80  -40 1\n"
+        << "C5  NA  80  40  1\n"
+        << "D5  NA  80  80  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A5      B5  10Mbps    1 1ms 100\n"
+        << "B5      C5  10Mbps    1 1ms 100\n"
+        << "C5      D5  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  // both origins are reached from A5 through the same face, with different costs
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C5"));
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("D5"));
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  auto getCosts = [] (const std::string& nodeName) {
+    std::vector<uint64_t> costs;
+    auto ndn = Names::Find<Node>(nodeName)->GetObject<ndn::L3Protocol>();
+    shared_ptr<nfd::fib::Entry> entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+    if (entry == nullptr)
+      return costs;
+
+    for (auto& nextHop : entry->getNextHops()) {
+      costs.push_back(nextHop.getCost());
+    }
+    return costs;
+  };
+
+  BOOST_REQUIRE_EQUAL(getCosts("A5").size(), 1);
+  BOOST_CHECK_EQUAL(getCosts("A5")[0], 2);
+
+  // the incremental repair must come to the same FIB as the full calculation
+  LinkControlHelper::FailLink(Names::Find<Node>("C5"), Names::Find<Node>("D5"));
+  BOOST_REQUIRE_EQUAL(getCosts("A5").size(), 1);
+  BOOST_CHECK_EQUAL(getCosts("A5")[0], 2);
+
+  LinkControlHelper::UpLink(Names::Find<Node>("C5"), Names::Find<Node>("D5"));
+  BOOST_REQUIRE_EQUAL(getCosts("A5").size(), 1);
+  BOOST_CHECK_EQUAL(getCosts("A5")[0], 2);
+}
+
+BOOST_AUTO_TEST_CASE(OneSidedIncidency)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A4  NA  1 1 1\n"
+        << "B4  NA  80  -40 1\n"
+        << "C4  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A4      B4  10Mbps    1 1ms 100\n"
+        << "A4      C4  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Ptr<Node> nodeA = Names::Find<Node>("A4");
+  Ptr<Node> nodeB = Names::Find<Node>("B4");
+  Ptr<GlobalRouter> grA = nodeA->GetObject<GlobalRouter>();
+  Ptr<GlobalRouter> grB = nodeB->GetObject<GlobalRouter>();
+
+  auto getFace = [] (Ptr<GlobalRouter> gr, Ptr<GlobalRouter> other) {
+    for (const auto& incidency : gr->GetIncidencies()) {
+      if (std::get<2>(incidency) == other)
+        return std::get<1>(incidency);
+    }
+    return shared_ptr<Face>();
+  };
+  shared_ptr<Face> faceA = getFace(grA, grB);
+  shared_ptr<Face> faceB = getFace(grB, grA);
+  BOOST_REQUIRE(faceA != nullptr && faceB != nullptr);
+
+  // the edge is already excluded on one side only: the other side must stay unchanged
+  grB->DisableIncidency(faceB);
+  GlobalRoutingHelper::UpdateRoutesOnLinkDown(nodeA, faceA, nodeB, faceB);
+  BOOST_CHECK(grA->HasIncidency(faceA));
+  BOOST_CHECK(grB->HasDisabledIncidency(faceB));
+
+  GlobalRoutingHelper::UpdateRoutesOnLinkUp(nodeA, faceA, nodeB, faceB);
+  BOOST_CHECK(grA->HasIncidency(faceA));
+  BOOST_CHECK(grB->HasDisabledIncidency(faceB));
+
+  grB->EnableIncidency(faceB);
+  GlobalRoutingHelper::UpdateRoutesOnLinkDown(nodeA, faceA, nodeB, faceB);
+  BOOST_CHECK(grA->HasDisabledIncidency(faceA));
+  BOOST_CHECK(grB->HasDisabledIncidency(faceB));
+  BOOST_CHECK_EQUAL(grA->GetIncidencies().size(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "helper/ndn-snapshot-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "model/cs/ndn-content-store.hpp"
+
+#include "ns3/node-container.h"
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/interest.hpp>
+
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnSnapshotHelper, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Encoding)
+{
+  std::vector<int64_t> values = {0, 1, -1, 63, -64, 64, 1000000, -1000000,
+                                 std::numeric_limits<int64_t>::max(),
+                                 std::numeric_limits<int64_t>::min()};
+
+  std::stringstream ss;
+  for (int64_t value : values) {
+    SnapshotHelper::WriteNumber(ss, value);
+  }
+  SnapshotHelper::WriteString(ss, std::string("/a\0b", 4));
+
+  for (int64_t value : values) {
+    BOOST_CHECK_EQUAL(SnapshotHelper::ReadNumber(ss), value);
+  }
+  BOOST_CHECK_EQUAL(SnapshotHelper::ReadString(ss), std::string("/a\0b", 4));
+  BOOST_CHECK_THROW(SnapshotHelper::ReadNumber(ss), std::runtime_error);
+
+  std::stringstream truncated;
+  SnapshotHelper::WriteNumber(truncated, 10);
+  truncated << "abc";
+  BOOST_CHECK_THROW(SnapshotHelper::ReadString(truncated), std::runtime_error);
+
+  // one byte for small numbers of either sign
+  std::stringstream small;
+  SnapshotHelper::WriteNumber(small, -64);
+  BOOST_CHECK_EQUAL(small.str().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ContentStore)
+{
+  NodeContainer nodes;
+  nodes.Create(1);
+
+  StackHelper ndnHelper;
+  ndnHelper.SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", "100");
+  ndnHelper.Install(nodes);
+
+  Ptr<ContentStore> cs = nodes.Get(0)->GetObject<ContentStore>();
+  BOOST_REQUIRE(cs != nullptr);
+
+  auto makeData = [] (const Name& name) {
+    auto data = make_shared<Data>(name);
+    StackHelper::getKeyChain().sign(*data);
+    return data;
+  };
+  cs->Add(makeData("/a"));
+  cs->Add(makeData("/b"));
+  cs->Invalidate("/b");
+
+  std::string file = "ndn-snapshot-helper-test.bin";
+  SnapshotHelper::SaveNow(file);
+
+  cs->InvalidatePrefix("/");
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/a")) == nullptr);
+
+  SnapshotHelper::Restore(file);
+  std::remove(file.c_str());
+
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/a")) != nullptr);
+  // invalidated entries are not saved
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/b")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ContentStoreLruOrder)
+{
+  NodeContainer nodes;
+  nodes.Create(1);
+
+  StackHelper ndnHelper;
+  ndnHelper.SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", "3");
+  ndnHelper.Install(nodes);
+
+  Ptr<ContentStore> cs = nodes.Get(0)->GetObject<ContentStore>();
+  BOOST_REQUIRE(cs != nullptr);
+
+  auto makeData = [] (const Name& name) {
+    auto data = make_shared<Data>(name);
+    StackHelper::getKeyChain().sign(*data);
+    return data;
+  };
+  cs->Add(makeData("/a"));
+  cs->Add(makeData("/b"));
+  cs->Add(makeData("/c"));
+  cs->Lookup(make_shared<Interest>("/a")); // /b is now the least recently used
+
+  std::string file = "ndn-snapshot-helper-test.bin";
+  SnapshotHelper::SaveNow(file);
+  cs->InvalidatePrefix("/");
+  SnapshotHelper::Restore(file);
+  std::remove(file.c_str());
+
+  cs->Add(makeData("/d"));
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/b")) == nullptr);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/a")) != nullptr);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/c")) != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
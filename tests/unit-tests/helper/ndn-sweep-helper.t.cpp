@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "helper/ndn-sweep-helper.hpp"
+
+#include "../tests-common.hpp"
+
+#include <stdexcept>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnSweepHelper, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Points)
+{
+  SweepHelper sweep;
+  BOOST_CHECK_EQUAL(sweep.getPoints().size(), 0);
+
+  sweep.addParameter("zipf", {"0.8", "1.2"});
+  sweep.addParameter("cache_size", {"1", "10", "100"});
+  sweep.addPoint({{"zipf", "2.0"}});
+
+  std::vector<SweepHelper::Point> points = sweep.getPoints();
+  BOOST_REQUIRE_EQUAL(points.size(), 7);
+  BOOST_CHECK_EQUAL(SweepHelper::getSuffix(points[0]), "cache_size-1_zipf-0.8");
+  BOOST_CHECK_EQUAL(SweepHelper::getSuffix(points[1]), "cache_size-10_zipf-0.8");
+  BOOST_CHECK_EQUAL(SweepHelper::getSuffix(points[5]), "cache_size-100_zipf-1.2");
+  BOOST_CHECK_EQUAL(SweepHelper::getSuffix(points[6]), "zipf-2.0");
+
+  BOOST_CHECK_EQUAL(SweepHelper::getSuffix({{"strategy", "/localhost/nfd/strategy/ncc"}}),
+                    "strategy--localhost-nfd-strategy-ncc");
+}
+
+BOOST_AUTO_TEST_CASE(MaxWorkers)
+{
+  SweepHelper sweep;
+  BOOST_CHECK_GE(sweep.getMaxWorkers(), 1);
+
+  sweep.setMaxWorkers(0);
+  BOOST_CHECK_EQUAL(sweep.getMaxWorkers(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(FailedWorkers)
+{
+  SweepHelper sweep;
+  sweep.setMaxWorkers(2);
+  sweep.addParameter("mode", {"return", "exception", "other"});
+
+  size_t nFailed = sweep.run([] (const SweepHelper::Point& point, const std::string& suffix) {
+      if (point.at("mode") == "exception")
+        throw std::runtime_error("worker failed");
+      if (point.at("mode") == "other")
+        throw 1;
+    });
+  BOOST_CHECK_EQUAL(nFailed, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
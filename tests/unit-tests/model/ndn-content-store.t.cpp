@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/content-store-impl.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "utils/ndn-virtual-payload-tag.hpp"
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/data.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ContentStoreFixture : public CleanupFixture
+{
+public:
+  ContentStoreFixture()
+    : cs(CreateObject<cs::ContentStoreImpl<ndnSIM::lru_policy_traits>>())
+  {
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name, uint8_t version)
+  {
+    auto data = make_shared<Data>(name);
+    data->setContent(&version, sizeof(version));
+    StackHelper::getKeyChain().sign(*data);
+    return data;
+  }
+
+  shared_ptr<Data>
+  lookup(const Name& name)
+  {
+    return cs->Lookup(make_shared<Interest>(name));
+  }
+
+public:
+  Ptr<ContentStore> cs;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelContentStore, ContentStoreFixture)
+
+BOOST_AUTO_TEST_CASE(Invalidate)
+{
+  cs->Add(makeData("/a/1", 1));
+  cs->Add(makeData("/a/2", 1));
+
+  cs->Invalidate("/a/1");
+  BOOST_CHECK(lookup("/a/1") == nullptr);
+  BOOST_CHECK(lookup("/a/2") != nullptr);
+  BOOST_CHECK_EQUAL(cs->GetSize(), 1); // evicted by the lookup
+
+  // newer version replaces the invalidated one without explicit Erase
+  cs->Add(makeData("/a/2", 1));
+  cs->Invalidate("/a/2");
+  BOOST_CHECK(cs->Add(makeData("/a/2", 2)));
+  shared_ptr<Data> found = lookup("/a/2");
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getContent().value()[0], 2);
+  BOOST_CHECK_EQUAL(cs->GetSize(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidatePrefix)
+{
+  cs->Add(makeData("/a/1", 1));
+  cs->Add(makeData("/a/2", 1));
+  cs->Add(makeData("/b/1", 1));
+
+  cs->InvalidatePrefix("/a");
+  cs->Add(makeData("/a/3", 1)); // added after the invalidation
+
+  BOOST_CHECK(lookup("/a/1") == nullptr);
+  BOOST_CHECK(lookup("/a/2") == nullptr);
+  BOOST_CHECK(lookup("/a/3") != nullptr);
+  BOOST_CHECK(lookup("/b/1") != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidateNotCached)
+{
+  // invalidating names that are not cached leaves nothing behind
+  cs->Invalidate("/a/1");
+  cs->InvalidatePrefix("/b");
+
+  cs->Add(makeData("/a/1", 1));
+  cs->Add(makeData("/b/1", 1));
+  BOOST_CHECK(lookup("/a/1") != nullptr);
+  BOOST_CHECK(lookup("/b/1") != nullptr);
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(VirtualPayloadBytes)
+{
+  auto data = makeData("/a/1", 1);
+  size_t wireSize = data->wireEncode().size();
+  data->setTag(make_shared<VirtualPayloadTag>(1024));
+
+  cs->Add(data);
+  BOOST_CHECK_EQUAL(cs->GetBytes(), wireSize + 1024);
+
+  cs->Add(makeData("/a/2", 1));
+  BOOST_CHECK_EQUAL(cs->GetBytes(), 2 * wireSize + 1024);
+
+  cs->Invalidate("/a/1");
+  BOOST_CHECK(lookup("/a/1") == nullptr);
+  BOOST_CHECK_EQUAL(cs->GetBytes(), wireSize);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
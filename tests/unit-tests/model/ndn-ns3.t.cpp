@@ -21,6 +21,7 @@
 #include "helper/ndn-stack-helper.hpp"
 #include "model/ndn-header.hpp"
 #include "utils/ndn-ns3-packet-tag.hpp"
+#include "utils/ndn-virtual-payload-tag.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
@@ -54,6 +55,33 @@ BOOST_AUTO_TEST_CASE(ToPacket)
   BOOST_CHECK_EQUAL(type2, ::ndn::tlv::Data);
 }
 
+BOOST_AUTO_TEST_CASE(VirtualPayload)
+{
+  auto data = std::make_shared<ndn::Data>("/prefix");
+  ndn::StackHelper::getKeyChain().sign(*data);
+  size_t wireSize = data->wireEncode().size();
+
+  data->setTag(std::make_shared<VirtualPayloadTag>(1024));
+  Ptr<Packet> packet = Convert::ToPacket(*data);
+  BOOST_CHECK_EQUAL(packet->GetSize(), wireSize + 1024);
+
+  auto receivedData = Convert::FromPacket<ndn::Data>(packet);
+  BOOST_CHECK_EQUAL(receivedData->getContent().value_size(), 0);
+  auto payloadTag = receivedData->getTag<VirtualPayloadTag>();
+  BOOST_REQUIRE(payloadTag != nullptr);
+  BOOST_CHECK_EQUAL(payloadTag->getSize(), 1024);
+
+  // Data without ns-3 packet (e.g., from the content store) gets the payload back
+  auto cachedData = std::make_shared<ndn::Data>(*receivedData);
+  cachedData->removeTag<Ns3PacketTag>();
+  BOOST_CHECK_EQUAL(Convert::ToPacket(*cachedData)->GetSize(), wireSize + 1024);
+
+  auto plainData = std::make_shared<ndn::Data>("/prefix");
+  ndn::StackHelper::getKeyChain().sign(*plainData);
+  auto receivedPlainData = Convert::FromPacket<ndn::Data>(Convert::ToPacket(*plainData));
+  BOOST_CHECK(receivedPlainData->getTag<VirtualPayloadTag>() == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/tag-host.hpp>
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/data.hpp>
+
+#include <boost/mpl/vector.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Tag;
+using ::ndn::TagHost;
+
+class TestTag : public Tag
+{
+public:
+  static constexpr size_t
+  getTypeId()
+  {
+    return 1;
+  }
+};
+
+class TestInlineTag : public Tag
+{
+public:
+  static constexpr size_t
+  getTypeId()
+  {
+    return 3;
+  }
+
+  explicit
+  TestInlineTag(int value)
+    : value(value)
+  {
+  }
+
+public:
+  int value;
+};
+
+typedef boost::mpl::vector<TagHost, Interest, Data> Fixtures;
+
+BOOST_AUTO_TEST_SUITE(NdnCxxTagHost)
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(Inline, T, Fixtures, T)
+{
+  this->setInlineTag(TestInlineTag(1));
+  this->setTag(make_shared<TestTag>());
+
+  BOOST_REQUIRE(this->template getTag<TestInlineTag>() != nullptr);
+  BOOST_CHECK_EQUAL(this->template getTag<TestInlineTag>()->value, 1);
+
+  // copy has its own tag stored by value
+  T copy(*this);
+  this->setInlineTag(TestInlineTag(2));
+  BOOST_CHECK_EQUAL(this->template getTag<TestInlineTag>()->value, 2);
+  BOOST_REQUIRE(copy.template getTag<TestInlineTag>() != nullptr);
+  BOOST_CHECK_EQUAL(copy.template getTag<TestInlineTag>()->value, 1);
+  BOOST_CHECK(copy.template getTag<TestTag>() == this->template getTag<TestTag>());
+
+  copy.template removeTag<TestInlineTag>();
+  BOOST_CHECK(copy.template getTag<TestInlineTag>() == nullptr);
+  BOOST_CHECK_EQUAL(this->template getTag<TestInlineTag>()->value, 2);
+
+  // replaced by a tag stored on the heap
+  this->setTag(make_shared<TestInlineTag>(3));
+  BOOST_CHECK_EQUAL(this->template getTag<TestInlineTag>()->value, 3);
+
+  copy = *this;
+  BOOST_CHECK(copy.template getTag<TestInlineTag>() == this->template getTag<TestInlineTag>());
+}
+
+BOOST_AUTO_TEST_CASE(InlineTagOwnership)
+{
+  shared_ptr<TestInlineTag> tag;
+  {
+    TagHost host;
+    host.setInlineTag(TestInlineTag(7));
+
+    // findTag reads the tag stored by value, without a copy
+    const TestInlineTag* found = host.findTag<TestInlineTag>();
+    BOOST_REQUIRE(found != nullptr);
+    BOOST_CHECK_EQUAL(found->value, 7);
+    BOOST_CHECK(host.findTag<TestInlineTag>() == found);
+    BOOST_CHECK(host.findTag<TestTag>() == nullptr);
+
+    // getTag returns an owning copy, which outlives the tag host
+    tag = host.getTag<TestInlineTag>();
+    BOOST_REQUIRE(tag != nullptr);
+    BOOST_CHECK(tag.get() != found);
+
+    host.setInlineTag(TestInlineTag(8));
+    BOOST_CHECK_EQUAL(tag->value, 7);
+  }
+  BOOST_CHECK_EQUAL(tag->value, 7);
+  BOOST_CHECK_EQUAL(tag.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(FindHeapTag)
+{
+  TagHost host;
+  auto tag = make_shared<TestTag>();
+  host.setTag(tag);
+  BOOST_CHECK(host.findTag<TestTag>() == tag.get());
+  BOOST_CHECK(host.getTag<TestTag>() == tag);
+
+  host.removeTag<TestTag>();
+  BOOST_CHECK(host.findTag<TestTag>() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
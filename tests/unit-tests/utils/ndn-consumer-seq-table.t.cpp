@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-consumer-seq-table.hpp"
+
+#include "../tests-common.hpp"
+
+#include <map>
+#include <random>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsConsumerSeqTable)
+
+BOOST_AUTO_TEST_CASE(SentAndErase)
+{
+  ConsumerSeqTable table;
+  for (uint32_t seq = 0; seq < 100; seq++) {
+    table.sent(seq, MilliSeconds(seq));
+  }
+  table.sent(10, MilliSeconds(200));
+  BOOST_CHECK_EQUAL(table.size(), 100);
+
+  const ConsumerSeqTable::Entry* entry = table.find(10);
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->firstSent, MilliSeconds(10));
+  BOOST_CHECK_EQUAL(entry->lastSent, MilliSeconds(200));
+  BOOST_CHECK_EQUAL(entry->retxCount, 2);
+
+  for (uint32_t seq = 0; seq < 100; seq += 2) {
+    table.erase(seq);
+  }
+  BOOST_CHECK_EQUAL(table.size(), 50);
+  BOOST_CHECK(table.find(10) == nullptr);
+  BOOST_CHECK(table.find(11) != nullptr);
+  BOOST_CHECK(table.find(1000) == nullptr);
+
+  // sequence numbers below the window
+  table.sent(5000, Seconds(1));
+  table.sent(1, Seconds(1));
+  for (uint32_t seq = 1; seq < 100; seq += 2) {
+    table.erase(seq);
+  }
+  BOOST_CHECK_EQUAL(table.size(), 1);
+  BOOST_CHECK(table.find(5000) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ExpiryAndRetx)
+{
+  ConsumerSeqTable table;
+  table.sent(1, MilliSeconds(10));
+  table.sent(2, MilliSeconds(20));
+  table.sent(3, MilliSeconds(30));
+
+  Time earliest;
+  BOOST_REQUIRE(table.getEarliestSent(earliest));
+  BOOST_CHECK_EQUAL(earliest, MilliSeconds(10));
+
+  // satisfied and re-sent Interests do not expire
+  table.erase(1);
+  table.sent(2, MilliSeconds(40));
+  BOOST_REQUIRE(table.getEarliestSent(earliest));
+  BOOST_CHECK_EQUAL(earliest, MilliSeconds(30));
+
+  uint32_t seq = 0;
+  BOOST_CHECK(!table.popExpired(MilliSeconds(29), seq));
+  BOOST_REQUIRE(table.popExpired(MilliSeconds(40), seq));
+  BOOST_CHECK_EQUAL(seq, 3);
+  BOOST_REQUIRE(table.popExpired(MilliSeconds(40), seq));
+  BOOST_CHECK_EQUAL(seq, 2);
+  BOOST_CHECK(!table.popExpired(MilliSeconds(40), seq));
+  BOOST_CHECK(!table.getEarliestSent(earliest));
+
+  table.scheduleRetx(3);
+  table.scheduleRetx(2);
+  table.scheduleRetx(3);
+  table.erase(2);
+
+  BOOST_REQUIRE(table.popRetx(seq));
+  BOOST_CHECK_EQUAL(seq, 3);
+  BOOST_CHECK(!table.popRetx(seq));
+  BOOST_CHECK_EQUAL(table.find(3)->state, ConsumerSeqTable::TIMED_OUT);
+}
+
+BOOST_AUTO_TEST_CASE(RandomSeqs)
+{
+  // e.g., ConsumerZipfMandelbrot requests random ranks
+  ConsumerSeqTable table;
+  std::map<uint32_t, Time> expected;
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<uint32_t> rank(1, 100000);
+
+  for (int i = 0; i < 20000; i++) {
+    uint32_t seq = rank(rng);
+    if (expected.size() < 50 || rng() % 2 == 0) {
+      table.sent(seq, MilliSeconds(i));
+      expected.emplace(seq, MilliSeconds(i));
+    }
+    else {
+      auto it = expected.begin();
+      std::advance(it, rng() % expected.size());
+      table.erase(it->first);
+      expected.erase(it);
+    }
+
+    BOOST_REQUIRE_EQUAL(table.size(), expected.size());
+    BOOST_REQUIRE_LE(table.getCapacity(), 1024);
+  }
+
+  for (uint32_t seq = 1; seq <= 100000; seq++) {
+    auto it = expected.find(seq);
+    const ConsumerSeqTable::Entry* entry = table.find(seq);
+    BOOST_REQUIRE_EQUAL(entry != nullptr, it != expected.end());
+    if (entry != nullptr) {
+      BOOST_CHECK_EQUAL(entry->firstSent, it->second);
+    }
+  }
+
+  // the ring buffer shrinks back once the window is narrow again
+  while (!expected.empty()) {
+    table.erase(expected.begin()->first);
+    expected.erase(expected.begin());
+  }
+  for (uint32_t seq = 100; seq < 110; seq++) {
+    table.sent(seq, Seconds(1));
+  }
+  BOOST_CHECK_EQUAL(table.size(), 10);
+  BOOST_CHECK_LE(table.getCapacity(), 16);
+}
+
+BOOST_AUTO_TEST_CASE(ShrinkingWindow)
+{
+  ConsumerSeqTable table;
+  for (uint32_t seq = 0; seq < 1000; seq++) {
+    table.sent(seq, MilliSeconds(seq));
+  }
+  BOOST_CHECK_EQUAL(table.getCapacity(), 1024);
+
+  for (uint32_t seq = 0; seq < 995; seq++) {
+    table.erase(seq);
+  }
+  BOOST_CHECK_EQUAL(table.size(), 5);
+  BOOST_CHECK_LE(table.getCapacity(), 32);
+  BOOST_CHECK(table.find(999) != nullptr);
+  BOOST_CHECK(table.find(994) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(WrappingWindow)
+{
+  // sequence numbers of a long running consumer wrap past 0xFFFFFFFF
+  const uint32_t first = 0xFFFFFFFF - 5000;
+  ConsumerSeqTable table;
+  for (uint32_t i = 0; i < 1000; i++) {
+    table.sent(first + i * 10, MilliSeconds(i));
+  }
+  BOOST_CHECK_EQUAL(table.size(), 1000);
+  BOOST_CHECK_EQUAL(table.getCapacity(), 0);
+
+  // the sparse window becomes dense again while it still wraps
+  for (uint32_t i = 0; i < 495; i++) {
+    table.erase(first + i * 10);
+  }
+  for (uint32_t i = 999; i > 506; i--) {
+    table.erase(first + i * 10);
+  }
+  BOOST_CHECK_EQUAL(table.size(), 12);
+  BOOST_CHECK_GT(table.getCapacity(), 0);
+  BOOST_CHECK_LE(table.getCapacity(), 128);
+
+  for (uint32_t i = 495; i <= 506; i++) {
+    BOOST_REQUIRE(table.find(first + i * 10) != nullptr);
+    BOOST_CHECK_EQUAL(table.find(first + i * 10)->firstSent, MilliSeconds(i));
+    BOOST_CHECK(table.find(first + i * 10 + 1) == nullptr);
+  }
+  BOOST_CHECK(table.find(first + 494 * 10) == nullptr);
+  BOOST_CHECK(table.find(first + 507 * 10) == nullptr);
+
+  // the highest and the lowest sequence numbers are neighbours
+  table.clear();
+  table.sent(0, Seconds(1));
+  table.sent(1000, Seconds(1));
+  table.sent(0xFFFFFFFF, Seconds(1));
+  BOOST_CHECK_EQUAL(table.getCapacity(), 0);
+
+  table.erase(1000);
+  BOOST_CHECK_EQUAL(table.size(), 2);
+  BOOST_CHECK_EQUAL(table.getCapacity(), 8);
+  BOOST_CHECK(table.find(0xFFFFFFFF) != nullptr);
+  BOOST_CHECK(table.find(0) != nullptr);
+  BOOST_CHECK(table.find(1000) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-publication-tree.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsPublicationTree)
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  PublicationTree tree;
+  tree.addPath("1 3 4 ");
+  tree.addPath("2 4 ");
+  tree.addPath("1 3 4 ");
+  tree.addPath("7 6 5 ");
+
+  BOOST_CHECK_EQUAL(tree.encode(), "(4(3(1) 2) 5(6(7)))");
+  BOOST_CHECK_EQUAL(tree.size(), 7);
+
+  BOOST_CHECK(PublicationTree::isEncoded(tree.encode()));
+  BOOST_CHECK(!PublicationTree::isEncoded("1 3 4 "));
+  BOOST_CHECK(!PublicationTree::isEncoded(""));
+}
+
+BOOST_AUTO_TEST_CASE(Decode)
+{
+  std::vector<PublicationTree::Branch> branches = PublicationTree::decode("(4(3(1) 2) 5(6(7)))");
+  BOOST_REQUIRE_EQUAL(branches.size(), 2);
+  BOOST_CHECK_EQUAL(branches[0].first, 4);
+  BOOST_CHECK_EQUAL(branches[0].second, "(3(1) 2)");
+  BOOST_CHECK_EQUAL(branches[1].first, 5);
+  BOOST_CHECK_EQUAL(branches[1].second, "(6(7))");
+
+  branches = PublicationTree::decode(branches[0].second);
+  BOOST_REQUIRE_EQUAL(branches.size(), 2);
+  BOOST_CHECK_EQUAL(branches[0].first, 3);
+  BOOST_CHECK_EQUAL(branches[0].second, "(1)");
+  BOOST_CHECK_EQUAL(branches[1].first, 2);
+  BOOST_CHECK_EQUAL(branches[1].second, "");
+
+  BOOST_CHECK_EQUAL(PublicationTree::decode("()").size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
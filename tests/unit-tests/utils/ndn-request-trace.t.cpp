@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-request-trace.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <sstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_REQUEST_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "requests.trace";
+
+class RequestTraceFixture : public CleanupFixture
+{
+public:
+  RequestTraceFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~RequestTraceFixture()
+  {
+    boost::filesystem::remove(TEST_REQUEST_TRACE);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsRequestTrace, RequestTraceFixture)
+
+BOOST_AUTO_TEST_CASE(ConvertNames)
+{
+  std::stringstream csv;
+  csv << "time,name,user\n"
+      << "# comment\n";
+  for (int i = 0; i < 1000; i++) {
+    csv << i * 0.001 << ",/prefix/" << (i % 7) << "," << i << "\r\n";
+  }
+  BOOST_CHECK_EQUAL(ConvertCsvToRequestTrace(csv, TEST_REQUEST_TRACE.string()), 1000);
+
+  // small window to remap the records several times
+  RequestTraceReader reader(TEST_REQUEST_TRACE.string(), 4096);
+  BOOST_CHECK(reader.hasNames());
+  BOOST_CHECK_EQUAL(reader.getHeader().nNames, 7);
+
+  RequestTrace::Record record;
+  uint32_t nRecords = 0;
+  while (reader.next(record)) {
+    BOOST_CHECK_EQUAL(record.user, nRecords);
+    BOOST_CHECK_EQUAL(NanoSeconds(record.time), Seconds(nRecords * 0.001));
+    BOOST_CHECK_EQUAL(reader.getName(record.nameId),
+                      Name("/prefix").append(std::to_string(nRecords % 7)));
+    nRecords++;
+  }
+  BOOST_CHECK_EQUAL(nRecords, 1000);
+
+  reader.rewind();
+  BOOST_REQUIRE(reader.next(record));
+  BOOST_CHECK_EQUAL(record.user, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ConvertSequenceNumbers)
+{
+  std::stringstream csv;
+  csv << "1.5,5\n"
+      << "2,6,3\n";
+  BOOST_CHECK_EQUAL(ConvertCsvToRequestTrace(csv, TEST_REQUEST_TRACE.string()), 2);
+
+  RequestTraceReader reader(TEST_REQUEST_TRACE.string(), 4096);
+  BOOST_CHECK(!reader.hasNames());
+
+  RequestTrace::Record record;
+  BOOST_REQUIRE(reader.next(record));
+  BOOST_CHECK_EQUAL(NanoSeconds(record.time), MilliSeconds(1500));
+  BOOST_CHECK_EQUAL(record.nameId, 5);
+  BOOST_CHECK_EQUAL(record.user, 0);
+
+  BOOST_REQUIRE(reader.next(record));
+  BOOST_CHECK_EQUAL(record.nameId, 6);
+  BOOST_CHECK_EQUAL(record.user, 3);
+
+  BOOST_CHECK(!reader.next(record));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
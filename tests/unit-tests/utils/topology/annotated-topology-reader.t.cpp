@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include "ns3/mobility-model.h"
+
+#include "../../tests-common.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TOPO = boost::filesystem::path(TEST_CONFIG_PATH) / "topo.txt";
+const boost::filesystem::path TEST_OTHER_TOPO =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "other-topo.txt";
+const boost::filesystem::path TEST_CACHE = boost::filesystem::path(TEST_CONFIG_PATH) / "topo.bin";
+
+class TopologyCacheFixture : public CleanupFixture
+{
+public:
+  TopologyCacheFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~TopologyCacheFixture()
+  {
+    boost::filesystem::remove(TEST_TOPO);
+    boost::filesystem::remove(TEST_OTHER_TOPO);
+    boost::filesystem::remove(TEST_CACHE);
+  }
+
+  /**
+   * @brief Writes a topology whose size does not depend on the node name prefix
+   */
+  static void
+  writeTopology(const boost::filesystem::path& file, const std::string& prefix)
+  {
+    std::ofstream os(file.string().c_str());
+    os << "router\n"
+       << prefix << "1 NA 40.5 -70.25 0\n"
+       << prefix << "2 NA 41 -71 0\n"
+       << prefix << "3 NA 42 -72 0\n"
+       << "link\n"
+       << prefix << "1 " << prefix << "2 10Mbps 1 10ms 20\n"
+       << prefix << "2 " << prefix << "3 1Mbps 5 1ms 10 0.1\n"
+       << prefix << "3 " << prefix << "1 100Mbps\n";
+  }
+
+  /**
+   * @brief Reads the topology, and describes the nodes and links that were created
+   */
+  static std::vector<std::string>
+  read(const boost::filesystem::path& file)
+  {
+    // nodes of an earlier read keep their names otherwise
+    Names::Clear();
+
+    AnnotatedTopologyReader reader("", 1.0);
+    reader.SetFileName(file.string());
+    reader.SetCacheFile(TEST_CACHE.string());
+    NodeContainer nodes = reader.Read();
+
+    std::vector<std::string> description;
+    for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+      Vector position = nodes.Get(i)->GetObject<MobilityModel>()->GetPosition();
+      std::ostringstream os;
+      os << Names::FindName(nodes.Get(i)) << " " << position.x << " " << position.y;
+      description.push_back(os.str());
+    }
+    for (const auto& link : reader.GetLinks()) {
+      std::ostringstream os;
+      os << link.GetFromNodeName() << "-" << link.GetToNodeName();
+      for (auto attribute = link.AttributesBegin(); attribute != link.AttributesEnd();
+           ++attribute) {
+        os << " " << attribute->first << "=" << attribute->second;
+      }
+      description.push_back(os.str());
+    }
+    return description;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyAnnotatedTopologyReader, TopologyCacheFixture)
+
+BOOST_AUTO_TEST_CASE(CacheRoundTrip)
+{
+  writeTopology(TEST_TOPO, "A");
+  std::vector<std::string> parsed = read(TEST_TOPO);
+  BOOST_REQUIRE_EQUAL(parsed.size(), 6);
+  BOOST_CHECK(boost::filesystem::exists(TEST_CACHE));
+
+  // same path, size and modification time, so the records must come from the cache
+  std::time_t time = boost::filesystem::last_write_time(TEST_TOPO);
+  writeTopology(TEST_TOPO, "B");
+  boost::filesystem::last_write_time(TEST_TOPO, time);
+
+  std::vector<std::string> cached = read(TEST_TOPO);
+  BOOST_CHECK_EQUAL_COLLECTIONS(cached.begin(), cached.end(), parsed.begin(), parsed.end());
+}
+
+BOOST_AUTO_TEST_CASE(CacheOfOtherSource)
+{
+  writeTopology(TEST_TOPO, "A");
+  read(TEST_TOPO);
+
+  // another file with the same size and modification time does not use the cache
+  writeTopology(TEST_OTHER_TOPO, "B");
+  std::time_t time = boost::filesystem::last_write_time(TEST_TOPO);
+  boost::filesystem::last_write_time(TEST_OTHER_TOPO, time);
+
+  std::vector<std::string> other = read(TEST_OTHER_TOPO);
+  BOOST_REQUIRE_EQUAL(other.size(), 6);
+  BOOST_CHECK_EQUAL(other[0].substr(0, 3), "B1 ");
+  BOOST_CHECK_EQUAL(other[3].substr(0, 6), "B1-B2 ");
+}
+
+BOOST_AUTO_TEST_CASE(DamagedCache)
+{
+  writeTopology(TEST_TOPO, "A");
+  std::vector<std::string> parsed = read(TEST_TOPO);
+
+  // the file is parsed again when the cache is truncated
+  boost::filesystem::resize_file(TEST_CACHE, boost::filesystem::file_size(TEST_CACHE) - 4);
+  std::vector<std::string> reparsed = read(TEST_TOPO);
+  BOOST_CHECK_EQUAL_COLLECTIONS(reparsed.begin(), reparsed.end(), parsed.begin(), parsed.end());
+
+  // ... or when a link refers to a node that does not exist; the cache was written again above,
+  // and ends with the last link record: two node indices and five attribute strings
+  {
+    std::fstream cache(TEST_CACHE.string().c_str(),
+                       std::ios::in | std::ios::out | std::ios::binary);
+    cache.seekp(-static_cast<std::streamoff>(7 * sizeof(uint32_t)), std::ios::end);
+    uint32_t badNode = 1000;
+    cache.write(reinterpret_cast<const char*>(&badNode), sizeof(badNode));
+  }
+  reparsed = read(TEST_TOPO);
+  BOOST_CHECK_EQUAL_COLLECTIONS(reparsed.begin(), reparsed.end(), parsed.begin(), parsed.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
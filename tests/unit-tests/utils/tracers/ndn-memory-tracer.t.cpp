@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-memory-tracer.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class MemoryTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  MemoryTracerFixture()
+  {
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+  }
+
+  /**
+   * @brief Returns the fields of the line printed for the table, without the time and node
+   */
+  std::vector<std::string>
+  getRow(const std::string& output, const std::string& table)
+  {
+    std::istringstream is(output);
+    std::string line;
+    while (std::getline(is, line)) {
+      std::vector<std::string> fields;
+      std::istringstream fieldStream(line);
+      std::string field;
+      while (std::getline(fieldStream, field, '\t')) {
+        fields.push_back(field);
+      }
+      if (fields.size() > 2 && fields[2] == table) {
+        return std::vector<std::string>(fields.begin() + 3, fields.end());
+      }
+    }
+    return {};
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnMemoryTracer, MemoryTracerFixture)
+
+BOOST_AUTO_TEST_CASE(EntryPool)
+{
+  nfd::Forwarder& forwarder = *getNode("1")->GetObject<L3Protocol>()->getForwarder();
+  const nfd::SlabPool& pool = forwarder.getNameTree().getPool();
+
+  MemoryTracer tracer(make_shared<std::ostringstream>(), getNode("1"));
+
+  std::ostringstream before;
+  tracer.Print(before);
+  std::vector<std::string> row = getRow(before.str(), "EntryPool");
+  BOOST_REQUIRE_EQUAL(row.size(), 3);
+  BOOST_CHECK_EQUAL(row[0], std::to_string(pool.getNBlocksInUse()));
+  BOOST_CHECK_EQUAL(row[1], std::to_string(pool.getNBytesReserved()));
+  BOOST_CHECK_EQUAL(row[2], "counted");
+  size_t nBlocksBefore = pool.getNBlocksInUse();
+
+  shared_ptr<nfd::pit::Entry> entry =
+    forwarder.getPit().insert(*make_shared<Interest>("/prefix/entry")).first;
+
+  std::ostringstream after;
+  tracer.Print(after);
+  row = getRow(after.str(), "EntryPool");
+  BOOST_REQUIRE_EQUAL(row.size(), 3);
+  BOOST_CHECK_EQUAL(row[0], std::to_string(pool.getNBlocksInUse()));
+  BOOST_CHECK_GT(pool.getNBlocksInUse(), nBlocksBefore);
+
+  // the pool holds the entries of the other tables, so it is not added to the total
+  std::vector<std::string> total = getRow(after.str(), "Total");
+  BOOST_REQUIRE(!total.empty());
+  uint64_t sum = 0;
+  for (const std::string& table : {"NameTree", "Fib", "Pit", "Measurements", "Cs"}) {
+    std::vector<std::string> tableRow = getRow(after.str(), table);
+    BOOST_REQUIRE_GE(tableRow.size(), 2);
+    sum += std::stoull(tableRow[1]);
+  }
+  std::vector<std::string> csRow = getRow(after.str(), "ContentStore");
+  if (!csRow.empty()) {
+    sum += std::stoull(csRow[1]);
+  }
+  BOOST_CHECK_EQUAL(total[1], std::to_string(sum));
+
+  forwarder.getPit().erase(entry);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
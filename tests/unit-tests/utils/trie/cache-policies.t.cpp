@@ -0,0 +1,300 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-content-store.hpp"
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/s4lru-policy.hpp"
+#include "utils/trie/arc-policy.hpp"
+#include "utils/trie/wtinylfu-policy.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "utils/trie/gdsf-policy.hpp"
+#include "utils/trie/lfu-policy.hpp"
+#include "utils/trie/lfu2-policy.hpp"
+#include "utils/trie/random2-policy.hpp"
+#include "utils/trie/detail/frequency-sketch.hpp"
+
+#include "../../tests-common.hpp"
+
+#include <random>
+
+namespace ns3 {
+namespace ndn {
+
+using namespace ndnSIM;
+
+/**
+ * @brief Payload traits where integer payload is also the payload size
+ */
+struct SizedPayloadTraits : public pointer_payload_traits<int> {
+  static size_t
+  size(const int* payload)
+  {
+    return *payload;
+  }
+};
+
+class CachePoliciesFixture : public CleanupFixture
+{
+public:
+  template<class Policy>
+  using Trie = trie_with_policy<Name, pointer_payload_traits<int>, Policy>;
+
+  static Name
+  makeName(int i)
+  {
+    return Name("/prefix").appendNumber(i);
+  }
+
+  /**
+   * @brief Get payloads in the order of the policy container (eviction order)
+   */
+  template<class Trie>
+  static std::vector<int>
+  getPolicyOrder(const Trie& trie)
+  {
+    std::vector<int> order;
+    for (const auto& item : trie.getPolicy()) {
+      order.push_back(*item.payload());
+    }
+    return order;
+  }
+
+public:
+  int payload = 1;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTrieCachePolicies, CachePoliciesFixture)
+
+BOOST_AUTO_TEST_CASE(S4Lru)
+{
+  Trie<s4lru_policy_traits> trie;
+  trie.getPolicy().set_max_size(4); // one entry per segment
+
+  trie.insert(makeName(0), &payload);
+  trie.deepest_prefix_match(makeName(0)); // promoted out of the lowest segment
+  trie.insert(makeName(1), &payload);
+  trie.insert(makeName(2), &payload); // pushes /1 out of the lowest segment
+
+  BOOST_CHECK(trie.find_exact(makeName(0)) != trie.end());
+  BOOST_CHECK(trie.find_exact(makeName(1)) == trie.end());
+  BOOST_CHECK(trie.find_exact(makeName(2)) != trie.end());
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ArcScanResistance)
+{
+  Trie<arc_policy_traits> trie;
+  trie.getPolicy().set_max_size(4);
+
+  trie.insert(makeName(0), &payload);
+  trie.deepest_prefix_match(makeName(0)); // moves to the frequency list
+
+  for (int i = 1; i <= 20; i++) {
+    trie.insert(makeName(i), &payload);
+  }
+
+  BOOST_CHECK(trie.find_exact(makeName(0)) != trie.end());
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(WTinyLfuAdmission)
+{
+  Trie<wtinylfu_policy_traits> trie;
+  trie.getPolicy().set_max_size(100);
+
+  for (int i = 0; i < 100; i++) {
+    trie.insert(makeName(i), &payload);
+  }
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 100; i++) {
+      trie.deepest_prefix_match(makeName(i));
+    }
+  }
+
+  // one-time names should not displace popular ones from the main cache
+  for (int i = 100; i < 600; i++) {
+    trie.insert(makeName(i), &payload);
+  }
+
+  int nPopular = 0;
+  for (int i = 0; i < 100; i++) {
+    if (trie.find_exact(makeName(i)) != trie.end())
+      nPopular++;
+  }
+  BOOST_CHECK_GE(nPopular, 99);
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(FrequencySketch)
+{
+  detail::frequency_sketch sketch;
+  sketch.resize(1000);
+
+  size_t hot = 1;
+  size_t oneHit = 2;
+  size_t unseen = 3;
+  for (int i = 0; i < 50; i++) {
+    sketch.increment(hot);
+  }
+  sketch.increment(oneHit);
+
+  BOOST_CHECK_GT(sketch.estimate(hot), sketch.estimate(oneHit));
+  BOOST_CHECK_GT(sketch.estimate(oneHit), sketch.estimate(unseen));
+  BOOST_CHECK_EQUAL(sketch.estimate(hot), 16); // saturated counters plus the doorkeeper
+}
+
+BOOST_AUTO_TEST_CASE(WTinyLfuAdmitsFrequentCandidate)
+{
+  Trie<wtinylfu_policy_traits> trie;
+  trie.getPolicy().set_max_size(100); // window of one entry
+
+  for (int i = 0; i < 100; i++) {
+    trie.insert(makeName(i), &payload);
+  }
+
+  // /500 becomes popular while in the window
+  trie.insert(makeName(500), &payload);
+  for (int i = 0; i < 5; i++) {
+    trie.deepest_prefix_match(makeName(500));
+  }
+
+  // pushed out of the window, /500 replaces the cold victim of the main cache
+  trie.insert(makeName(501), &payload);
+  BOOST_CHECK(trie.find_exact(makeName(500)) != trie.end());
+  BOOST_CHECK(trie.find_exact(makeName(0)) == trie.end());
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(ByteLimit)
+{
+  trie_with_policy<Name, SizedPayloadTraits, lru_policy_traits> trie;
+  trie.getPolicy().set_max_size(0);
+  trie.getPolicy().set_max_bytes(1000);
+
+  int small = 300;
+  int large = 600;
+  int huge = 1001;
+
+  trie.insert(makeName(0), &small);
+  trie.insert(makeName(1), &small);
+  trie.insert(makeName(2), &small);
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 3);
+
+  trie.insert(makeName(3), &large); // needs to evict /0 and /1
+  BOOST_CHECK(trie.find_exact(makeName(0)) == trie.end());
+  BOOST_CHECK(trie.find_exact(makeName(1)) == trie.end());
+  BOOST_CHECK(trie.find_exact(makeName(2)) != trie.end());
+  BOOST_CHECK(trie.find_exact(makeName(3)) != trie.end());
+
+  BOOST_CHECK(!trie.insert(makeName(4), &huge).second); // can never fit
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(GdsfPrefersSmallEntries)
+{
+  trie_with_policy<Name, SizedPayloadTraits, gdsf_policy_traits> trie;
+  trie.getPolicy().set_max_size(0);
+  trie.getPolicy().set_max_bytes(1000);
+
+  int small = 150;
+  int large = 800;
+
+  trie.insert(makeName(0), &large);
+  trie.insert(makeName(1), &small);
+  trie.insert(makeName(2), &small); // large entry has the lowest frequency/size
+
+  BOOST_CHECK(trie.find_exact(makeName(0)) == trie.end());
+  BOOST_CHECK(trie.find_exact(makeName(1)) != trie.end());
+  BOOST_CHECK(trie.find_exact(makeName(2)) != trie.end());
+}
+
+BOOST_AUTO_TEST_CASE(Lfu2MatchesLfu)
+{
+  Trie<lfu_policy_traits> lfu;
+  Trie<lfu2_policy_traits> lfu2;
+  lfu.getPolicy().set_max_size(20);
+  lfu2.getPolicy().set_max_size(20);
+
+  std::vector<int> payloads(100);
+  for (int i = 0; i < 100; i++) {
+    payloads[i] = i;
+  }
+
+  std::mt19937 rng(1);
+  for (int step = 0; step < 5000; step++) {
+    int i = rng() % 100;
+    if (rng() % 2 == 0) {
+      lfu.insert(makeName(i), &payloads[i]);
+      lfu2.insert(makeName(i), &payloads[i]);
+    }
+    else {
+      lfu.deepest_prefix_match(makeName(i));
+      lfu2.deepest_prefix_match(makeName(i));
+    }
+
+    std::vector<int> expected = getPolicyOrder(lfu);
+    std::vector<int> actual = getPolicyOrder(lfu2);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Random2IndexConsistency)
+{
+  typedef Trie<random2_policy_traits> Random2Trie;
+  Random2Trie trie;
+  trie.getPolicy().set_max_size(20);
+
+  std::vector<int> payloads(100);
+  std::mt19937 rng(1);
+  for (int step = 0; step < 5000; step++) {
+    int i = rng() % 100;
+    switch (rng() % 3) {
+    case 0:
+      trie.insert(makeName(i), &payloads[i]); // may evict a random entry
+      break;
+    case 1:
+      trie.erase(makeName(i)); // moves the last indexed entry into the freed slot
+      break;
+    default:
+      trie.modify(trie.find_exact(makeName(i)), [](int&) {});
+      break;
+    }
+
+    // indices of the entries are a permutation of [0, size)
+    std::vector<bool> isUsed(trie.getPolicy().size(), false);
+    for (const auto& item : trie.getPolicy()) {
+      size_t index = Random2Trie::policy_container::policy_base::get_index(&item);
+      BOOST_REQUIRE_LT(index, isUsed.size());
+      BOOST_REQUIRE(!isUsed[index]);
+      isUsed[index] = true;
+    }
+
+    size_t nCached = 0;
+    for (int j = 0; j < 100; j++) {
+      if (trie.find_exact(makeName(j)) != trie.end())
+        nCached++;
+    }
+    BOOST_REQUIRE_EQUAL(nCached, trie.getPolicy().size());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -27,6 +27,8 @@
 #include <sys/sysinfo.h>
 #endif
 
+#include <sys/resource.h>
+
 #ifdef __APPLE__
 #include <mach/task.h>
 #include <mach/mach_traps.h>
@@ -94,6 +96,24 @@ public:
     // other systems are not yet supported
     return -1;
   }
+
+  /**
+   * @brief Get peak memory utilization (maximum resident set size) in bytes
+   */
+  static inline int64_t
+  GetPeak()
+  {
+    ::rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+      return -1;
+    }
+
+#if defined(__APPLE__)
+    return usage.ru_maxrss; // reported in bytes
+#else
+    return static_cast<int64_t>(usage.ru_maxrss) * 1024; // reported in kilobytes
+#endif
+  }
 };
 
 #endif // MEM_USAGE_H
@@ -0,0 +1,339 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-seq-table.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t MIN_CAPACITY = 8;
+
+/**
+ * @brief Windows up to this many sequence numbers are always kept in the ring buffer
+ */
+static const size_t MAX_DENSE_SPAN = 256;
+
+/**
+ * @brief Wider windows are kept in the ring buffer while they have at least one tracked sequence
+ *        number per SPARSE_RATIO slots
+ */
+static const size_t SPARSE_RATIO = 4;
+
+static bool
+isDenseEnough(size_t span, size_t nEntries)
+{
+  return span <= std::max(MAX_DENSE_SPAN, SPARSE_RATIO * nEntries);
+}
+
+ConsumerSeqTable::ConsumerSeqTable()
+  : m_head(0)
+  , m_base(0)
+  , m_span(0)
+  , m_nEntries(0)
+  , m_isSparse(false)
+{
+}
+
+ConsumerSeqTable::Entry*
+ConsumerSeqTable::slot(uint32_t seq)
+{
+  if (m_isSparse) {
+    auto it = m_sparse.find(seq);
+    return it == m_sparse.end() ? nullptr : &it->second;
+  }
+
+  uint32_t offset = seq - m_base;
+  if (offset >= m_span)
+    return nullptr;
+
+  return &m_slots[(m_head + offset) & (m_slots.size() - 1)];
+}
+
+const ConsumerSeqTable::Entry*
+ConsumerSeqTable::find(uint32_t seq) const
+{
+  const Entry* entry = const_cast<ConsumerSeqTable*>(this)->slot(seq);
+  if (entry == nullptr || entry->state == NONE)
+    return nullptr;
+
+  return entry;
+}
+
+void
+ConsumerSeqTable::reallocate(size_t capacity)
+{
+  std::vector<Entry> slots(capacity);
+  for (size_t i = 0; i < m_span; i++) {
+    slots[i] = m_slots[(m_head + i) & (m_slots.size() - 1)];
+  }
+  m_slots.swap(slots);
+  m_head = 0;
+}
+
+void
+ConsumerSeqTable::grow(size_t span)
+{
+  if (span <= m_slots.size())
+    return;
+
+  size_t capacity = std::max(m_slots.size(), MIN_CAPACITY);
+  while (capacity < span)
+    capacity *= 2;
+
+  reallocate(capacity);
+}
+
+void
+ConsumerSeqTable::makeSparse()
+{
+  for (size_t i = 0; i < m_span; i++) {
+    const Entry& entry = m_slots[(m_head + i) & (m_slots.size() - 1)];
+    if (entry.state != NONE)
+      m_sparse.emplace_hint(m_sparse.end(), m_base + i, entry);
+  }
+
+  std::vector<Entry>().swap(m_slots);
+  m_head = 0;
+  m_base = 0;
+  m_span = 0;
+  m_isSparse = true;
+}
+
+bool
+ConsumerSeqTable::getSparseWindow(uint32_t& base, size_t& span) const
+{
+  static const uint32_t HALF = static_cast<uint32_t>(std::numeric_limits<int32_t>::max()) + 1;
+
+  base = m_sparse.begin()->first;
+  uint32_t last = m_sparse.rbegin()->first;
+  if (last - base >= HALF) {
+    // the window wraps past 0xFFFFFFFF: it starts in the upper half and ends in the lower half
+    auto upper = m_sparse.lower_bound(HALF);
+    base = upper->first;
+    last = std::prev(upper)->first;
+  }
+
+  if (last - base >= HALF)
+    return false;
+
+  span = static_cast<size_t>(last - base) + 1;
+  return true;
+}
+
+void
+ConsumerSeqTable::makeDense()
+{
+  m_isSparse = false;
+  if (m_sparse.empty())
+    return;
+
+  size_t span = 0;
+  getSparseWindow(m_base, span);
+  grow(span);
+  m_span = span;
+  for (const auto& item : m_sparse) {
+    m_slots[static_cast<uint32_t>(item.first - m_base)] = item.second;
+  }
+  m_sparse.clear();
+}
+
+ConsumerSeqTable::Entry&
+ConsumerSeqTable::extend(uint32_t seq)
+{
+  if (!m_isSparse && m_span > 0) {
+    int32_t offset = static_cast<int32_t>(seq - m_base);
+    size_t span = offset < 0 ? m_span - offset : std::max<size_t>(m_span, offset + 1);
+    if (!isDenseEnough(span, m_nEntries + 1))
+      makeSparse();
+  }
+
+  if (m_isSparse)
+    return m_sparse[seq];
+
+  if (m_span == 0) {
+    grow(1);
+    m_base = seq;
+    m_span = 1;
+  }
+
+  int32_t offset = static_cast<int32_t>(seq - m_base);
+  if (offset < 0) {
+    size_t extra = -static_cast<int64_t>(offset);
+    grow(m_span + extra);
+    // slots outside of the window are always clean
+    m_head = (m_head + m_slots.size() - extra) & (m_slots.size() - 1);
+    m_base = seq;
+    m_span += extra;
+  }
+  else if (static_cast<size_t>(offset) >= m_span) {
+    grow(offset + 1);
+    m_span = offset + 1;
+  }
+
+  return *slot(seq);
+}
+
+void
+ConsumerSeqTable::trim()
+{
+  while (m_span > 0 && m_slots[m_head].state == NONE) {
+    m_head = (m_head + 1) & (m_slots.size() - 1);
+    m_base++;
+    m_span--;
+  }
+
+  while (m_span > 0 && m_slots[(m_head + m_span - 1) & (m_slots.size() - 1)].state == NONE) {
+    m_span--;
+  }
+
+  // keep the window at least a quarter full, leaving room for it to double before growing again
+  size_t capacity = m_slots.size();
+  while (capacity > MIN_CAPACITY && m_span * 4 <= capacity) {
+    capacity /= 2;
+  }
+  if (capacity < m_slots.size()) {
+    reallocate(capacity);
+  }
+}
+
+void
+ConsumerSeqTable::sent(uint32_t seq, Time now)
+{
+  Entry& entry = extend(seq);
+  if (entry.state == NONE) {
+    entry.firstSent = now;
+    entry.retxCount = 0;
+    m_nEntries++;
+  }
+
+  entry.lastSent = now;
+  entry.retxCount++;
+  entry.state = OUTSTANDING;
+
+  m_expiry.push_back(Transmission{seq, now});
+}
+
+void
+ConsumerSeqTable::erase(uint32_t seq)
+{
+  Entry* entry = slot(seq);
+  if (entry == nullptr || entry->state == NONE)
+    return;
+
+  m_nEntries--;
+  if (m_isSparse) {
+    m_sparse.erase(seq);
+    // the window is dense again when the span shrinks to half of the limit
+    uint32_t base = 0;
+    size_t span = 0;
+    if (m_sparse.empty() ||
+        (getSparseWindow(base, span) &&
+         2 * span <= std::max(MAX_DENSE_SPAN, SPARSE_RATIO * m_nEntries)))
+      makeDense();
+  }
+  else {
+    *entry = Entry();
+    trim();
+  }
+
+  if (m_nEntries == 0) {
+    // everything left in the queues refers to erased entries
+    m_expiry.clear();
+    m_retx.clear();
+  }
+}
+
+bool
+ConsumerSeqTable::getEarliestSent(Time& lastSent)
+{
+  while (!m_expiry.empty()) {
+    const Transmission& front = m_expiry.front();
+    Entry* entry = slot(front.seq);
+    if (entry != nullptr && entry->state == OUTSTANDING && entry->lastSent == front.time) {
+      lastSent = front.time;
+      return true;
+    }
+
+    // satisfied, timed out, or sent again since
+    m_expiry.pop_front();
+  }
+  return false;
+}
+
+bool
+ConsumerSeqTable::popExpired(Time deadline, uint32_t& seq)
+{
+  Time lastSent;
+  if (!getEarliestSent(lastSent) || lastSent > deadline)
+    return false;
+
+  seq = m_expiry.front().seq;
+  m_expiry.pop_front();
+  slot(seq)->state = TIMED_OUT;
+  return true;
+}
+
+void
+ConsumerSeqTable::scheduleRetx(uint32_t seq)
+{
+  Entry* entry = slot(seq);
+  if (entry == nullptr || entry->state == NONE || entry->state == PENDING_RETX)
+    return;
+
+  entry->state = PENDING_RETX;
+  m_retx.push_back(seq);
+}
+
+bool
+ConsumerSeqTable::popRetx(uint32_t& seq)
+{
+  while (!m_retx.empty()) {
+    uint32_t next = m_retx.front();
+    m_retx.pop_front();
+
+    Entry* entry = slot(next);
+    if (entry != nullptr && entry->state == PENDING_RETX) {
+      entry->state = TIMED_OUT;
+      seq = next;
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+ConsumerSeqTable::clear()
+{
+  std::vector<Entry>().swap(m_slots);
+  m_head = 0;
+  m_base = 0;
+  m_span = 0;
+  m_nEntries = 0;
+  m_isSparse = false;
+  m_sparse.clear();
+  m_expiry.clear();
+  m_retx.clear();
+}
+
+} // namespace ndn
+} // namespace ns3
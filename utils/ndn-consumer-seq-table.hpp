@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_SEQ_TABLE_H
+#define NDN_CONSUMER_SEQ_TABLE_H
+
+#include "ns3/nstime.h"
+
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief State of the sequence numbers requested by a consumer application
+ *
+ * Per-sequence state is kept in a ring buffer indexed by `seq - base`, where base is the lowest
+ * sequence number that is still tracked, so the table takes one small slot per sequence number
+ * in the window between the oldest unsatisfied and the newest requested Interest.  The ring
+ * shrinks when the window does.  When the window is much wider than the number of tracked
+ * sequence numbers (e.g., for consumers requesting random sequence numbers), the state is
+ * moved to a sparse map, and back to the ring once the window is dense again.
+ *
+ * Transmissions are also recorded in a FIFO in the order they were made, which (as all
+ * transmissions share the same retransmission timeout) is the order in which they expire.
+ * Records of satisfied or retransmitted Interests are dropped lazily when they reach the front.
+ */
+class ConsumerSeqTable {
+public:
+  enum State : uint8_t {
+    NONE = 0,    ///< @brief sequence number is not tracked
+    OUTSTANDING, ///< @brief Interest is sent and not yet satisfied or timed out
+    TIMED_OUT,   ///< @brief Interest has timed out
+    PENDING_RETX ///< @brief Interest is queued for retransmission
+  };
+
+  struct Entry {
+    Time firstSent;     ///< @brief time of the first transmission
+    Time lastSent;      ///< @brief time of the last transmission
+    uint32_t retxCount; ///< @brief number of transmissions
+    State state;
+  };
+
+public:
+  ConsumerSeqTable();
+
+  /**
+   * @brief Record (re)transmission of the Interest for @p seq at time @p now
+   */
+  void
+  sent(uint32_t seq, Time now);
+
+  /**
+   * @return entry of @p seq, or nullptr if @p seq is not tracked
+   */
+  const Entry*
+  find(uint32_t seq) const;
+
+  /**
+   * @brief Stop tracking @p seq (e.g., when Data is received)
+   */
+  void
+  erase(uint32_t seq);
+
+  /**
+   * @brief Get the time when the earliest still outstanding transmission was made
+   * @return false if there are no outstanding Interests
+   */
+  bool
+  getEarliestSent(Time& lastSent);
+
+  /**
+   * @brief Take the earliest outstanding Interest, if it was sent no later than @p deadline
+   *
+   * The Interest becomes TIMED_OUT and stays in the table until it is erased or sent again.
+   *
+   * @return false if there is no such Interest
+   */
+  bool
+  popExpired(Time deadline, uint32_t& seq);
+
+  /**
+   * @brief Queue @p seq for retransmission (no-op if it is not tracked or already queued)
+   *
+   * If the Interest is still outstanding, it will no longer be reported by popExpired.
+   */
+  void
+  scheduleRetx(uint32_t seq);
+
+  /**
+   * @brief Take the next sequence number queued for retransmission
+   * @return false if nothing is queued
+   */
+  bool
+  popRetx(uint32_t& seq);
+
+  /**
+   * @brief Number of tracked sequence numbers
+   */
+  size_t
+  size() const
+  {
+    return m_nEntries;
+  }
+
+  /**
+   * @brief Number of allocated ring buffer slots (zero while entries are kept in the sparse map)
+   */
+  size_t
+  getCapacity() const
+  {
+    return m_slots.size();
+  }
+
+  void
+  clear();
+
+private:
+  Entry*
+  slot(uint32_t seq);
+
+  /**
+   * @brief Move entries of the ring buffer into a new ring buffer of @p capacity slots
+   */
+  void
+  reallocate(size_t capacity);
+
+  /**
+   * @brief Move entries from the ring buffer to the sparse map
+   */
+  void
+  makeSparse();
+
+  /**
+   * @brief Get the lowest sequence number and the span of the sparse map entries
+   *
+   * Sequence numbers are ordered as in extend(), so a window that wraps past 0xFFFFFFFF starts
+   * at the lowest entry of the upper half of the number space.
+   *
+   * @return false if the entries span half of the number space or more (there is no order)
+   */
+  bool
+  getSparseWindow(uint32_t& base, size_t& span) const;
+
+  /**
+   * @brief Move entries from the sparse map to the ring buffer
+   */
+  void
+  makeDense();
+
+  /**
+   * @brief Extend the window to cover @p seq, growing the ring buffer if needed
+   */
+  Entry&
+  extend(uint32_t seq);
+
+  void
+  grow(size_t span);
+
+  /**
+   * @brief Move base forward (and the window end backward) past untracked sequence numbers,
+   *        and shrink the ring buffer if the window has become much smaller than it
+   */
+  void
+  trim();
+
+private:
+  std::vector<Entry> m_slots; ///< @brief ring buffer, size is a power of 2
+  size_t m_head;              ///< @brief index of the slot for m_base
+  uint32_t m_base;            ///< @brief lowest sequence number in the window
+  size_t m_span;              ///< @brief number of sequence numbers in the window
+  size_t m_nEntries;
+
+  bool m_isSparse;                     ///< @brief whether entries are kept in m_sparse
+  std::map<uint32_t, Entry> m_sparse; ///< @brief entries of a wide window
+
+  struct Transmission {
+    uint32_t seq;
+    Time time;
+  };
+  std::deque<Transmission> m_expiry;
+  std::deque<uint32_t> m_retx;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_SEQ_TABLE_H
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-publication-tree.hpp"
+
+#include "ns3/log.h"
+
+#include <cstdlib>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PublicationTree");
+
+namespace ns3 {
+namespace ndn {
+
+PublicationTree::PublicationTree()
+  : m_nodes(1)
+{
+}
+
+void
+PublicationTree::addPath(const std::string& pitList)
+{
+  std::vector<uint64_t> faces;
+  std::istringstream is(pitList);
+  uint64_t face;
+  while (is >> face) {
+    faces.push_back(face);
+  }
+
+  // the last face of the PITList is the first hop from the producer
+  size_t node = 0;
+  for (auto hop = faces.rbegin(); hop != faces.rend(); ++hop) {
+    size_t next = 0;
+    for (const auto& child : m_nodes[node].children) {
+      if (child.first == *hop) {
+        next = child.second;
+        break;
+      }
+    }
+
+    if (next == 0) {
+      next = m_nodes.size();
+      m_nodes[node].children.push_back(std::make_pair(*hop, next));
+      m_nodes.push_back(Node());
+    }
+    node = next;
+  }
+}
+
+std::string
+PublicationTree::encode() const
+{
+  std::string out;
+  encode(0, out);
+  return out;
+}
+
+void
+PublicationTree::encode(size_t node, std::string& out) const
+{
+  out += '(';
+  bool isFirst = true;
+  for (const auto& child : m_nodes[node].children) {
+    if (!isFirst)
+      out += ' ';
+    isFirst = false;
+
+    out += std::to_string(child.first);
+    if (!m_nodes[child.second].children.empty())
+      encode(child.second, out);
+  }
+  out += ')';
+}
+
+std::vector<PublicationTree::Branch>
+PublicationTree::decode(const std::string& tree)
+{
+  if (!isEncoded(tree) || tree.back() != ')') {
+    NS_FATAL_ERROR("Invalid publication tree: " << tree);
+  }
+
+  std::vector<Branch> branches;
+  size_t pos = 1;
+  size_t end = tree.size() - 1;
+  while (pos < end) {
+    if (tree[pos] == ' ') {
+      ++pos;
+      continue;
+    }
+
+    char* faceEnd = nullptr;
+    uint64_t face = std::strtoull(tree.c_str() + pos, &faceEnd, 10);
+    if (faceEnd == tree.c_str() + pos) {
+      NS_FATAL_ERROR("Invalid publication tree: " << tree);
+    }
+    pos = faceEnd - tree.c_str();
+
+    size_t subtreeBegin = pos;
+    if (tree[pos] == '(') {
+      for (int depth = 0; pos < end; ++pos) {
+        if (tree[pos] == '(')
+          ++depth;
+        else if (tree[pos] == ')' && --depth == 0)
+          break;
+      }
+      if (pos == end) {
+        NS_FATAL_ERROR("Invalid publication tree: " << tree);
+      }
+      ++pos;
+    }
+
+    branches.push_back(Branch(face, tree.substr(subtreeBegin, pos - subtreeBegin)));
+  }
+
+  return branches;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PUBLICATION_TREE_H
+#define NDN_PUBLICATION_TREE_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Reverse-path tree of the subscribers of a validation publication
+ *
+ * Every router appends the id of the incoming face to the PITList of a validation Interest, so
+ * the PITList (`"f1 f2 ... fk "`) is the reverse path from the producer (fk) to the consumer
+ * (f1).  Paths of all subscribers of a name are merged into a trie rooted at the producer, so a
+ * publication crosses every link of the tree once.
+ *
+ * The tree is carried in PITListBack as a list of branches in parentheses: a branch is the id of
+ * the outgoing face, followed by the subtree of the next router (if any).  For example,
+ * `"(4(2 3(1)) 5)"` is forwarded to face 4 with `"(2 3(1))"` and to face 5 with an empty
+ * PITListBack.  Linear PITListBack never starts with `(`, so routers can tell the two apart.
+ */
+class PublicationTree {
+public:
+  typedef std::pair<uint64_t, std::string> Branch; ///< @brief outgoing face and encoded subtree
+
+  PublicationTree();
+
+  /**
+   * @brief Add reverse path of a subscriber
+   * @param pitList PITList of the subscriber's Interest
+   */
+  void
+  addPath(const std::string& pitList);
+
+  /**
+   * @brief Encode the tree for PITListBack
+   */
+  std::string
+  encode() const;
+
+  /**
+   * @brief Number of links of the tree
+   */
+  size_t
+  size() const
+  {
+    return m_nodes.size() - 1;
+  }
+
+  /**
+   * @brief Check whether @p pitListBack is an encoded tree rather than a linear path
+   */
+  static bool
+  isEncoded(const std::string& pitListBack)
+  {
+    return !pitListBack.empty() && pitListBack[0] == '(';
+  }
+
+  /**
+   * @brief Split an encoded tree into the branches of the root
+   *
+   * Subtree of a branch is empty if the face is the last hop of the branch.  Malformed input is
+   * a fatal error.
+   */
+  static std::vector<Branch>
+  decode(const std::string& tree);
+
+private:
+  void
+  encode(size_t node, std::string& out) const;
+
+private:
+  struct Node {
+    std::vector<std::pair<uint64_t, size_t>> children; ///< @brief face id and child node
+  };
+
+  std::vector<Node> m_nodes; ///< @brief nodes of the trie, root is the first
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PUBLICATION_TREE_H
@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-request-trace.hpp"
+
+#include "ns3/log.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RequestTrace");
+
+namespace ns3 {
+namespace ndn {
+
+const char RequestTrace::MAGIC[8] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+
+RequestTraceReader::RequestTraceReader(const std::string& fileName, size_t window)
+  : m_fileName(fileName)
+  , m_window(window)
+  , m_index(0)
+  , m_recordsBegin(0)
+  , m_nameTable(nullptr)
+{
+  std::ifstream is(fileName.c_str(), std::ios::binary);
+  if (!is.read(reinterpret_cast<char*>(&m_header), sizeof(m_header))
+      || !std::equal(m_header.magic, m_header.magic + sizeof(m_header.magic),
+                     RequestTrace::MAGIC)) {
+    NS_FATAL_ERROR("File " << fileName << " is not a request trace");
+  }
+  if (m_header.version != RequestTrace::VERSION) {
+    NS_FATAL_ERROR("Unsupported version " << m_header.version << " of request trace " << fileName);
+  }
+
+  boost::system::error_code error;
+  uint64_t fileSize = boost::filesystem::file_size(fileName, error);
+  uint64_t recordsEnd = sizeof(RequestTrace::Header)
+                        + m_header.nRecords * sizeof(RequestTrace::Record);
+  uint64_t namesEnd = m_header.namesOffset + m_header.nNames * sizeof(uint64_t);
+  if (error || fileSize < recordsEnd
+      || (hasNames() && (m_header.namesOffset < recordsEnd || fileSize < namesEnd))) {
+    NS_FATAL_ERROR("Request trace " << fileName << " is truncated");
+  }
+
+  if (hasNames() && m_header.nNames > 0) {
+    uint64_t alignment = boost::iostreams::mapped_file_source::alignment();
+    uint64_t begin = m_header.namesOffset / alignment * alignment;
+    m_names.open(fileName, fileSize - begin, begin);
+    m_nameTable = m_names.data() + (m_header.namesOffset - begin);
+  }
+}
+
+bool
+RequestTraceReader::next(RequestTrace::Record& record)
+{
+  if (m_index >= m_header.nRecords)
+    return false;
+
+  uint64_t offset = sizeof(RequestTrace::Header) + m_index * sizeof(RequestTrace::Record);
+  if (!m_records.is_open() || offset < m_recordsBegin
+      || offset + sizeof(RequestTrace::Record) > m_recordsBegin + m_records.size()) {
+    // map the next window, starting at the page containing the record
+    uint64_t recordsEnd = sizeof(RequestTrace::Header)
+                          + m_header.nRecords * sizeof(RequestTrace::Record);
+    uint64_t alignment = boost::iostreams::mapped_file_source::alignment();
+    uint64_t begin = offset / alignment * alignment;
+    uint64_t length = std::max<uint64_t>(m_window, offset - begin + sizeof(RequestTrace::Record));
+
+    m_records.close();
+    m_records.open(m_fileName, std::min(length, recordsEnd - begin), begin);
+    m_recordsBegin = begin;
+    NS_LOG_DEBUG("Mapped " << m_records.size() << " bytes of " << m_fileName << " at " << begin);
+  }
+
+  std::memcpy(&record, m_records.data() + (offset - m_recordsBegin), sizeof(record));
+  ++m_index;
+  return true;
+}
+
+Name
+RequestTraceReader::getName(uint32_t nameId) const
+{
+  NS_ASSERT_MSG(nameId < m_header.nNames, "Name " << nameId << " is not in the name table");
+
+  uint64_t offset = 0;
+  std::memcpy(&offset, m_nameTable + nameId * sizeof(uint64_t), sizeof(offset));
+  return Name(m_nameTable + m_header.nNames * sizeof(uint64_t) + offset);
+}
+
+RequestTraceWriter::RequestTraceWriter(const std::string& fileName)
+  : m_os(fileName.c_str(), std::ios::binary | std::ios::trunc)
+  , m_lastTime(std::numeric_limits<int64_t>::min())
+{
+  if (!m_os.good()) {
+    NS_FATAL_ERROR("Cannot open file " << fileName << " for writing");
+  }
+
+  std::memset(&m_header, 0, sizeof(m_header));
+  std::copy(RequestTrace::MAGIC, RequestTrace::MAGIC + sizeof(RequestTrace::MAGIC),
+            m_header.magic);
+  m_header.version = RequestTrace::VERSION;
+
+  // placeholder, the header is rewritten on close
+  m_os.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+}
+
+RequestTraceWriter::~RequestTraceWriter()
+{
+  close();
+}
+
+uint32_t
+RequestTraceWriter::addName(const std::string& uri)
+{
+  auto i = m_nameIds.insert(std::make_pair(uri, static_cast<uint32_t>(m_names.size())));
+  if (i.second)
+    m_names.push_back(&i.first->first);
+  return i.first->second;
+}
+
+void
+RequestTraceWriter::append(Time time, uint32_t nameId, uint32_t user)
+{
+  RequestTrace::Record record;
+  record.time = time.GetNanoSeconds();
+  record.nameId = nameId;
+  record.user = user;
+
+  if (record.time < m_lastTime) {
+    NS_FATAL_ERROR("Request trace records must be ordered by time (" << time << " after "
+                                                                     << NanoSeconds(m_lastTime)
+                                                                     << ")");
+  }
+  m_lastTime = record.time;
+
+  m_os.write(reinterpret_cast<const char*>(&record), sizeof(record));
+  ++m_header.nRecords;
+}
+
+void
+RequestTraceWriter::close()
+{
+  if (!m_os.is_open())
+    return;
+
+  if (!m_names.empty()) {
+    m_header.flags |= RequestTrace::HAS_NAMES;
+    m_header.nNames = m_names.size();
+    m_header.namesOffset = m_os.tellp();
+
+    uint64_t offset = 0;
+    for (const std::string* name : m_names) {
+      m_os.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+      offset += name->size() + 1;
+    }
+    for (const std::string* name : m_names) {
+      m_os.write(name->c_str(), name->size() + 1);
+    }
+  }
+
+  m_os.seekp(0);
+  m_os.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+  m_os.close();
+}
+
+uint64_t
+ConvertCsvToRequestTrace(std::istream& csv, const std::string& fileName)
+{
+  RequestTraceWriter writer(fileName);
+  enum { UNKNOWN, NAMES, NUMBERS } kind = UNKNOWN;
+  bool isFirstLine = true;
+  uint64_t nRecords = 0;
+
+  std::string line;
+  for (uint64_t lineNo = 1; std::getline(csv, line); ++lineNo) {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    size_t nameBegin = line.find(',');
+    if (nameBegin == std::string::npos) {
+      NS_FATAL_ERROR("Line " << lineNo << " of request log does not have a name: " << line);
+    }
+    size_t userBegin = line.find(',', nameBegin + 1);
+
+    char* end = nullptr;
+    double time = std::strtod(line.c_str(), &end);
+    if (end != line.c_str() + nameBegin) {
+      if (isFirstLine) {
+        isFirstLine = false;
+        continue; // column headers
+      }
+      NS_FATAL_ERROR("Invalid time on line " << lineNo << " of request log: " << line);
+    }
+    isFirstLine = false;
+
+    std::string name = line.substr(nameBegin + 1, userBegin == std::string::npos
+                                                    ? std::string::npos
+                                                    : userBegin - nameBegin - 1);
+    if (name.empty()) {
+      NS_FATAL_ERROR("Line " << lineNo << " of request log does not have a name: " << line);
+    }
+
+    uint32_t nameId = 0;
+    if (name[0] == '/') {
+      if (kind == NUMBERS) {
+        NS_FATAL_ERROR("Line " << lineNo << " of request log mixes names and sequence numbers");
+      }
+      kind = NAMES;
+      nameId = writer.addName(name);
+    }
+    else {
+      if (kind == NAMES) {
+        NS_FATAL_ERROR("Line " << lineNo << " of request log mixes names and sequence numbers");
+      }
+      kind = NUMBERS;
+      nameId = std::strtoul(name.c_str(), nullptr, 10);
+    }
+
+    uint32_t user = 0;
+    if (userBegin != std::string::npos) {
+      user = std::strtoul(line.c_str() + userBegin + 1, nullptr, 10);
+    }
+
+    writer.append(Seconds(time), nameId, user);
+    ++nRecords;
+  }
+
+  writer.close();
+  return nRecords;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_REQUEST_TRACE_H
+#define NDN_REQUEST_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <fstream>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Layout of the binary request trace replayed by ConsumerTrace
+ *
+ * The file consists of the Header, Header::nRecords fixed-size Records ordered by time, and
+ * (if the trace has names) the name table at Header::namesOffset: Header::nNames 64-bit offsets
+ * relative to the end of the offset array, followed by NUL-terminated name URIs.  If the trace
+ * has no name table, name id of a record is used as the sequence number of the requested name.
+ * Numbers are stored in host byte order.
+ */
+struct RequestTrace {
+  static const char MAGIC[8];
+  static const uint32_t VERSION = 1;
+
+  enum Flags : uint32_t { HAS_NAMES = 1 };
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t nRecords;
+    uint64_t nNames;
+    uint64_t namesOffset;
+  };
+
+  struct Record {
+    int64_t time;    ///< @brief time of the request in nanoseconds
+    uint32_t nameId; ///< @brief index in the name table or sequence number
+    uint32_t user;   ///< @brief user id (0 if not specified)
+  };
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Sequential reader of the request trace
+ *
+ * Only a window of the records is memory-mapped at a time, so traces larger than the memory can
+ * be replayed.  The name table is mapped as a whole.
+ */
+class RequestTraceReader {
+public:
+  /**
+   * @brief Open trace @p fileName (fatal error if the file is not a valid request trace)
+   * @param window maximum size of the mapped part of the records, in bytes
+   */
+  RequestTraceReader(const std::string& fileName, size_t window);
+
+  const RequestTrace::Header&
+  getHeader() const
+  {
+    return m_header;
+  }
+
+  /**
+   * @brief Read the next record
+   * @return false if all records have been read
+   */
+  bool
+  next(RequestTrace::Record& record);
+
+  /**
+   * @brief Restart reading from the first record
+   */
+  void
+  rewind()
+  {
+    m_index = 0;
+  }
+
+  bool
+  hasNames() const
+  {
+    return (m_header.flags & RequestTrace::HAS_NAMES) != 0;
+  }
+
+  /**
+   * @brief Get name from the name table (trace must have names)
+   */
+  Name
+  getName(uint32_t nameId) const;
+
+private:
+  std::string m_fileName;
+  size_t m_window;
+  RequestTrace::Header m_header;
+  uint64_t m_index; ///< @brief index of the next record
+
+  boost::iostreams::mapped_file_source m_records;
+  uint64_t m_recordsBegin; ///< @brief file offset of the mapped window
+  boost::iostreams::mapped_file_source m_names;
+  const char* m_nameTable; ///< @brief start of the name table in the mapped region
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Writer of the request trace
+ */
+class RequestTraceWriter {
+public:
+  explicit RequestTraceWriter(const std::string& fileName);
+
+  ~RequestTraceWriter();
+
+  /**
+   * @brief Get id of the name in the name table, adding the name if necessary
+   */
+  uint32_t
+  addName(const std::string& uri);
+
+  /**
+   * @brief Append a record (records must be appended in the order of time)
+   */
+  void
+  append(Time time, uint32_t nameId, uint32_t user = 0);
+
+  /**
+   * @brief Write the name table and the header
+   */
+  void
+  close();
+
+private:
+  std::ofstream m_os;
+  RequestTrace::Header m_header;
+  int64_t m_lastTime;
+
+  std::unordered_map<std::string, uint32_t> m_nameIds;
+  std::vector<const std::string*> m_names;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Convert CSV request log into binary request trace
+ *
+ * Every line of the input is `<time>,<name>[,<user>]`, where time is in seconds and name is
+ * either a name URI (starting with `/`) or a non-negative integer (to be used as a sequence
+ * number).  Lines starting with `#` and a header line are ignored.  Times must not decrease
+ * and all names must be of the same kind.
+ *
+ * @return number of converted records
+ */
+uint64_t
+ConvertCsvToRequestTrace(std::istream& csv, const std::string& fileName);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REQUEST_TRACE_H
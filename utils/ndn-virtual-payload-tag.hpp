@@ -0,0 +1,61 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_VIRTUAL_PAYLOAD_TAG_HPP
+#define NDN_VIRTUAL_PAYLOAD_TAG_HPP
+
+#include <ndn-cxx/tag.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Declared length of payload that is not present in the packet
+ *
+ * When converted to ns-3 packet, the payload is carried as zero-filled bytes of ns-3 packet (no
+ * memory is allocated for them), so links spend time to transmit the full size.  When converted
+ * back, the bytes that follow the NDN header are recorded in this tag again.
+ */
+class VirtualPayloadTag : public ::ndn::Tag {
+public:
+  static size_t
+  getTypeId()
+  {
+    return 0x6cf9bd9a; // md5("VirtualPayloadTag")[0:8]
+  }
+
+  VirtualPayloadTag(size_t size)
+    : m_size(size)
+  {
+  }
+
+  size_t
+  getSize() const
+  {
+    return m_size;
+  }
+
+private:
+  size_t m_size;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_VIRTUAL_PAYLOAD_TAG_HPP
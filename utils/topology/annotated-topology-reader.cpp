@@ -52,7 +52,13 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graphviz.hpp>
 
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstring>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifdef NS3_MPI
 #include <ns3/mpi-interface.h>
@@ -151,115 +157,488 @@ AnnotatedTopologyReader::GetLinks() const
   return m_linksList;
 }
 
-NodeContainer
-AnnotatedTopologyReader::Read(void)
+void
+AnnotatedTopologyReader::SetCacheFile(const std::string& file)
 {
-  ifstream topgen;
-  topgen.open(GetFileName().c_str());
+  m_cacheFile = file;
+}
 
-  if (!topgen.is_open() || !topgen.good()) {
-    NS_FATAL_ERROR("Cannot open file " << GetFileName() << " for reading");
-    return m_nodes;
+/// @cond include_hidden
+
+namespace {
+
+const uint32_t NO_STRING = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Topology as parsed from the annotated file, with all strings interned
+ */
+struct TopologyRecords {
+  enum { CAPACITY, METRIC, DELAY, MAX_PACKETS, LOSS_RATE, N_ATTRIBUTES };
+
+  struct NodeRecord {
+    uint32_t name;
+    double latitude;
+    double longitude;
+    uint32_t systemId;
+  };
+
+  struct LinkRecord {
+    uint32_t from; ///< index in nodes
+    uint32_t to;   ///< index in nodes
+    uint32_t attributes[N_ATTRIBUTES];
+  };
+
+  std::vector<std::string> strings;
+  std::vector<NodeRecord> nodes;
+  std::vector<LinkRecord> links;
+  bool hasLinkSection = false;
+};
+
+const char CACHE_MAGIC[8] = {'N', 'D', 'N', 'T', 'O', 'P', 'O', '2'};
+
+class StringInterner {
+public:
+  explicit StringInterner(std::vector<std::string>& strings)
+    : m_strings(strings)
+  {
+  }
+
+  uint32_t
+  operator()(const char* begin, const char* end)
+  {
+    if (begin == end)
+      return NO_STRING;
+
+    auto i = m_ids.insert(make_pair(string(begin, end), static_cast<uint32_t>(m_strings.size())));
+    if (i.second)
+      m_strings.push_back(i.first->first);
+    return i.first->second;
   }
 
-  while (!topgen.eof()) {
-    string line;
-    getline(topgen, line);
+private:
+  std::vector<std::string>& m_strings;
+  unordered_map<string, uint32_t> m_ids;
+};
 
-    if (line == "router")
+/**
+ * @brief Split [begin, end) into at most @p maxTokens whitespace separated tokens
+ * @return number of tokens found
+ */
+size_t
+tokenize(const char* begin, const char* end, std::pair<const char*, const char*>* tokens,
+         size_t maxTokens)
+{
+  size_t nTokens = 0;
+  while (begin != end && nTokens < maxTokens) {
+    while (begin != end && (*begin == ' ' || *begin == '\t' || *begin == '\r'))
+      ++begin;
+    if (begin == end)
       break;
+
+    const char* tokenEnd = begin;
+    while (tokenEnd != end && *tokenEnd != ' ' && *tokenEnd != '\t' && *tokenEnd != '\r')
+      ++tokenEnd;
+
+    tokens[nTokens++] = std::make_pair(begin, tokenEnd);
+    begin = tokenEnd;
   }
+  return nTokens;
+}
 
-  if (topgen.eof()) {
-    NS_FATAL_ERROR("Topology file " << GetFileName() << " does not have \"router\" section");
-    return m_nodes;
+bool
+isLine(const char* begin, const char* end, const char* keyword)
+{
+  if (end != begin && *(end - 1) == '\r')
+    --end;
+  return static_cast<size_t>(end - begin) == strlen(keyword)
+         && std::equal(begin, end, keyword);
+}
+
+/**
+ * @brief Single-pass parser of the memory-mapped annotated topology file
+ */
+void
+parseTopology(const std::string& fileName, TopologyRecords& records)
+{
+  boost::system::error_code error;
+  if (boost::filesystem::file_size(fileName, error) == 0 || error) {
+    NS_FATAL_ERROR("Topology file " << fileName << " does not have \"router\" section");
+    return;
   }
 
-  while (!topgen.eof()) {
-    string line;
-    getline(topgen, line);
-    if (line[0] == '#')
-      continue; // comments
-    if (line == "link")
-      break; // stop reading nodes
-
-    istringstream lineBuffer(line);
-    string name, city;
-    double latitude = 0, longitude = 0;
-    uint32_t systemId = 0;
-
-    lineBuffer >> name >> city >> latitude >> longitude >> systemId;
-    if (name.empty())
-      continue;
+  boost::iostreams::mapped_file_source file;
+  try {
+    file.open(fileName);
+  }
+  catch (const std::exception& e) {
+    NS_FATAL_ERROR("Cannot open file " << fileName << " for reading");
+    return;
+  }
 
-    Ptr<Node> node;
+  StringInterner intern(records.strings);
+  unordered_map<uint32_t, uint32_t> nodeIds; // interned name -> index in records.nodes
+  unordered_set<uint64_t> processedLinks;    // to eliminate duplications
 
-    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
-    else {
-      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
-      // node = CreateNode (name, systemId);
+  enum { PREAMBLE, ROUTERS, LINKS } section = PREAMBLE;
+
+  std::pair<const char*, const char*> tokens[7];
+  const char* position = file.data();
+  const char* fileEnd = file.data() + file.size();
+  while (position != fileEnd) {
+    const char* lineEnd = std::find(position, fileEnd, '\n');
+    const char* line = position;
+    position = lineEnd == fileEnd ? fileEnd : lineEnd + 1;
+
+    switch (section) {
+    case PREAMBLE:
+      if (isLine(line, lineEnd, "router"))
+        section = ROUTERS;
+      break;
+
+    case ROUTERS: {
+      if (line != lineEnd && *line == '#')
+        continue; // comments
+      if (isLine(line, lineEnd, "link")) {
+        section = LINKS; // stop reading nodes
+        records.hasLinkSection = true;
+        continue;
+      }
+
+      size_t nTokens = tokenize(line, lineEnd, tokens, 5);
+      if (nTokens == 0)
+        continue;
+
+      // zero the padding too, as records are written to the cache byte by byte
+      TopologyRecords::NodeRecord node;
+      std::memset(&node, 0, sizeof(node));
+      node.name = intern(tokens[0].first, tokens[0].second);
+      if (nTokens > 2)
+        node.latitude = strtod(string(tokens[2].first, tokens[2].second).c_str(), nullptr);
+      if (nTokens > 3)
+        node.longitude = strtod(string(tokens[3].first, tokens[3].second).c_str(), nullptr);
+      if (nTokens > 4)
+        node.systemId = strtoul(string(tokens[4].first, tokens[4].second).c_str(), nullptr, 10);
+
+      nodeIds[node.name] = records.nodes.size();
+      records.nodes.push_back(node);
+      break;
+    }
+
+    case LINKS: {
+      if (line != lineEnd && *line == '#')
+        continue; // comments
+
+      size_t nTokens = tokenize(line, lineEnd, tokens, 7);
+      if (nTokens == 0)
+        continue;
+      if (nTokens < 2)
+        NS_FATAL_ERROR("Invalid link specification: " << string(line, lineEnd));
+
+      TopologyRecords::LinkRecord link;
+      for (size_t i = 0; i < 2; ++i) {
+        uint32_t name = intern(tokens[i].first, tokens[i].second);
+        auto node = nodeIds.find(name);
+        if (node == nodeIds.end())
+          NS_FATAL_ERROR(records.strings[name] << " node not found");
+        (i == 0 ? link.from : link.to) = node->second;
+      }
+
+      if (processedLinks.count((static_cast<uint64_t>(link.to) << 32) | link.from) > 0)
+        continue; // duplicated link
+      processedLinks.insert((static_cast<uint64_t>(link.from) << 32) | link.to);
+
+      for (size_t i = 0; i < TopologyRecords::N_ATTRIBUTES; ++i) {
+        link.attributes[i] = i + 2 < nTokens ? intern(tokens[i + 2].first, tokens[i + 2].second)
+                                             : NO_STRING;
+      }
+      records.links.push_back(link);
+      break;
+    }
     }
   }
 
-  map<string, set<string>> processedLinks; // to eliminate duplications
+  if (section == PREAMBLE)
+    NS_FATAL_ERROR("Topology file " << fileName << " does not have \"router\" section");
+}
 
-  if (topgen.eof()) {
-    NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
-    return m_nodes;
+template<class T>
+void
+writeValue(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<class T>
+bool
+readValue(std::istream& is, T& value)
+{
+  return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+/**
+ * @brief Read a length-prefixed string of at most @p maxLength bytes
+ */
+bool
+readString(std::istream& is, std::string& str, uint64_t maxLength)
+{
+  uint32_t length = 0;
+  if (!readValue(is, length) || length > maxLength)
+    return false;
+  str.resize(length);
+  return length == 0 || static_cast<bool>(is.read(&str[0], length));
+}
+
+void
+writeString(std::ostream& os, const std::string& str)
+{
+  writeValue(os, static_cast<uint32_t>(str.size()));
+  os.write(str.data(), str.size());
+}
+
+/**
+ * @brief Identity of the topology file version from which a cache is created
+ */
+struct SourceInfo {
+  std::string path; ///< canonical path
+  uint64_t size;
+  int64_t time;
+};
+
+bool
+getSourceInfo(const std::string& fileName, SourceInfo& info)
+{
+  boost::system::error_code error;
+  info.path = boost::filesystem::canonical(fileName, error).string();
+  if (error)
+    return false;
+  info.size = boost::filesystem::file_size(fileName, error);
+  if (error)
+    return false;
+  info.time = boost::filesystem::last_write_time(fileName, error);
+  return !error;
+}
+
+/**
+ * @brief Load cached topology, if the cache was created from the current version of @p fileName
+ *
+ * The cache is rejected if it was created from another file, or if any string index or link
+ * endpoint is out of range.
+ */
+bool
+loadCache(const std::string& cacheName, const std::string& fileName, TopologyRecords& records)
+{
+  SourceInfo source;
+  if (!getSourceInfo(fileName, source))
+    return false;
+
+  // counts read from a damaged cache must not make us allocate more than the cache holds
+  boost::system::error_code error;
+  uint64_t cacheSize = boost::filesystem::file_size(cacheName, error);
+  if (error)
+    return false;
+
+  ifstream is(cacheName.c_str(), ios::binary);
+  if (!is.good())
+    return false;
+
+  char magic[sizeof(CACHE_MAGIC)];
+  SourceInfo cached;
+  if (!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), CACHE_MAGIC)
+      || !readString(is, cached.path, cacheSize) || !readValue(is, cached.size)
+      || !readValue(is, cached.time) || cached.path != source.path
+      || cached.size != source.size || cached.time != source.time)
+    return false;
+
+  uint32_t nStrings = 0;
+  if (!readValue(is, nStrings) || nStrings > cacheSize / sizeof(uint32_t))
+    return false;
+  records.strings.resize(nStrings);
+  for (auto& str : records.strings) {
+    if (!readString(is, str, cacheSize))
+      return false;
   }
 
-  // SeekToSection ("link");
-  while (!topgen.eof()) {
-    string line;
-    getline(topgen, line);
-    if (line == "")
-      continue;
-    if (line[0] == '#')
-      continue; // comments
+  uint32_t nNodes = 0, nLinks = 0;
+  if (!readValue(is, nNodes) || nNodes > cacheSize / sizeof(TopologyRecords::NodeRecord))
+    return false;
+  records.nodes.resize(nNodes);
+  if (nNodes > 0 && !is.read(reinterpret_cast<char*>(&records.nodes[0]),
+                             nNodes * sizeof(TopologyRecords::NodeRecord)))
+    return false;
+  for (const auto& node : records.nodes) {
+    if (node.name >= nStrings)
+      return false;
+  }
+
+  if (!readValue(is, nLinks) || nLinks > cacheSize / sizeof(TopologyRecords::LinkRecord))
+    return false;
+  records.links.resize(nLinks);
+  if (nLinks > 0 && !is.read(reinterpret_cast<char*>(&records.links[0]),
+                             nLinks * sizeof(TopologyRecords::LinkRecord)))
+    return false;
+  for (const auto& link : records.links) {
+    if (link.from >= nNodes || link.to >= nNodes)
+      return false;
+    for (uint32_t attribute : link.attributes) {
+      if (attribute != NO_STRING && attribute >= nStrings)
+        return false;
+    }
+  }
 
-    // NS_LOG_DEBUG ("Input: [" << line << "]");
+  records.hasLinkSection = true;
+  return true;
+}
+
+void
+saveCache(const std::string& cacheName, const std::string& fileName,
+          const TopologyRecords& records)
+{
+  SourceInfo source;
+  if (!getSourceInfo(fileName, source)) {
+    NS_LOG_WARN("Cannot stat topology file " << fileName << ", cache is not written");
+    return;
+  }
 
-    istringstream lineBuffer(line);
-    string from, to, capacity, metric, delay, maxPackets, lossRate;
+  ofstream os(cacheName.c_str(), ios::binary | ios::trunc);
+  if (!os.good()) {
+    NS_LOG_WARN("Cannot write topology cache " << cacheName);
+    return;
+  }
+
+  os.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  writeString(os, source.path);
+  writeValue(os, source.size);
+  writeValue(os, source.time);
 
-    lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
+  writeValue(os, static_cast<uint32_t>(records.strings.size()));
+  for (const auto& str : records.strings) {
+    writeString(os, str);
+  }
 
-    if (processedLinks[to].size() != 0
-        && processedLinks[to].find(from) != processedLinks[to].end()) {
-      continue; // duplicated link
+  writeValue(os, static_cast<uint32_t>(records.nodes.size()));
+  if (!records.nodes.empty())
+    os.write(reinterpret_cast<const char*>(&records.nodes[0]),
+             records.nodes.size() * sizeof(TopologyRecords::NodeRecord));
+
+  writeValue(os, static_cast<uint32_t>(records.links.size()));
+  if (!records.links.empty())
+    os.write(reinterpret_cast<const char*>(&records.links[0]),
+             records.links.size() * sizeof(TopologyRecords::LinkRecord));
+}
+
+/**
+ * @brief Parsed "<Type>,<Attribute>=<Value>,..." specification (or just a number)
+ */
+struct AttributeList {
+  bool isNumber = false;
+  uint32_t number = 0;
+  std::string type;
+  std::list<std::pair<std::string, std::string>> attributes;
+};
+
+AttributeList
+parseAttributeList(const std::string& value, const std::string& what)
+{
+  AttributeList list;
+
+  try {
+    list.number = boost::lexical_cast<uint32_t>(value);
+    list.isNumber = true;
+  }
+  catch (const boost::bad_lexical_cast&) {
+  }
+
+  typedef boost::tokenizer<boost::escaped_list_separator<char>> tokenizer;
+  tokenizer tok(value);
+
+  tokenizer::iterator token = tok.begin();
+  list.type = *token;
+
+  for (token++; token != tok.end(); token++) {
+    boost::escaped_list_separator<char> separator('\\', '=', '\"');
+    tokenizer attributeTok(*token, separator);
+
+    tokenizer::iterator attributeToken = attributeTok.begin();
+
+    string attribute = *attributeToken;
+    attributeToken++;
+
+    if (attributeToken == attributeTok.end()) {
+      NS_LOG_ERROR(what << " attribute [" << *token << "] should be in form <Attribute>=<Value>");
+      continue;
     }
-    processedLinks[from].insert(to);
 
-    Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
-    NS_ASSERT_MSG(fromNode != 0, from << " node not found");
-    Ptr<Node> toNode = Names::Find<Node>(m_path, to);
-    NS_ASSERT_MSG(toNode != 0, to << " node not found");
+    list.attributes.push_back(make_pair(attribute, *attributeToken));
+  }
+
+  return list;
+}
+
+} // namespace
 
-    Link link(fromNode, from, toNode, to);
+/// @endcond
+
+NodeContainer
+AnnotatedTopologyReader::Read(void)
+{
+  TopologyRecords records;
 
-    link.SetAttribute("DataRate", capacity);
-    link.SetAttribute("OSPF", metric);
+  bool isCached = !m_cacheFile.empty() && loadCache(m_cacheFile, GetFileName(), records);
+  if (isCached) {
+    NS_LOG_INFO("Topology is loaded from cache " << m_cacheFile);
+  }
+  else {
+    records = TopologyRecords();
+    parseTopology(GetFileName(), records);
+  }
+
+  std::vector<Ptr<Node>> nodes;
+  nodes.reserve(records.nodes.size());
+  for (const auto& record : records.nodes) {
+    const string& name = records.strings[record.name];
+    double latitude = record.latitude;
+    double longitude = record.longitude;
+
+    Ptr<Node> node;
 
-    if (!delay.empty())
-      link.SetAttribute("Delay", delay);
-    if (!maxPackets.empty())
-      link.SetAttribute("MaxPackets", maxPackets);
+    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
+      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, record.systemId);
+    else {
+      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
+      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), record.systemId);
+      // node = CreateNode (name, systemId);
+    }
+    nodes.push_back(node);
+  }
 
-    // Saran Added lossRate
-    if (!lossRate.empty())
-      link.SetAttribute("LossRate", lossRate);
+  if (!records.hasLinkSection) {
+    NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
+    return m_nodes;
+  }
+
+  static const char* attributeNames[TopologyRecords::N_ATTRIBUTES] = {"DataRate", "OSPF", "Delay",
+                                                                       "MaxPackets", "LossRate"};
+  for (const auto& record : records.links) {
+    Link link(nodes[record.from], records.strings[records.nodes[record.from].name],
+              nodes[record.to], records.strings[records.nodes[record.to].name]);
+
+    for (size_t i = 0; i < TopologyRecords::N_ATTRIBUTES; ++i) {
+      // capacity and metric are always set, the rest only when specified
+      if (record.attributes[i] != NO_STRING)
+        link.SetAttribute(attributeNames[i], records.strings[record.attributes[i]]);
+      else if (i <= TopologyRecords::METRIC)
+        link.SetAttribute(attributeNames[i], "");
+    }
 
     AddLink(link);
-    NS_LOG_DEBUG("New link " << from << " <==> " << to << " / " << capacity << " with " << metric
-                             << " metric (" << delay << ", " << maxPackets << ", " << lossRate
-                             << ")");
+    NS_LOG_DEBUG("New link " << link.GetFromNodeName() << " <==> " << link.GetToNodeName());
   }
 
   NS_LOG_INFO("Annotated topology created with " << m_nodes.GetN() << " nodes and " << LinksSize()
                                                  << " links");
-  topgen.close();
+
+  if (!m_cacheFile.empty() && !isCached)
+    saveCache(m_cacheFile, GetFileName(), records);
 
   ApplySettings();
 
@@ -338,6 +717,16 @@ AnnotatedTopologyReader::ApplySettings()
 
   PointToPointHelper p2p;
 
+  // links typically share a handful of distinct attribute strings, tokenize each only once
+  std::unordered_map<std::string, AttributeList> parsedAttributes;
+  auto getAttributeList = [&parsedAttributes] (const std::string& value,
+                                               const std::string& what) -> const AttributeList& {
+    auto i = parsedAttributes.find(value);
+    if (i == parsedAttributes.end())
+      i = parsedAttributes.insert(make_pair(value, parseAttributeList(value, what))).first;
+    return i->second;
+  };
+
   BOOST_FOREACH (Link& link, m_linksList) {
     // cout << "Link: " << Findlink.GetFromNode () << ", " << link.GetToNode () << endl;
     string tmp;
@@ -346,38 +735,15 @@ AnnotatedTopologyReader::ApplySettings()
     if (link.GetAttributeFailSafe("MaxPackets", tmp)) {
       NS_LOG_INFO("MaxPackets = " + link.GetAttribute("MaxPackets"));
 
-      try {
-        uint32_t maxPackets = boost::lexical_cast<uint32_t>(link.GetAttribute("MaxPackets"));
-
+      const AttributeList& queue = getAttributeList(link.GetAttribute("MaxPackets"), "Queue");
+      if (queue.isNumber) {
         // compatibility mode. Only DropTailQueue is supported
-        p2p.SetQueue("ns3::DropTailQueue", "MaxPackets", UintegerValue(maxPackets));
+        p2p.SetQueue("ns3::DropTailQueue", "MaxPackets", UintegerValue(queue.number));
       }
-      catch (...) {
-        typedef boost::tokenizer<boost::escaped_list_separator<char>> tokenizer;
-        std::string value = link.GetAttribute("MaxPackets");
-        tokenizer tok(value);
-
-        tokenizer::iterator token = tok.begin();
-        p2p.SetQueue(*token);
-
-        for (token++; token != tok.end(); token++) {
-          boost::escaped_list_separator<char> separator('\\', '=', '\"');
-          tokenizer attributeTok(*token, separator);
-
-          tokenizer::iterator attributeToken = attributeTok.begin();
-
-          string attribute = *attributeToken;
-          attributeToken++;
-
-          if (attributeToken == attributeTok.end()) {
-            NS_LOG_ERROR("Queue attribute [" << *token
-                                             << "] should be in form <Attribute>=<Value>");
-            continue;
-          }
-
-          string value = *attributeToken;
-
-          p2p.SetQueueAttribute(attribute, StringValue(value));
+      else {
+        p2p.SetQueue(queue.type);
+        for (const auto& attribute : queue.attributes) {
+          p2p.SetQueueAttribute(attribute.first, StringValue(attribute.second));
         }
       }
     }
@@ -399,31 +765,11 @@ AnnotatedTopologyReader::ApplySettings()
     if (link.GetAttributeFailSafe("LossRate", tmp)) {
       NS_LOG_INFO("LinkError = " + link.GetAttribute("LossRate"));
 
-      typedef boost::tokenizer<boost::escaped_list_separator<char>> tokenizer;
-      std::string value = link.GetAttribute("LossRate");
-      tokenizer tok(value);
-
-      tokenizer::iterator token = tok.begin();
-      ObjectFactory factory(*token);
-
-      for (token++; token != tok.end(); token++) {
-        boost::escaped_list_separator<char> separator('\\', '=', '\"');
-        tokenizer attributeTok(*token, separator);
-
-        tokenizer::iterator attributeToken = attributeTok.begin();
-
-        string attribute = *attributeToken;
-        attributeToken++;
-
-        if (attributeToken == attributeTok.end()) {
-          NS_LOG_ERROR("ErrorModel attribute [" << *token
-                                                << "] should be in form <Attribute>=<Value>");
-          continue;
-        }
-
-        string value = *attributeToken;
-
-        factory.Set(attribute, StringValue(value));
+      const AttributeList& errorModel = getAttributeList(link.GetAttribute("LossRate"),
+                                                         "ErrorModel");
+      ObjectFactory factory(errorModel.type);
+      for (const auto& attribute : errorModel.attributes) {
+        factory.Set(attribute.first, StringValue(attribute.second));
       }
 
       nd.Get(0)->SetAttribute("ReceiveErrorModel", PointerValue(factory.Create<ErrorModel>()));
@@ -56,6 +56,18 @@ public:
   virtual NodeContainer
   Read();
 
+  /**
+   * \brief Set file to cache the parsed topology in compact binary form
+   *
+   * If the cache exists and was created from the current version of the topology file (same
+   * canonical path, size and modification time), Read() skips text parsing entirely.  Otherwise,
+   * or if the cache is damaged, the cache is (re)created after the topology file is parsed.
+   *
+   * Note that the cache uses native byte order and is meant to be reused on the same machine
+   */
+  void
+  SetCacheFile(const std::string& file);
+
   /**
    * \brief Get nodes read by the reader
    */
@@ -147,6 +159,8 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+
+  std::string m_cacheFile;
 };
 }
 
@@ -274,7 +274,6 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
   topgen.open(GetFileName().c_str());
   // NodeContainer nodes;
 
-  istringstream lineBuffer;
   string line;
   int lineNumber = 0;
   char errbuf[512];
@@ -284,37 +283,32 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     return m_nodes;
   }
 
-  while (!topgen.eof()) {
-    int ret;
+  // the expression is the same for all lines, compile it only once
+  regex_t regex;
+  int ret = regcomp(&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
+  if (ret != 0) {
+    regerror(ret, &regex, errbuf, sizeof(errbuf));
+    regfree(&regex);
+    NS_FATAL_ERROR("Cannot compile Rocketfuel maps line expression: " << errbuf);
+    return m_nodes;
+  }
+
+  while (getline(topgen, line)) {
     int argc;
     char* argv[REGMATCH_MAX];
     char* buf;
 
     lineNumber++;
-    line.clear();
-    lineBuffer.clear();
-
-    getline(topgen, line);
     buf = (char*)line.c_str();
 
     regmatch_t regmatch[REGMATCH_MAX];
-    regex_t regex;
-
-    ret = regcomp(&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
-    if (ret != 0) {
-      regerror(ret, &regex, errbuf, sizeof(errbuf));
-      regfree(&regex);
-      continue;
-    }
 
     ret = regexec(&regex, buf, REGMATCH_MAX, regmatch, 0);
     if (ret == REG_NOMATCH) {
       NS_LOG_WARN("match failed (maps file): %s" << buf);
-      regfree(&regex);
       continue;
     }
 
-    line = buf;
     argc = 0;
 
     /* regmatch[0] is the entire strings that matched */
@@ -330,8 +324,8 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     }
 
     GenerateFromMapsFile(argc, argv);
-    regfree(&regex);
   }
+  regfree(&regex);
 
   if (keepOneComponent) {
     NS_LOG_DEBUG("Before eliminating disconnected nodes: " << num_vertices(m_graph));
@@ -28,6 +28,8 @@
 
 #include "daemon/table/pit-entry.hpp"
 
+#include "ns3/ndnSIM/utils/ndn-virtual-payload-tag.hpp"
+
 #include <fstream>
 #include <boost/lexical_cast.hpp>
 
@@ -39,6 +41,16 @@ namespace ndn {
 static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer>>>>
   g_tracers;
 
+/**
+ * @brief Get number of bytes of Data on the wire, including virtual payload
+ */
+static size_t
+getDataSize(const Data& data)
+{
+  const VirtualPayloadTag* payloadTag = data.findTag<VirtualPayloadTag>();
+  return data.wireEncode().size() + (payloadTag != nullptr ? payloadTag->getSize() : 0);
+}
+
 void
 L3RateTracer::Destroy()
 {
@@ -312,8 +324,7 @@ L3RateTracer::OutData(const Data& data, const Face& face)
 {
   std::get<0>(m_stats[face.shared_from_this()]).m_outData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_outData +=
-      data.wireEncode().size();
+    std::get<1>(m_stats[face.shared_from_this()]).m_outData += getDataSize(data);
   }
 }
 
@@ -322,8 +333,7 @@ L3RateTracer::InData(const Data& data, const Face& face)
 {
   std::get<0>(m_stats[face.shared_from_this()]).m_inData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_inData +=
-      data.wireEncode().size();
+    std::get<1>(m_stats[face.shared_from_this()]).m_inData += getDataSize(data);
   }
 }
 
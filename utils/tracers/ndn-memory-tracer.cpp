@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-memory-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.MemoryTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<MemoryTracer>>>> g_tracers;
+
+/**
+ * @brief Open trace file, or use std::cout if @p file is -
+ * @return nullptr if the file cannot be opened
+ */
+static shared_ptr<std::ostream>
+openOutputStream(const std::string& file)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<std::ofstream> os(new std::ofstream());
+  os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+  return os;
+}
+
+void
+MemoryTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+MemoryTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nodes.Add(*node);
+  }
+  Install(nodes, file, averagingPeriod);
+}
+
+void
+MemoryTracer::Install(const NodeContainer& nodes, const std::string& file,
+                      Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream = openOutputStream(file);
+  if (outputStream == nullptr)
+    return;
+
+  std::list<Ptr<MemoryTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    tracers.push_back(Install(*node, outputStream, averagingPeriod));
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+MemoryTracer::Install(Ptr<Node> node, const std::string& file,
+                      Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  Install(NodeContainer(node), file, averagingPeriod);
+}
+
+Ptr<MemoryTracer>
+MemoryTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                      Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<MemoryTracer> trace = Create<MemoryTracer>(outputStream, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+MemoryTracer::MemoryTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+void
+MemoryTracer::SetAveragingPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &MemoryTracer::PeriodicPrinter, this);
+}
+
+void
+MemoryTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+
+  m_printEvent = Simulator::Schedule(m_period, &MemoryTracer::PeriodicPrinter, this);
+}
+
+void
+MemoryTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+
+     << "Table"
+     << "\t"
+     << "Entries"
+     << "\t"
+     << "Bytes"
+     << "\t"
+     << "BytesKind";
+}
+
+// kind is "counted" when the table keeps a byte counter, and "estimated" when bytes are derived
+// from the number of entries and the size of the entry structure
+#define PRINTER(printName, entries, bytes, kind)                                                   \
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << (entries) << "\t" \
+     << (bytes) << "\t" << kind << "\n";                                                          \
+  totalBytes += (bytes);
+
+void
+MemoryTracer::Print(std::ostream& os) const
+{
+  Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+  if (l3 == nullptr)
+    return;
+
+  nfd::Forwarder& forwarder = *l3->getForwarder();
+  Time time = Simulator::Now();
+  uint64_t totalBytes = 0;
+
+  const nfd::NameTree& nameTree = forwarder.getNameTree();
+  PRINTER("NameTree", nameTree.size(),
+          nameTree.size() * (sizeof(nfd::name_tree::Entry) + sizeof(nfd::name_tree::Node))
+            + nameTree.getNNameBytes(),
+          "estimated");
+
+  PRINTER("Fib", forwarder.getFib().size(), forwarder.getFib().size() * sizeof(nfd::fib::Entry),
+          "estimated");
+  PRINTER("Pit", forwarder.getPit().size(), forwarder.getPit().size() * sizeof(nfd::pit::Entry),
+          "estimated");
+  PRINTER("Measurements", forwarder.getMeasurements().size(),
+          forwarder.getMeasurements().size() * sizeof(nfd::measurements::Entry), "estimated");
+  PRINTER("Cs", forwarder.getCs().size(), forwarder.getCs().getNBytes(), "counted");
+
+  Ptr<ContentStore> cs = m_nodePtr->GetObject<ContentStore>();
+  if (cs != nullptr) {
+    PRINTER("ContentStore", cs->GetSize(), cs->GetBytes(), "counted");
+  }
+
+  // the pool holds the NameTree, Fib, Pit and Measurements entries counted above,
+  // so it is not added to the total
+  const nfd::SlabPool& pool = nameTree.getPool();
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t"
+     << "EntryPool"
+     << "\t" << pool.getNBlocksInUse() << "\t" << pool.getNBytesReserved() << "\t"
+     << "counted"
+     << "\n";
+
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t"
+     << "Total"
+     << "\t"
+     << "-"
+     << "\t" << totalBytes << "\t"
+     << "estimated"
+     << "\n";
+}
+
+} // namespace ndn
+} // namespace ns3
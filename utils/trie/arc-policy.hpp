@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ARC_POLICY_H_
+#define ARC_POLICY_H_
+
+/// @cond include_hidden
+
+#include "detail/segmented-list.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <list>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for Adaptive Replacement Cache (ARC) policy
+ *
+ * Cached entries are split between a recency list (T1, seen once) and a frequency list (T2,
+ * seen at least twice).  Keys evicted from either list are remembered in ghost lists (B1, B2)
+ * and a hit in a ghost list adapts the target size of T1, so the policy tunes itself between
+ * LRU-like and LFU-like behavior.  Ghost lists store only a hash of the name.
+ */
+struct arc_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "Arc";
+  }
+
+  enum { T1 = 0, T2 = 1 };
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    uint8_t segment;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  /**
+   * @brief LRU list of hashes of evicted names with O(1) membership test
+   */
+  class ghost_list {
+  public:
+    size_t
+    size() const
+    {
+      return order_.size();
+    }
+
+    /**
+     * @return true if the key was in the list (the key is removed)
+     */
+    bool
+    take(size_t key)
+    {
+      auto found = index_.find(key);
+      if (found == index_.end())
+        return false;
+
+      order_.erase(found->second);
+      index_.erase(found);
+      return true;
+    }
+
+    void
+    push_back(size_t key)
+    {
+      take(key);
+      index_[key] = order_.insert(order_.end(), key);
+    }
+
+    void
+    pop_front()
+    {
+      if (order_.empty())
+        return;
+      index_.erase(order_.front());
+      order_.pop_front();
+    }
+
+    void
+    clear()
+    {
+      order_.clear();
+      index_.clear();
+    }
+
+  private:
+    std::list<size_t> order_;
+    std::unordered_map<size_t, std::list<size_t>::iterator> index_;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+    typedef detail::segmented_list<policy_container, policy_hook_type, 2> segmented_list;
+
+    static bool
+    is_frequent(typename Container::iterator item)
+    {
+      return segmented_list::get_segment(*item) == T2;
+    }
+
+    class type : public segmented_list {
+    public:
+      typedef policy policy_base; // to get access to is_frequent methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+        , target_(0)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        segmented_list::move_back(*item, T2);
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        if (max_size_ == 0) {
+          segmented_list::push_back(*item, T1);
+          return true;
+        }
+
+        size_t key = detail::key_fingerprint(*item);
+        size_t t1 = segmented_list::segment_size(T1);
+        size_t b1 = recent_.size();
+        size_t b2 = frequent_.size();
+
+        if (recent_.take(key)) {
+          // recency list was too small
+          target_ = std::min(max_size_, target_ + std::max<size_t>(b2 / b1, 1));
+          replace(false);
+          segmented_list::push_back(*item, T2);
+          return true;
+        }
+
+        if (frequent_.take(key)) {
+          // frequency list was too small
+          size_t delta = std::max<size_t>(b1 / b2, 1);
+          target_ = target_ > delta ? target_ - delta : 0;
+          replace(true);
+          segmented_list::push_back(*item, T2);
+          return true;
+        }
+
+        if (t1 + b1 >= max_size_) {
+          if (t1 < max_size_) {
+            recent_.pop_front();
+            replace(false);
+          }
+          else {
+            base_.erase(segmented_list::segment_front(T1));
+          }
+        }
+        else if (t1 + b1 + segmented_list::segment_size(T2) + b2 >= max_size_) {
+          if (t1 + b1 + segmented_list::segment_size(T2) + b2 >= 2 * max_size_)
+            frequent_.pop_front();
+          replace(false);
+        }
+
+        segmented_list::push_back(*item, T1);
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        segmented_list::move_back(*item, T2);
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        segmented_list::unlink(*item);
+      }
+
+      inline void
+      clear()
+      {
+        segmented_list::clear();
+        recent_.clear();
+        frequent_.clear();
+        target_ = 0;
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+        target_ = std::min(target_, max_size_);
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+    private:
+      /**
+       * @brief Evict an entry from T1 or T2 (if the cache is full), remembering it in the ghost
+       *        list
+       */
+      void
+      replace(bool inFrequentGhost)
+      {
+        size_t t1 = segmented_list::segment_size(T1);
+        if (t1 + segmented_list::segment_size(T2) < max_size_)
+          return;
+
+        bool fromRecent = t1 > 0 && (t1 > target_ || (inFrequentGhost && t1 == target_));
+        if (!fromRecent && segmented_list::segment_size(T2) == 0)
+          fromRecent = true;
+
+        Container* victim = segmented_list::segment_front(fromRecent ? T1 : T2);
+        size_t key = detail::key_fingerprint(*victim);
+        base_.erase(victim);
+        (fromRecent ? recent_ : frequent_).push_back(key);
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      size_t max_size_;
+      size_t target_; ///< @brief adaptive target size of T1
+
+      ghost_list recent_;   ///< @brief B1
+      ghost_list frequent_; ///< @brief B2
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // ARC_POLICY_H_
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef BYTE_BUDGET_H_
+#define BYTE_BUDGET_H_
+
+/// @cond include_hidden
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+template<class PayloadTraits, class Payload>
+inline auto
+payload_size_impl(const Payload& payload, int) -> decltype(PayloadTraits::size(payload))
+{
+  return PayloadTraits::size(payload);
+}
+
+template<class PayloadTraits, class Payload>
+inline size_t
+payload_size_impl(const Payload& payload, long)
+{
+  return 1;
+}
+
+/**
+ * @brief Get size of the payload stored in the trie node, in bytes
+ *
+ * The size is provided by static `size(const_return_type)` method of the trie's payload traits;
+ * payloads without such method count as one byte each.  Payload of a cached node must not
+ * change its size.
+ */
+template<class Container>
+inline size_t
+payload_size(const Container& item)
+{
+  return payload_size_impl<typename Container::payload_traits>(item.payload(), 0);
+}
+
+/**
+ * @brief Accounting of bytes taken by the cached payloads against an optional limit
+ */
+class byte_budget {
+public:
+  byte_budget()
+    : max_bytes_(0)
+    , bytes_(0)
+  {
+  }
+
+  /**
+   * @brief Check if a payload of @p size bytes can be cached at all
+   */
+  bool
+  fits(size_t size) const
+  {
+    return max_bytes_ == 0 || size <= max_bytes_;
+  }
+
+  /**
+   * @brief Check if adding @p extra bytes would exceed the limit (never, if limit is 0)
+   */
+  bool
+  exceeded(size_t extra = 0) const
+  {
+    return max_bytes_ != 0 && bytes_ + extra > max_bytes_;
+  }
+
+  void
+  add(size_t size)
+  {
+    bytes_ += size;
+  }
+
+  void
+  remove(size_t size)
+  {
+    bytes_ -= size;
+  }
+
+  void
+  clear()
+  {
+    bytes_ = 0;
+  }
+
+  uint64_t
+  bytes() const
+  {
+    return bytes_;
+  }
+
+  void
+  set_max_bytes(uint64_t max_bytes)
+  {
+    max_bytes_ = max_bytes;
+  }
+
+  uint64_t
+  get_max_bytes() const
+  {
+    return max_bytes_;
+  }
+
+private:
+  uint64_t max_bytes_;
+  uint64_t bytes_;
+};
+
+/**
+ * @brief Set byte limit of the policy, if the policy supports byte limits
+ */
+template<class Policy>
+inline auto
+set_max_bytes(Policy& policy, uint64_t max_bytes, int) -> decltype(policy.set_max_bytes(max_bytes))
+{
+  policy.set_max_bytes(max_bytes);
+}
+
+template<class Policy>
+inline void
+set_max_bytes(Policy& policy, uint64_t max_bytes, long)
+{
+}
+
+/**
+ * @brief Get byte limit of the policy (0 if the policy does not support byte limits)
+ */
+template<class Policy>
+inline auto
+get_max_bytes(const Policy& policy, int) -> decltype(policy.get_max_bytes())
+{
+  return policy.get_max_bytes();
+}
+
+template<class Policy>
+inline uint64_t
+get_max_bytes(const Policy& policy, long)
+{
+  return 0;
+}
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // BYTE_BUDGET_H_
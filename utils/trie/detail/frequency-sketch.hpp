@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef FREQUENCY_SKETCH_H_
+#define FREQUENCY_SKETCH_H_
+
+/// @cond include_hidden
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+/**
+ * @brief Approximate access frequency (TinyLFU): count-min sketch guarded by a doorkeeper
+ *
+ * The sketch has four rows of 4-bit saturating counters packed into 64-bit words (one word per
+ * tracked entry, i.e., 8 bytes per cache slot).  The first access of a key only sets its bits in
+ * the doorkeeper bloom filter (16 bits per cache slot), so one-hit wonders never reach the
+ * counters.  After a sample of
+ * 10 accesses per counter word all counters are halved and the doorkeeper is cleared, which
+ * ages the history.
+ */
+class frequency_sketch {
+public:
+  frequency_sketch()
+  {
+    resize(16);
+  }
+
+  /**
+   * @brief Size the sketch for roughly @p capacity distinct keys
+   */
+  void
+  resize(size_t capacity)
+  {
+    size_t width = 16;
+    while (width < capacity)
+      width <<= 1;
+
+    table_.assign(width, 0);
+    // a sparser doorkeeper fills up within a sample and lets one-hit wonders into the counters
+    doorkeeper_.assign(std::max<size_t>(width / 4, 1), 0);
+    sample_size_ = 10 * width;
+    additions_ = 0;
+  }
+
+  void
+  increment(size_t key)
+  {
+    // the first sighting only sets the doorkeeper bits, repeated ones go to the counters
+    if (doorkeeper_put(key)) {
+      bool added = false;
+      for (int row = 0; row < 4; row++) {
+        uint64_t& word = table_[index(key, row)];
+        int offset = counter_offset(key, row);
+        if (((word >> offset) & 0xF) != 0xF) {
+          word += uint64_t(1) << offset;
+          added = true;
+        }
+      }
+      if (!added)
+        return;
+    }
+
+    if (++additions_ >= sample_size_)
+      reset();
+  }
+
+  uint32_t
+  estimate(size_t key) const
+  {
+    uint32_t frequency = 0xF;
+    for (int row = 0; row < 4; row++) {
+      uint64_t word = table_[index(key, row)];
+      frequency = std::min<uint32_t>(frequency, (word >> counter_offset(key, row)) & 0xF);
+    }
+    return frequency + (doorkeeper_contains(key) ? 1 : 0);
+  }
+
+  void
+  clear()
+  {
+    std::fill(table_.begin(), table_.end(), 0);
+    std::fill(doorkeeper_.begin(), doorkeeper_.end(), 0);
+    additions_ = 0;
+  }
+
+private:
+  static uint64_t
+  mix(size_t key, uint64_t seed)
+  {
+    uint64_t hash = (key + seed) * 0x9E3779B97F4A7C15ULL;
+    return hash ^ (hash >> 32);
+  }
+
+  size_t
+  index(size_t key, int row) const
+  {
+    static const uint64_t seeds[] = {0xC3A5C85C97CB3127ULL, 0xB492B66FBE98F273ULL,
+                                     0x9AE16A3B2F90404FULL, 0xCBF29CE484222325ULL};
+    return mix(key, seeds[row]) & (table_.size() - 1);
+  }
+
+  static int
+  counter_offset(size_t key, int row)
+  {
+    // every row owns four of the sixteen counters in a word
+    return ((row << 2) + ((key >> (row << 1)) & 3)) << 2;
+  }
+
+  size_t
+  doorkeeper_bit(size_t key, int probe) const
+  {
+    return mix(key, probe == 0 ? 0x27D4EB2F165667C5ULL : 0x165667B19E3779F9ULL)
+           & (doorkeeper_.size() * 64 - 1);
+  }
+
+  bool
+  doorkeeper_contains(size_t key) const
+  {
+    for (int probe = 0; probe < 2; probe++) {
+      size_t bit = doorkeeper_bit(key, probe);
+      if ((doorkeeper_[bit >> 6] & (uint64_t(1) << (bit & 63))) == 0)
+        return false;
+    }
+    return true;
+  }
+
+  /**
+   * @return false if the key was not yet in the doorkeeper
+   */
+  bool
+  doorkeeper_put(size_t key)
+  {
+    bool present = true;
+    for (int probe = 0; probe < 2; probe++) {
+      size_t bit = doorkeeper_bit(key, probe);
+      uint64_t mask = uint64_t(1) << (bit & 63);
+      if ((doorkeeper_[bit >> 6] & mask) == 0) {
+        doorkeeper_[bit >> 6] |= mask;
+        present = false;
+      }
+    }
+    return present;
+  }
+
+  void
+  reset()
+  {
+    for (uint64_t& word : table_)
+      word = (word >> 1) & 0x7777777777777777ULL;
+    std::fill(doorkeeper_.begin(), doorkeeper_.end(), 0);
+    additions_ /= 2;
+  }
+
+private:
+  std::vector<uint64_t> table_;
+  std::vector<uint64_t> doorkeeper_;
+  size_t sample_size_;
+  size_t additions_;
+};
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // FREQUENCY_SKETCH_H_
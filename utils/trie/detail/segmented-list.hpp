@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef SEGMENTED_LIST_H_
+#define SEGMENTED_LIST_H_
+
+/// @cond include_hidden
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+/**
+ * @brief Intrusive list split into a fixed number of LRU segments
+ *
+ * Segments are stored back to back in one list (segment 0 first), each ordered from the least to
+ * the most recently used entry.  Only the last entry of every segment is remembered, so the
+ * only per-entry state (besides the list hook) is the segment number, which PolicyHook must
+ * provide as `segment` member.
+ */
+template<class PolicyContainer, class PolicyHook, size_t Segments>
+class segmented_list : public PolicyContainer {
+public:
+  typedef typename PolicyContainer::value_type value_type;
+  typedef typename PolicyContainer::iterator iterator;
+
+  segmented_list()
+  {
+    std::fill(last_, last_ + Segments, nullptr);
+    std::fill(size_, size_ + Segments, 0);
+  }
+
+  static uint8_t&
+  get_segment(value_type& item)
+  {
+    return static_cast<PolicyHook*>(PolicyContainer::value_traits::to_node_ptr(item))->segment;
+  }
+
+  inline size_t
+  segment_size(size_t segment) const
+  {
+    return size_[segment];
+  }
+
+  /**
+   * @brief Get the least recently used entry of the segment (nullptr if segment is empty)
+   */
+  inline value_type*
+  segment_front(size_t segment)
+  {
+    if (size_[segment] == 0)
+      return nullptr;
+    return &(*segment_begin(segment));
+  }
+
+  /**
+   * @brief Link @p item as the most recently used entry of the segment
+   */
+  inline void
+  push_back(value_type& item, size_t segment)
+  {
+    PolicyContainer::insert(segment_end(segment), item);
+    attach(item, segment);
+  }
+
+  /**
+   * @brief Move already linked @p item to the most recently used position of the segment
+   */
+  inline void
+  move_back(value_type& item, size_t segment)
+  {
+    detach(item);
+
+    iterator position = segment_end(segment);
+    iterator current = PolicyContainer::s_iterator_to(item);
+    if (position != current)
+      PolicyContainer::splice(position, *this, current);
+
+    attach(item, segment);
+  }
+
+  inline void
+  unlink(value_type& item)
+  {
+    detach(item);
+    PolicyContainer::erase(PolicyContainer::s_iterator_to(item));
+  }
+
+  inline void
+  clear()
+  {
+    PolicyContainer::clear();
+    std::fill(last_, last_ + Segments, nullptr);
+    std::fill(size_, size_ + Segments, 0);
+  }
+
+private:
+  iterator
+  segment_end(size_t segment)
+  {
+    for (size_t i = segment + 1; i > 0; i--) {
+      if (last_[i - 1] != nullptr)
+        return std::next(PolicyContainer::s_iterator_to(*last_[i - 1]));
+    }
+    return PolicyContainer::begin();
+  }
+
+  iterator
+  segment_begin(size_t segment)
+  {
+    return segment == 0 ? PolicyContainer::begin() : segment_end(segment - 1);
+  }
+
+  void
+  attach(value_type& item, size_t segment)
+  {
+    get_segment(item) = segment;
+    last_[segment] = &item;
+    size_[segment]++;
+  }
+
+  void
+  detach(value_type& item)
+  {
+    size_t segment = get_segment(item);
+    size_[segment]--;
+    if (last_[segment] != &item)
+      return;
+
+    iterator position = PolicyContainer::s_iterator_to(item);
+    if (position != PolicyContainer::begin() && get_segment(*std::prev(position)) == segment)
+      last_[segment] = &(*std::prev(position));
+    else
+      last_[segment] = nullptr;
+  }
+
+private:
+  value_type* last_[Segments];
+  size_t size_[Segments];
+};
+
+/**
+ * @brief Get hash of the full name of the trie node, stable across erase/insert of the node
+ *
+ * Needed by policies that remember entries after they have been evicted from the trie.
+ */
+template<class Container>
+inline size_t
+key_fingerprint(const Container& node)
+{
+  size_t seed = 0;
+  for (const Container* i = &node; i != nullptr; i = i->parent())
+    boost::hash_combine(seed, hash_value(*i));
+  return seed;
+}
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // SEGMENTED_LIST_H_
@@ -22,6 +22,8 @@
 
 /// @cond include_hidden
 
+#include "detail/byte-budget.hpp"
+
 #include <boost/intrusive/options.hpp>
 #include <boost/intrusive/set.hpp>
 
@@ -104,12 +106,19 @@ struct lfu_policy_traits {
       {
         get_order(item) = 0;
 
-        if (max_size_ != 0 && policy_container::size() >= max_size_) {
+        size_t size = detail::payload_size(*item);
+        if (!bytes_.fits(size))
+          return false;
+
+        while (!policy_container::empty()
+               && ((max_size_ != 0 && policy_container::size() >= max_size_)
+                   || bytes_.exceeded(size))) {
           // this erases the "least frequently used item" from cache
           base_.erase(&(*policy_container::begin()));
         }
 
         policy_container::insert(*item);
+        bytes_.add(size);
         return true;
       }
 
@@ -124,6 +133,7 @@ struct lfu_policy_traits {
       inline void
       erase(typename parent_trie::iterator item)
       {
+        bytes_.remove(detail::payload_size(*item));
         policy_container::erase(policy_container::s_iterator_to(*item));
       }
 
@@ -131,6 +141,7 @@ struct lfu_policy_traits {
       clear()
       {
         policy_container::clear();
+        bytes_.clear();
       }
 
       inline void
@@ -145,6 +156,18 @@ struct lfu_policy_traits {
         return max_size_;
       }
 
+      inline void
+      set_max_bytes(uint64_t max_bytes)
+      {
+        bytes_.set_max_bytes(max_bytes);
+      }
+
+      inline uint64_t
+      get_max_bytes() const
+      {
+        return bytes_.get_max_bytes();
+      }
+
     private:
       type()
         : base_(*((Base*)0)){};
@@ -152,6 +175,7 @@ struct lfu_policy_traits {
     private:
       Base& base_;
       size_t max_size_;
+      detail::byte_budget bytes_;
     };
   };
 };
@@ -0,0 +1,282 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef LFU2_POLICY_H_
+#define LFU2_POLICY_H_
+
+/// @cond include_hidden
+
+#include "detail/byte-budget.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <iterator>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for LFU replacement policy with O(1) update, insertion, and eviction
+ *
+ * All entries are kept in one list, ordered by access frequency (least frequently used first
+ * and, within the same frequency, least recently promoted first).  Entries with equal frequency
+ * form a contiguous segment of the list, described by a frequency bucket that points to the
+ * last entry of the segment.  Buckets are chained through the list itself: the bucket of the
+ * entry that follows a segment is the next frequency bucket.  A hit therefore only moves the
+ * entry to the end of the neighboring segment, without any search or re-balancing.
+ */
+struct lfu2_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "Lfu2";
+  }
+
+  struct frequency_bucket {
+    uint64_t frequency;
+    void* last; ///< @brief last entry of the bucket's segment (pointer to trie node)
+  };
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    frequency_bucket* bucket;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    static frequency_bucket*&
+    get_bucket(typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item))
+        ->bucket;
+    }
+
+    static frequency_bucket* const&
+    get_bucket(typename Container::const_iterator item)
+    {
+      return static_cast<const policy_hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item))->bucket;
+    }
+
+    static uint64_t
+    get_frequency(typename Container::const_iterator item)
+    {
+      return get_bucket(item)->frequency;
+    }
+
+    typedef boost::intrusive::list<Container, Hook> policy_container;
+
+    // could be just typedef
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to get_frequency methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+      {
+      }
+
+      ~type()
+      {
+        clear();
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        promote(item);
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t size = detail::payload_size(*item);
+        if (!bytes_.fits(size))
+          return false;
+
+        while (!policy_container::empty()
+               && ((max_size_ != 0 && policy_container::size() >= max_size_)
+                   || bytes_.exceeded(size))) {
+          // this erases the "least frequently used item" from cache
+          base_.erase(&(*policy_container::begin()));
+        }
+        bytes_.add(size);
+
+        // new entries go to the end of the zero-frequency segment, which is always the first one
+        frequency_bucket* first =
+          policy_container::empty() ? 0 : get_bucket(&(*policy_container::begin()));
+
+        if (first != 0 && first->frequency == 0) {
+          policy_container::insert(next_segment(first), *item);
+          first->last = item;
+          get_bucket(item) = first;
+        }
+        else {
+          policy_container::push_front(*item);
+          get_bucket(item) = new frequency_bucket{0, item};
+        }
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        promote(item);
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        bytes_.remove(detail::payload_size(*item));
+        detach(item);
+        policy_container::erase(policy_container::s_iterator_to(*item));
+      }
+
+      inline void
+      clear()
+      {
+        for (typename policy_container::iterator i = policy_container::begin();
+             i != policy_container::end(); i++) {
+          if (get_bucket(&(*i))->last == &(*i))
+            delete get_bucket(&(*i));
+        }
+        policy_container::clear();
+        bytes_.clear();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+      inline void
+      set_max_bytes(uint64_t max_bytes)
+      {
+        bytes_.set_max_bytes(max_bytes);
+      }
+
+      inline uint64_t
+      get_max_bytes() const
+      {
+        return bytes_.get_max_bytes();
+      }
+
+    private:
+      /**
+       * @brief Get the first entry after the segment of @p bucket
+       */
+      typename policy_container::iterator
+      next_segment(frequency_bucket* bucket)
+      {
+        return std::next(
+          policy_container::s_iterator_to(*static_cast<Container*>(bucket->last)));
+      }
+
+      /**
+       * @brief Exclude @p item from its bucket, deleting the bucket if it becomes empty
+       * @return true if the bucket is still in use
+       */
+      bool
+      detach(typename parent_trie::iterator item)
+      {
+        frequency_bucket* bucket = get_bucket(item);
+        if (bucket->last != item)
+          return true;
+
+        typename policy_container::iterator position = policy_container::s_iterator_to(*item);
+        if (position != policy_container::begin()
+            && get_bucket(&(*std::prev(position))) == bucket) {
+          bucket->last = &(*std::prev(position));
+          return true;
+        }
+
+        delete bucket;
+        return false;
+      }
+
+      void
+      promote(typename parent_trie::iterator item)
+      {
+        frequency_bucket* bucket = get_bucket(item);
+        uint64_t frequency = bucket->frequency + 1;
+
+        typename policy_container::iterator next = next_segment(bucket);
+        frequency_bucket* nextBucket = 0;
+        if (next != policy_container::end() && get_bucket(&(*next))->frequency == frequency)
+          nextBucket = get_bucket(&(*next));
+
+        if (nextBucket == 0 && bucket->last == item
+            && (policy_container::s_iterator_to(*item) == policy_container::begin()
+                || get_bucket(&(*std::prev(policy_container::s_iterator_to(*item)))) != bucket)) {
+          // the only entry in its bucket and there is no bucket to join: reuse the bucket
+          bucket->frequency = frequency;
+          return;
+        }
+
+        detach(item);
+
+        if (nextBucket == 0) {
+          // new segment between the old one and the next
+          nextBucket = new frequency_bucket{frequency, item};
+        }
+        else {
+          next = next_segment(nextBucket);
+          nextBucket->last = item;
+        }
+
+        policy_container::splice(next, *this, policy_container::s_iterator_to(*item));
+        get_bucket(item) = nextBucket;
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      size_t max_size_;
+      detail::byte_budget bytes_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // LFU2_POLICY_H_
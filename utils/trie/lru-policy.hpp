@@ -22,6 +22,8 @@
 
 /// @cond include_hidden
 
+#include "detail/byte-budget.hpp"
+
 #include <boost/intrusive/options.hpp>
 #include <boost/intrusive/list.hpp>
 
@@ -75,11 +77,18 @@ struct lru_policy_traits {
       inline bool
       insert(typename parent_trie::iterator item)
       {
-        if (max_size_ != 0 && policy_container::size() >= max_size_) {
+        size_t size = detail::payload_size(*item);
+        if (!bytes_.fits(size))
+          return false;
+
+        while (!policy_container::empty()
+               && ((max_size_ != 0 && policy_container::size() >= max_size_)
+                   || bytes_.exceeded(size))) {
           base_.erase(&(*policy_container::begin()));
         }
 
         policy_container::push_back(*item);
+        bytes_.add(size);
         return true;
       }
 
@@ -94,6 +103,7 @@ struct lru_policy_traits {
       inline void
       erase(typename parent_trie::iterator item)
       {
+        bytes_.remove(detail::payload_size(*item));
         policy_container::erase(policy_container::s_iterator_to(*item));
       }
 
@@ -101,6 +111,7 @@ struct lru_policy_traits {
       clear()
       {
         policy_container::clear();
+        bytes_.clear();
       }
 
       inline void
@@ -115,6 +126,18 @@ struct lru_policy_traits {
         return max_size_;
       }
 
+      inline void
+      set_max_bytes(uint64_t max_bytes)
+      {
+        bytes_.set_max_bytes(max_bytes);
+      }
+
+      inline uint64_t
+      get_max_bytes() const
+      {
+        return bytes_.get_max_bytes();
+      }
+
     private:
       type()
         : base_(*((Base*)0)){};
@@ -122,6 +145,7 @@ struct lru_policy_traits {
     private:
       Base& base_;
       size_t max_size_;
+      detail::byte_budget bytes_;
     };
   };
 };
@@ -25,6 +25,7 @@
 #include "detail/multi-type-container.hpp"
 #include "detail/multi-policy-container.hpp"
 #include "detail/functor-hook.hpp"
+#include "detail/byte-budget.hpp"
 
 #include <boost/mpl/size.hpp>
 #include <boost/mpl/at.hpp>
@@ -153,6 +154,69 @@ struct multi_policy_traits {
         // as max size should be the same everywhere, get the value from the first available policy
         return policy_container::template get<0>().get_max_size();
       }
+
+      struct max_bytes_setter {
+        max_bytes_setter(policy_container& container, uint64_t bytes)
+          : m_container(container)
+          , m_bytes(bytes)
+        {
+        }
+
+        template<typename U>
+        void
+        operator()(U index)
+        {
+          detail::set_max_bytes(m_container.template get<U::value>(), m_bytes, 0);
+        }
+
+      private:
+        policy_container& m_container;
+        uint64_t m_bytes;
+      };
+
+      struct max_bytes_getter {
+        max_bytes_getter(const policy_container& container, uint64_t& bytes)
+          : m_container(container)
+          , m_bytes(bytes)
+        {
+        }
+
+        template<typename U>
+        void
+        operator()(U index)
+        {
+          if (m_bytes == 0)
+            m_bytes = detail::get_max_bytes(m_container.template get<U::value>(), 0);
+        }
+
+      private:
+        const policy_container& m_container;
+        uint64_t& m_bytes;
+      };
+
+      /**
+       * @brief Set byte limit on all internal policies that support byte limits
+       */
+      inline void
+      set_max_bytes(uint64_t max_bytes)
+      {
+        boost::mpl::for_each<boost::mpl::range_c<int, 0,
+                                                 boost::mpl::size<policy_traits>::type::value>>(
+          max_bytes_setter(*this, max_bytes));
+      }
+
+      /**
+       * @brief Get byte limit from the first internal policy that has it set (0 if none)
+       */
+      inline uint64_t
+      get_max_bytes() const
+      {
+        uint64_t max_bytes = 0;
+        boost::mpl::for_each<boost::mpl::range_c<int, 0,
+                                                 boost::mpl::size<policy_traits>::type::value>>(
+          max_bytes_getter(*this, max_bytes));
+        return max_bytes;
+      }
     };
   };
 
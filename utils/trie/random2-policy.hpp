@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef RANDOM2_POLICY_H_
+#define RANDOM2_POLICY_H_
+
+/// @cond include_hidden
+
+#include "ns3/random-variable-stream.h"
+
+#include "detail/byte-budget.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for random replacement policy with O(1) insertion and eviction
+ *
+ * Entries are additionally referenced from a dense array and each entry remembers its index in
+ * the array, so a uniformly random victim is selected by drawing one index, and an entry is
+ * removed by moving the last array element into its slot.
+ *
+ * Similar to random_policy_traits, when the cache is full the new entry itself is one of the
+ * candidates for the eviction, i.e., insertion fails with probability 1/(size+1).
+ */
+struct random2_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "Random2";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    size_t index;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    static size_t&
+    get_index(typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item))
+        ->index;
+    }
+
+    static const size_t&
+    get_index(typename Container::const_iterator item)
+    {
+      return static_cast<const policy_hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item))->index;
+    }
+
+    typedef boost::intrusive::list<Container, Hook> policy_container;
+
+    // could be just typedef
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to get_index methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , u_rand(CreateObject<UniformRandomVariable>())
+        , max_size_(100)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        // do nothing. it's random policy
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t size = detail::payload_size(*item);
+        if (!bytes_.fits(size))
+          return false;
+
+        if (max_size_ != 0 && policy_container::size() >= max_size_) {
+          // the new entry is one of the candidates for the eviction
+          uint32_t victim = u_rand->GetInteger(0, items_.size());
+          if (victim == items_.size()) {
+            // just return false. Indicating that insert "failed"
+            return false;
+          }
+          else {
+            // removing some random element
+            base_.erase(items_[victim]);
+          }
+        }
+
+        while (!items_.empty() && bytes_.exceeded(size)) {
+          base_.erase(items_[u_rand->GetInteger(0, items_.size() - 1)]);
+        }
+        bytes_.add(size);
+
+        get_index(item) = items_.size();
+        items_.push_back(item);
+        policy_container::push_back(*item);
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        // do nothing. it's random policy
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        bytes_.remove(detail::payload_size(*item));
+
+        size_t index = get_index(item);
+        items_[index] = items_.back();
+        get_index(items_[index]) = index;
+        items_.pop_back();
+
+        policy_container::erase(policy_container::s_iterator_to(*item));
+      }
+
+      inline void
+      clear()
+      {
+        items_.clear();
+        policy_container::clear();
+        bytes_.clear();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+        if (max_size_ != 0)
+          items_.reserve(max_size_);
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+      inline void
+      set_max_bytes(uint64_t max_bytes)
+      {
+        bytes_.set_max_bytes(max_bytes);
+      }
+
+      inline uint64_t
+      get_max_bytes() const
+      {
+        return bytes_.get_max_bytes();
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      Ptr<UniformRandomVariable> u_rand;
+      size_t max_size_;
+      std::vector<typename parent_trie::iterator> items_;
+      detail::byte_budget bytes_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // RANDOM2_POLICY_H_
@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef S4LRU_POLICY_H_
+#define S4LRU_POLICY_H_
+
+/// @cond include_hidden
+
+#include "detail/segmented-list.hpp"
+#include "detail/byte-budget.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for quadruply-segmented LRU (S4LRU) replacement policy
+ *
+ * The cache is split into four LRU segments of equal size.  New entries enter the lowest
+ * segment, a hit moves the entry to the head of the next higher segment (or the head of the
+ * highest one), and entries pushed out of a segment fall to the head of the segment below.
+ * Only entries pushed out of the lowest segment leave the cache.
+ */
+struct s4lru_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "S4Lru";
+  }
+
+  static const size_t SEGMENTS = 4;
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    uint8_t segment;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+    typedef detail::segmented_list<policy_container, policy_hook_type, SEGMENTS> segmented_list;
+
+    static uint8_t
+    get_segment(typename Container::iterator item)
+    {
+      return segmented_list::get_segment(*item);
+    }
+
+    class type : public segmented_list {
+    public:
+      typedef policy policy_base; // to get access to get_segment methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        promote(item);
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t size = detail::payload_size(*item);
+        if (!bytes_.fits(size))
+          return false;
+
+        if (max_size_ != 0 && segmented_list::segment_size(0) >= capacity(0)) {
+          base_.erase(segmented_list::segment_front(0));
+        }
+
+        // byte limit applies to the whole cache: evict from the lowest non-empty segment
+        while (!segmented_list::empty() && bytes_.exceeded(size)) {
+          base_.erase(&(*segmented_list::begin()));
+        }
+
+        segmented_list::push_back(*item, 0);
+        bytes_.add(size);
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        promote(item);
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        bytes_.remove(detail::payload_size(*item));
+        segmented_list::unlink(*item);
+      }
+
+      inline void
+      clear()
+      {
+        segmented_list::clear();
+        bytes_.clear();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+      inline void
+      set_max_bytes(uint64_t max_bytes)
+      {
+        bytes_.set_max_bytes(max_bytes);
+      }
+
+      inline uint64_t
+      get_max_bytes() const
+      {
+        return bytes_.get_max_bytes();
+      }
+
+    private:
+      /**
+       * @brief Capacity of the segment; segment capacities add up to max_size_
+       */
+      size_t
+      capacity(size_t segment) const
+      {
+        return (max_size_ + SEGMENTS - 1 - segment) / SEGMENTS;
+      }
+
+      void
+      promote(typename parent_trie::iterator item)
+      {
+        size_t segment = std::min<size_t>(get_segment(item) + 1, SEGMENTS - 1);
+        segmented_list::move_back(*item, segment);
+
+        if (max_size_ == 0)
+          return;
+
+        // demote overflowing entries; the promoted entry left a free slot below, so this stops
+        // at the segment it came from at the latest
+        for (; segment > 0 && segmented_list::segment_size(segment) > capacity(segment);
+             segment--) {
+          segmented_list::move_back(*segmented_list::segment_front(segment), segment - 1);
+        }
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      size_t max_size_;
+      detail::byte_budget bytes_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // S4LRU_POLICY_H_
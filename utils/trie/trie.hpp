@@ -457,6 +457,15 @@ public:
     return key_;
   }
 
+  /**
+   * @brief Get parent node (nullptr for the root node)
+   */
+  const trie*
+  parent() const
+  {
+    return parent_;
+  }
+
   inline void
   PrintStat(std::ostream& os) const;
 
@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef WTINYLFU_POLICY_H_
+#define WTINYLFU_POLICY_H_
+
+/// @cond include_hidden
+
+#include "detail/segmented-list.hpp"
+#include "detail/frequency-sketch.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for Window TinyLFU (W-TinyLFU) admission and replacement policy
+ *
+ * New entries are placed into a small LRU window (1% of the cache).  An entry pushed out of the
+ * window is admitted into the main segmented LRU (20% probation, 80% protected) only if its
+ * estimated access frequency is higher than that of the main cache's eviction victim;
+ * otherwise the entry itself is dropped.  Frequencies are estimated by
+ * detail::frequency_sketch (count-min sketch with a doorkeeper bloom filter), so the policy
+ * remembers popularity of names that are not cached.
+ */
+struct wtinylfu_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "WTinyLfu";
+  }
+
+  enum { WINDOW = 0, PROBATION = 1, PROTECTED = 2 };
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    uint8_t segment;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+    typedef detail::segmented_list<policy_container, policy_hook_type, 3> segmented_list;
+
+    static uint8_t
+    get_segment(typename Container::iterator item)
+    {
+      return segmented_list::get_segment(*item);
+    }
+
+    class type : public segmented_list {
+    public:
+      typedef policy policy_base; // to get access to get_segment methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+      {
+        set_max_size(100);
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        // content update is not an access
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        sketch_.increment(detail::key_fingerprint(*item));
+        segmented_list::push_back(*item, WINDOW);
+
+        if (max_size_ == 0 || segmented_list::segment_size(WINDOW) <= window_size_)
+          return true;
+
+        Container* candidate = segmented_list::segment_front(WINDOW);
+        if (segmented_list::segment_size(PROBATION) + segmented_list::segment_size(PROTECTED)
+            < max_size_ - window_size_) {
+          segmented_list::move_back(*candidate, PROBATION);
+          return true;
+        }
+
+        Container* victim = segmented_list::segment_front(PROBATION);
+        if (victim == nullptr)
+          victim = segmented_list::segment_front(PROTECTED);
+
+        if (victim != nullptr
+            && sketch_.estimate(detail::key_fingerprint(*candidate))
+                 > sketch_.estimate(detail::key_fingerprint(*victim))) {
+          base_.erase(victim);
+          segmented_list::move_back(*candidate, PROBATION);
+        }
+        else {
+          base_.erase(candidate);
+        }
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        sketch_.increment(detail::key_fingerprint(*item));
+
+        switch (get_segment(item)) {
+        case WINDOW:
+          segmented_list::move_back(*item, WINDOW);
+          break;
+        case PROBATION:
+          segmented_list::move_back(*item, PROTECTED);
+          if (segmented_list::segment_size(PROTECTED) > protected_size_) {
+            segmented_list::move_back(*segmented_list::segment_front(PROTECTED), PROBATION);
+          }
+          break;
+        default:
+          segmented_list::move_back(*item, PROTECTED);
+          break;
+        }
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        segmented_list::unlink(*item);
+      }
+
+      inline void
+      clear()
+      {
+        segmented_list::clear();
+        sketch_.clear();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+        window_size_ = std::max<size_t>(max_size_ / 100, 1);
+        protected_size_ = max_size_ > window_size_ ? (max_size_ - window_size_) * 4 / 5 : 0;
+        sketch_.resize(max_size_);
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      size_t max_size_;
+      size_t window_size_;
+      size_t protected_size_;
+
+      detail::frequency_sketch sketch_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // WTINYLFU_POLICY_H_